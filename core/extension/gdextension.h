@@ -83,6 +83,7 @@ public:
 	};
 
 	bool is_library_open() const;
+	String get_library_path() const { return library_path; }
 
 	InitializationLevel get_minimum_library_initialization_level() const;
 	void initialize_library(InitializationLevel p_level);
@@ -473,6 +473,21 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+const uint8_t *FileAccess::get_buffer_view_or_read(uint64_t p_length, Vector<uint8_t> &r_storage) const {
+	const uint8_t *view = get_buffer_view(p_length);
+	if (view) {
+		return view;
+	}
+
+	Error err = r_storage.resize(p_length);
+	ERR_FAIL_COND_V_MSG(err != OK, nullptr, "Can't resize data to " + itos(p_length) + " elements.");
+	if (get_buffer(r_storage.ptrw(), p_length) != p_length) {
+		r_storage.clear();
+		return nullptr;
+	}
+	return r_storage.ptr();
+}
+
 Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	Vector<uint8_t> data;
 
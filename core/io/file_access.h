@@ -129,6 +129,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; } ///< get the next p_length bytes without copying them, only supported by memory backed files, returns nullptr otherwise and callers must read them instead
+	const uint8_t *get_buffer_view_or_read(uint64_t p_length, Vector<uint8_t> &r_storage) const; ///< get the next p_length bytes, without copying them when the file supports buffer views, otherwise they are read into r_storage. Returns nullptr when fewer bytes are available
+	virtual const uint8_t *map_read_only(uint64_t *r_size = nullptr) { return nullptr; } ///< map the whole open file in memory, if supported. The mapping is released on close. Returns nullptr once the file became smaller than the mapping, as reading past its end would crash
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
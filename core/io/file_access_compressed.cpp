@@ -30,6 +30,8 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
@@ -89,6 +91,69 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	return ret == -1 ? ERR_FILE_CORRUPT : OK;
 }
 
+void FileAccessCompressed::_compress_block(void *p_userdata, uint32_t p_index) {
+	CompressData *cd = (CompressData *)p_userdata;
+
+	uint64_t from = (uint64_t)p_index * cd->block_size;
+	uint32_t bl = p_index == cd->blocks.size() - 1 ? cd->size % cd->block_size : cd->block_size;
+
+	Vector<uint8_t> &cblock = cd->blocks[p_index];
+	cblock.resize(Compression::get_max_compressed_buffer_size(bl, cd->mode));
+	int s = Compression::compress(cblock.ptrw(), &cd->src[from], bl, cd->mode);
+	cblock.resize(MAX(s, 0));
+}
+
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_size > UINT32_MAX, Vector<uint8_t>(), "Compressed files can't be larger than 4 GiB.");
+
+	CompressData cd;
+	cd.src = p_data;
+	cd.size = p_size;
+	cd.block_size = p_block_size;
+	cd.mode = p_mode;
+	cd.blocks.resize((p_size / p_block_size) + 1);
+
+	if (cd.blocks.size() >= PARALLEL_BLOCKS_MIN && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&FileAccessCompressed::_compress_block, &cd, cd.blocks.size(), -1, true, SNAME("CompressFileBlocks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < cd.blocks.size(); i++) {
+			_compress_block(&cd, i);
+		}
+	}
+
+	//save block table and all compressed blocks
+
+	CharString mgc = p_magic.utf8();
+	uint64_t total = mgc.length() * 2 + 12 + cd.blocks.size() * 4;
+	for (uint32_t i = 0; i < cd.blocks.size(); i++) {
+		total += cd.blocks[i].size();
+	}
+
+	Vector<uint8_t> ret;
+	ret.resize(total);
+	uint8_t *w = ret.ptrw();
+
+	memcpy(w, mgc.get_data(), mgc.length()); //write header 4
+	w += mgc.length();
+	w += encode_uint32(p_mode, w); //write compression mode 4
+	w += encode_uint32(p_block_size, w); //write block size 4
+	w += encode_uint32(p_size, w); //max amount of data written 4
+
+	for (uint32_t i = 0; i < cd.blocks.size(); i++) {
+		w += encode_uint32(cd.blocks[i].size(), w); //compressed sizes
+	}
+	for (uint32_t i = 0; i < cd.blocks.size(); i++) {
+		memcpy(w, cd.blocks[i].ptr(), cd.blocks[i].size());
+		w += cd.blocks[i].size();
+	}
+
+	memcpy(w, mgc.get_data(), mgc.length()); //magic at the end too
+
+	return ret;
+}
+
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_COND_V(p_mode_flags == READ_WRITE, ERR_UNAVAILABLE);
 	_close();
@@ -131,39 +196,8 @@ void FileAccessCompressed::_close() {
 	}
 
 	if (writing) {
-		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
-
+		Vector<uint8_t> data = compress_buffer(write_ptr, write_max, magic, cmode, block_size);
+		f->store_buffer(data.ptr(), data.size());
 		buffer.clear();
 
 	} else {
@@ -292,6 +326,14 @@ uint8_t FileAccessCompressed::get_8() const {
 	return ret;
 }
 
+void FileAccessCompressed::_decompress_block(uint32_t p_index, DecompressData *p_data) const {
+	const ReadBlock &rb = read_blocks[p_data->first_block + p_index];
+	int ret = Compression::decompress(p_data->dst + (uint64_t)p_index * block_size, block_size, p_data->src + (rb.offset - p_data->src_offset), rb.csize, cmode);
+	if (ret == -1) {
+		p_data->failed.set();
+	}
+}
+
 uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
@@ -302,32 +344,65 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t dst_pos = 0;
+	while (true) {
+		uint64_t to_copy = MIN(p_length - dst_pos, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + dst_pos, read_ptr + read_pos, to_copy);
+		dst_pos += to_copy;
+		read_pos += to_copy;
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
+		if (read_pos < read_block_size || (dst_pos == p_length && to_copy == 0)) {
+			return dst_pos;
+		}
 
+		if (read_block + 1 >= read_block_count) {
+			at_end = true;
+			if (dst_pos < p_length) {
+				read_eof = true;
+			}
+			return dst_pos;
+		}
+
+		// Whole blocks covered by the rest of the read are decompressed straight into the destination.
+		// The last block is always loaded in the read buffer, as it is the only one that can be partial.
+		uint32_t whole_blocks = MIN((p_length - dst_pos) / block_size, (uint64_t)(read_block_count - read_block - 2));
+		if (whole_blocks > 0) {
+			uint32_t first = read_block + 1;
+			uint64_t src_offset = read_blocks[first].offset;
+			uint64_t src_size = read_blocks[first + whole_blocks - 1].offset + read_blocks[first + whole_blocks - 1].csize - src_offset;
+
+			Vector<uint8_t> src;
+			src.resize(src_size);
+			f->get_buffer(src.ptrw(), src_size);
+
+			DecompressData dd;
+			dd.src = src.ptr();
+			dd.dst = p_dst + dst_pos;
+			dd.src_offset = src_offset;
+			dd.first_block = first;
+
+			if (whole_blocks >= PARALLEL_BLOCKS_MIN && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessCompressed::_decompress_block, &dd, whole_blocks, -1, true, SNAME("DecompressFileBlocks"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
+				for (uint32_t i = 0; i < whole_blocks; i++) {
+					_decompress_block(i, &dd);
 				}
-				return i + 1;
 			}
+			ERR_FAIL_COND_V_MSG(dd.failed.is_set(), -1, "Compressed file is corrupt.");
+
+			dst_pos += (uint64_t)whole_blocks * block_size;
+			read_block += whole_blocks;
 		}
-	}
 
-	return p_length;
+		//read another block of compressed data
+		read_block++;
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
+		int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
+		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		read_pos = 0;
+	}
 }
 
 Error FileAccessCompressed::get_error() const {
@@ -33,6 +33,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
@@ -63,6 +65,28 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	// Reads spanning at least this many whole blocks decompress them in parallel.
+	static const uint32_t PARALLEL_BLOCKS_MIN = 4;
+
+	struct DecompressData {
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		uint64_t src_offset = 0; // File offset of the first block in src.
+		uint32_t first_block = 0;
+		SafeFlag failed;
+	};
+
+	struct CompressData {
+		const uint8_t *src = nullptr;
+		uint64_t size = 0;
+		uint32_t block_size = 0;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		LocalVector<Vector<uint8_t>> blocks;
+	};
+
+	void _decompress_block(uint32_t p_index, DecompressData *p_data) const;
+	static void _compress_block(void *p_userdata, uint32_t p_index);
+
 	void _close();
 
 public:
@@ -70,6 +94,9 @@ public:
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
+	// Returns p_data in the same format as a closed compressed file, blocks are compressed in parallel.
+	static Vector<uint8_t> compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size);
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +56,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -118,6 +120,16 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+void PackedData::clear() {
+	files.clear();
+	_free_packed_dirs(root);
+	root = memnew(PackedDir);
+
+	for (int i = 0; i < sources.size(); i++) {
+		sources[i]->clear();
+	}
+}
+
 PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
@@ -201,7 +213,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_MIN || version > PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -248,14 +260,51 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
+	}
+
+	MutexLock lock(mapped_packs_mutex);
+	if (!mapped_packs.has(p_path)) {
+		Ref<FileAccess> mapped = FileAccess::open(p_path, FileAccess::READ);
+		if (mapped.is_valid() && mapped->map_read_only()) {
+			mapped_packs[p_path] = mapped;
+		}
 	}
 
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	Ref<FileAccess> mapped_pack;
+	if (!p_file->encrypted) {
+		MutexLock lock(mapped_packs_mutex);
+		const Ref<FileAccess> *mapped = mapped_packs.getptr(p_file->pack);
+		if (mapped) {
+			mapped_pack = *mapped;
+		}
+	}
+	Ref<FileAccess> fa = memnew(FileAccessPack(p_path, *p_file, mapped_pack));
+	if (!p_file->compressed) {
+		return fa;
+	}
+
+	// Compressed files are stored as a FileAccessCompressed stream, after decryption (if any).
+	uint8_t magic[4];
+	fa->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(memcmp(magic, PACK_FILE_COMPRESSED_MAGIC, 4) != 0, Ref<FileAccess>(), "Compressed pack file is corrupt: " + p_path + ".");
+
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure(PACK_FILE_COMPRESSED_MAGIC);
+	Error err = fac->open_after_magic(fa);
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<FileAccess>(), "Can't open compressed pack file: " + p_path + ".");
+	return fac;
+}
+
+void PackedSourcePCK::clear() {
+	// Files opened from the packs hold their own reference, the packs are unmapped once those are closed.
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.clear();
 }
 
 //////////////////////////////////////////////////////////////////
@@ -266,7 +315,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -274,7 +325,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -282,7 +333,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -303,18 +356,22 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -327,21 +384,38 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	if (to_read > 0) {
+		if (data) {
+			memcpy(p_dst, data + pos, to_read);
+		} else {
+			f->get_buffer(p_dst, to_read);
+		}
+	}
+
 	pos += p_length;
 
-	if (to_read <= 0) {
-		return 0;
+	return to_read > 0 ? to_read : 0;
+}
+
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), nullptr, "File must be opened before use.");
+
+	if (!data || eof || p_length > pf.size - pos) {
+		return nullptr;
 	}
-	f->get_buffer(p_dst, to_read);
 
-	return to_read;
+	const uint8_t *view = data + pos;
+	pos += p_length;
+	return view;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -368,16 +442,32 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	data = nullptr;
+	mapped_pack = Ref<FileAccess>();
 	f = Ref<FileAccess>();
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (p_mapped_pack.is_valid() && !pf.encrypted) {
+		uint64_t mapped_size = 0;
+		const uint8_t *mapped = p_mapped_pack->map_read_only(&mapped_size);
+		// A corrupt directory or a pack that changed on disk may point past the mapping, read those normally.
+		if (mapped && pf.offset <= mapped_size && pf.size <= mapped_size - pf.offset) {
+			mapped_pack = p_mapped_pack; // Keeps the mapping alive while this file is open.
+			data = mapped + pf.offset;
+			return;
+		}
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -395,8 +485,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
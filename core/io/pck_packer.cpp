@@ -32,8 +32,9 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FILE_COMPRESSED
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -49,6 +50,7 @@ static int _get_pad(int p_alignment, int p_n) {
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file_compressed", "pck_path", "source_path", "compression_mode", "encrypt"), &PCKPacker::add_file_compressed, DEFVAL(FileAccess::COMPRESSION_ZSTD), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -89,7 +91,8 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION); // Lowered in flush() if nothing is compressed.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -107,6 +110,15 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 }
 
 Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+	return _add_file(p_file, p_src, p_encrypt, false, FileAccess::COMPRESSION_ZSTD);
+}
+
+Error PCKPacker::add_file_compressed(const String &p_file, const String &p_src, FileAccess::CompressionMode p_compression_mode, bool p_encrypt) {
+	ERR_FAIL_COND_V_MSG(p_compression_mode == FileAccess::COMPRESSION_BROTLI, ERR_INVALID_PARAMETER, "Brotli can only be used for decompression.");
+	return _add_file(p_file, p_src, p_encrypt, true, p_compression_mode);
+}
+
+Error PCKPacker::_add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress, FileAccess::CompressionMode p_compression_mode) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
 	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
@@ -133,6 +145,16 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	}
 	pf.encrypted = p_encrypt;
 
+	// Files that don't fit the 32-bit size of compressed streams, or that don't shrink, are stored as is.
+	if (p_compress && pf.size > 0 && pf.size <= UINT32_MAX) {
+		Vector<uint8_t> compressed_data = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), PACK_FILE_COMPRESSED_MAGIC, (Compression::Mode)p_compression_mode, PACK_FILE_COMPRESSED_BLOCK_SIZE);
+		if (compressed_data.size() > 0 && (uint64_t)compressed_data.size() < pf.size) {
+			pf.compressed_data = compressed_data;
+			pf.compressed = true;
+			pf.size = compressed_data.size();
+		}
+	}
+
 	uint64_t _size = pf.size;
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
@@ -154,6 +176,17 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	bool has_compressed = false;
+	for (int i = 0; i < files.size(); i++) {
+		has_compressed = has_compressed || files[i].compressed;
+	}
+	if (!has_compressed) {
+		int64_t index_ofs = file->get_position();
+		file->seek(version_ofs);
+		file->store_32(PACK_FORMAT_VERSION_UNCOMPRESSED);
+		file->seek(index_ofs);
+	}
+
 	int64_t file_base_ofs = file->get_position();
 	file->store_64(0); // files base
 
@@ -195,6 +228,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -218,9 +254,6 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-
 		Ref<FileAccess> ftmp = file;
 		if (files[i].encrypted) {
 			fae.instantiate();
@@ -231,10 +264,17 @@ Error PCKPacker::flush(bool p_verbose) {
 			ftmp = fae;
 		}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
+		if (files[i].compressed) {
+			ftmp->store_buffer(files[i].compressed_data.ptr(), files[i].compressed_data.size());
+		} else {
+			Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			uint64_t to_write = files[i].size;
+
+			while (to_write > 0) {
+				uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
+				ftmp->store_buffer(buf, read);
+				to_write -= read;
+			}
 		}
 
 		if (fae.is_valid()) {
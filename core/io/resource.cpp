@@ -56,32 +56,62 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 		p_take_over = false; // Can't take over an empty path
 	}
 
-	ResourceCache::lock.lock();
+	if (p_path.is_empty()) {
+		if (!path_cache.is_empty()) {
+			ResourceCache::_remove(path_cache, this);
+		}
+		path_cache = "";
+		_resource_path_changed();
+		return;
+	}
 
-	if (!path_cache.is_empty()) {
-		ResourceCache::resources.erase(path_cache);
+	// Hold the old and the new shard together, so the resource is never missing from the cache while it moves.
+	// They are always locked in the same order to avoid deadlocks.
+	ResourceCache::Shard *old_shard = path_cache.is_empty() ? nullptr : &ResourceCache::_get_shard(path_cache);
+	ResourceCache::Shard *shard = &ResourceCache::_get_shard(p_path);
+	ResourceCache::Shard *first = (old_shard && old_shard < shard) ? old_shard : shard;
+	ResourceCache::Shard *second = (old_shard && old_shard != shard) ? (first == shard ? old_shard : shard) : nullptr;
+	ResourceCache::_write_lock(*first);
+	if (second) {
+		ResourceCache::_write_lock(*second);
 	}
 
+	if (old_shard) {
+		Resource **E = old_shard->resources.getptr(path_cache);
+		if (E && *E == this) {
+			old_shard->resources.erase(path_cache);
+		}
+	}
 	path_cache = "";
 
-	Ref<Resource> existing = ResourceCache::get_ref(p_path);
-
-	if (existing.is_valid()) {
-		if (p_take_over) {
-			existing->path_cache = String();
-			ResourceCache::resources.erase(p_path);
-		} else {
-			ResourceCache::lock.unlock();
-			ERR_FAIL_MSG("Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
+	Ref<Resource> existing; // Released only once unlocked, as freeing it locks its shard too.
+	bool taken = false;
+
+	Resource **E = shard->resources.getptr(p_path);
+	if (E) {
+		existing = Ref<Resource>(*E);
+		// A null reference means the resource is in the process of being deleted, ignore its existence.
+		// Its own path is left alone, it only removes itself from the cache if it's still the entry for it.
+		if (existing.is_valid()) {
+			if (p_take_over) {
+				existing->path_cache = String();
+			} else {
+				taken = true;
+			}
 		}
 	}
 
-	path_cache = p_path;
+	if (!taken) {
+		path_cache = p_path;
+		shard->resources[path_cache] = this;
+	}
 
-	if (!path_cache.is_empty()) {
-		ResourceCache::resources[path_cache] = this;
+	if (second) {
+		second->lock.write_unlock();
 	}
-	ResourceCache::lock.unlock();
+	first->lock.write_unlock();
+
+	ERR_FAIL_COND_MSG(taken, "Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
 
 	_resource_path_changed();
 }
@@ -464,17 +494,20 @@ Resource::Resource() :
 		remapped_list(this) {}
 
 Resource::~Resource() {
+	// Other threads never clear the path of a resource being freed, so reading it here is safe.
+	// If it's stale, removing only erases the cache entry when it still points to this resource.
 	if (!path_cache.is_empty()) {
-		ResourceCache::lock.lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.unlock();
+		ResourceCache::_remove(path_cache, this);
 	}
 	if (owners.size()) {
 		WARN_PRINT("Resource is still owned.");
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
+ResourceCache::Shard ResourceCache::shards[ResourceCache::SHARD_COUNT];
+SafeNumeric<uint64_t> ResourceCache::hits;
+SafeNumeric<uint64_t> ResourceCache::misses;
+SafeNumeric<uint64_t> ResourceCache::contentions;
 #ifdef TOOLS_ENABLED
 HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
@@ -484,91 +517,152 @@ Mutex ResourceCache::lock;
 RWLock ResourceCache::path_cache_lock;
 #endif
 
+void ResourceCache::_read_lock(Shard &p_shard) {
+	if (!p_shard.lock.read_try_lock()) {
+		contentions.increment();
+		p_shard.lock.read_lock();
+	}
+}
+
+void ResourceCache::_write_lock(Shard &p_shard) {
+	if (!p_shard.lock.write_try_lock()) {
+		contentions.increment();
+		p_shard.lock.write_lock();
+	}
+}
+
+void ResourceCache::_remove(const String &p_path, Resource *p_resource) {
+	Shard &shard = _get_shard(p_path);
+	_write_lock(shard);
+
+	Resource **E = shard.resources.getptr(p_path);
+	if (E && *E == p_resource) {
+		shard.resources.erase(p_path);
+	}
+
+	shard.lock.write_unlock();
+}
+
+void ResourceCache::_erase_if_released(Shard &p_shard, const String &p_path, Resource *p_resource) {
+	_write_lock(p_shard);
+
+	// Check again, it may have been replaced while not locked.
+	Resource **E = p_shard.resources.getptr(p_path);
+	if (E && *E == p_resource && p_resource->get_reference_count() == 0) {
+		p_shard.resources.erase(p_path);
+	}
+
+	p_shard.lock.write_unlock();
+}
+
 void ResourceCache::clear() {
-	if (resources.size()) {
+	bool in_use = false;
+	for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+		if (shards[i].resources.size()) {
+			in_use = true;
+			break;
+		}
+	}
+
+	if (in_use) {
 		ERR_PRINT("Resources still in use at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			for (const KeyValue<String, Resource *> &E : resources) {
-				print_line(vformat("Resource still in use: %s (%s)", E.key, E.value->get_class()));
+			for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+				for (const KeyValue<String, Resource *> &E : shards[i].resources) {
+					print_line(vformat("Resource still in use: %s (%s)", E.key, E.value->get_class()));
+				}
 			}
 		}
 	}
 
-	resources.clear();
+	for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+		shards[i].resources.clear();
+	}
 }
 
 bool ResourceCache::has(const String &p_path) {
-	lock.lock();
+	Shard &shard = _get_shard(p_path);
+	_read_lock(shard);
 
-	Resource **res = resources.getptr(p_path);
-
-	if (res && (*res)->get_reference_count() == 0) {
-		// This resource is in the process of being deleted, ignore its existence.
-		(*res)->path_cache = String();
-		resources.erase(p_path);
-		res = nullptr;
-	}
+	Resource **res = shard.resources.getptr(p_path);
+	Resource *found = res ? *res : nullptr;
+	bool released = found && found->get_reference_count() == 0;
 
-	lock.unlock();
+	shard.lock.read_unlock();
 
-	if (!res) {
-		return false;
+	if (released) {
+		// This resource is in the process of being deleted, ignore its existence.
+		_erase_if_released(shard, p_path, found);
+		found = nullptr;
 	}
 
-	return true;
+	// Only retrievals count as hits or misses, so checking before getting a resource counts once.
+	return found != nullptr;
 }
 
 Ref<Resource> ResourceCache::get_ref(const String &p_path) {
 	Ref<Resource> ref;
-	lock.lock();
+	Shard &shard = _get_shard(p_path);
+	_read_lock(shard);
 
-	Resource **res = resources.getptr(p_path);
+	Resource **res = shard.resources.getptr(p_path);
+	Resource *found = res ? *res : nullptr;
 
-	if (res) {
-		ref = Ref<Resource>(*res);
+	if (found) {
+		ref = Ref<Resource>(found);
 	}
 
-	if (res && !ref.is_valid()) {
-		// This resource is in the process of being deleted, ignore its existence
-		(*res)->path_cache = String();
-		resources.erase(p_path);
-		res = nullptr;
+	shard.lock.read_unlock();
+
+	if (found && !ref.is_valid()) {
+		// This resource is in the process of being deleted, ignore its existence.
+		_erase_if_released(shard, p_path, found);
+		found = nullptr;
 	}
 
-	lock.unlock();
+	if (found) {
+		hits.increment();
+	} else {
+		misses.increment();
+	}
 
 	return ref;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
-	lock.lock();
+	for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+		Shard &shard = shards[i];
+		_write_lock(shard);
 
-	LocalVector<String> to_remove;
+		LocalVector<String> to_remove;
 
-	for (KeyValue<String, Resource *> &E : resources) {
-		Ref<Resource> ref = Ref<Resource>(E.value);
+		for (KeyValue<String, Resource *> &E : shard.resources) {
+			Ref<Resource> ref = Ref<Resource>(E.value);
 
-		if (!ref.is_valid()) {
-			// This resource is in the process of being deleted, ignore its existence
-			E.value->path_cache = String();
-			to_remove.push_back(E.key);
-			continue;
+			if (!ref.is_valid()) {
+				// This resource is in the process of being deleted, ignore its existence.
+				to_remove.push_back(E.key);
+				continue;
+			}
+
+			p_resources->push_back(ref);
 		}
 
-		p_resources->push_back(ref);
-	}
+		for (const String &E : to_remove) {
+			shard.resources.erase(E);
+		}
 
-	for (const String &E : to_remove) {
-		resources.erase(E);
+		shard.lock.write_unlock();
 	}
-
-	lock.unlock();
 }
 
 int ResourceCache::get_cached_resource_count() {
-	lock.lock();
-	int rc = resources.size();
-	lock.unlock();
+	int rc = 0;
+	for (uint32_t i = 0; i < SHARD_COUNT; i++) {
+		_read_lock(shards[i]);
+		rc += shards[i].resources.size();
+		shards[i].lock.read_unlock();
+	}
 
 	return rc;
 }
@@ -34,6 +34,7 @@
 #include "core/io/resource_uid.h"
 #include "core/object/class_db.h"
 #include "core/object/ref_counted.h"
+#include "core/os/rw_lock.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 
@@ -152,8 +153,28 @@ public:
 class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
-	static Mutex lock;
-	static HashMap<String, Resource *> resources;
+	static Mutex lock; // Only guards the list of translation remapped resources.
+
+	// Resources are spread in shards by path, so loads and frees on different threads rarely wait on each other.
+	// Lookups only take the shard for reading. They are not lock-free on purpose: a lookup must reference the
+	// resource before it can be freed, and freeing removes it from the shard under the write lock. Lock-free
+	// reads would need deferred reclamation of both the map entries and the resources to be safe.
+	static const uint32_t SHARD_COUNT = 16;
+	struct Shard {
+		RWLock lock;
+		HashMap<String, Resource *> resources;
+	};
+	static Shard shards[SHARD_COUNT];
+
+	static SafeNumeric<uint64_t> hits;
+	static SafeNumeric<uint64_t> misses;
+	static SafeNumeric<uint64_t> contentions;
+
+	_FORCE_INLINE_ static Shard &_get_shard(const String &p_path) { return shards[get_shard_index(p_path)]; }
+	static void _read_lock(Shard &p_shard);
+	static void _write_lock(Shard &p_shard);
+	static void _remove(const String &p_path, Resource *p_resource);
+	static void _erase_if_released(Shard &p_shard, const String &p_path, Resource *p_resource);
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
@@ -163,10 +184,17 @@ class ResourceCache {
 	friend void register_core_types();
 
 public:
+	static uint32_t get_shard_count() { return SHARD_COUNT; }
+	_FORCE_INLINE_ static uint32_t get_shard_index(const String &p_path) { return p_path.hash() & (SHARD_COUNT - 1); }
+
 	static bool has(const String &p_path);
 	static Ref<Resource> get_ref(const String &p_path);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static uint64_t get_hit_count() { return hits.get(); }
+	static uint64_t get_miss_count() { return misses.get(); }
+	static uint64_t get_contention_count() { return contentions.get(); }
 };
 
 #endif // RESOURCE_H
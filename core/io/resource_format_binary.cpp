@@ -711,7 +711,7 @@ Error ResourceLoaderBinary::load() {
 				internal_resources.write[i].path = path; // Update path.
 			}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> cached = ResourceCache::get_ref(path);
 				if (cached.is_valid()) {
 					//already loaded, don't do anything
@@ -734,10 +734,10 @@ Error ResourceLoaderBinary::load() {
 
 		Ref<Resource> res;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE) {
 			//use the existing one
 			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
+			if (cached.is_valid() && cached->get_class() == t) {
 				cached->reset_state();
 				res = cached;
 			}
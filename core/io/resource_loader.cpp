@@ -124,6 +124,19 @@ void ResourceLoader::get_recognized_extensions_for_type(const String &p_type, Li
 	}
 }
 
+bool ResourceLoader::has_non_native_loaders() {
+	for (int i = 0; i < loader_count; i++) {
+		if (loader[i]->get_script_instance()) {
+			return true;
+		}
+		ClassDB::APIType api = ClassDB::get_api_type(loader[i]->get_class_name());
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool ResourceFormatLoader::exists(const String &p_path) const {
 	bool success = false;
 	if (GDVIRTUAL_CALL(_exists, p_path, success)) {
@@ -291,8 +304,15 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		thread_load_mutex.unlock();
 		return;
 	}
+	bool prefetch_dependencies = load_task.prefetch_dependencies;
 	thread_load_mutex.unlock();
 
+	// Keeps the prefetched dependencies alive until the resource itself has been loaded.
+	LocalVector<Ref<LoadToken>> prefetch_tokens;
+	if (prefetch_dependencies) {
+		_prefetch_dependencies(load_task, prefetch_tokens);
+	}
+
 	// Thread-safe either if it's the current thread or a brand new one.
 	CallQueue *mq_override = nullptr;
 	if (load_nesting == 0) {
@@ -381,6 +401,84 @@ static String _validate_local_path(const String &p_path) {
 	}
 }
 
+void ResourceLoader::_prefetch_dependencies_of(void *p_userdata, uint32_t p_index) {
+	DependencyPrefetchLevel *level = (DependencyPrefetchLevel *)p_userdata;
+	get_dependencies(level->paths[p_index], &level->dependencies[p_index], true);
+}
+
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens) {
+	// Walk the dependency graph level by level. Loaders only read the headers of the files for this,
+	// which also brings them in the OS caches before the actual loads need them.
+	HashSet<String> visited;
+	visited.insert(p_load_task.local_path);
+
+	LocalVector<String> found_paths;
+	LocalVector<String> found_types;
+
+	DependencyPrefetchLevel level;
+	level.paths.push_back(p_load_task.local_path);
+
+	while (level.paths.size()) {
+		level.dependencies.clear();
+		level.dependencies.resize(level.paths.size());
+
+		if (level.paths.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&ResourceLoader::_prefetch_dependencies_of, &level, level.paths.size(), -1, true, SNAME("ResourceLoaderPrefetch"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			_prefetch_dependencies_of(&level, 0);
+		}
+
+		LocalVector<String> next_paths;
+		for (const List<String> &dependencies : level.dependencies) {
+			for (const String &E : dependencies) {
+				// Dependencies are given as "path::type", with the fallback path third when the first is an UID.
+				String path = E.get_slice("::", 0);
+				String type = E.get_slice("::", 1);
+				if (path.begins_with("uid://") && !ResourceUID::get_singleton()->has_id(ResourceUID::get_singleton()->text_to_id(path))) {
+					path = E.get_slice("::", 2);
+				}
+				if (path.is_empty()) {
+					continue;
+				}
+
+				path = _validate_local_path(path);
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+
+				if (ResourceCache::has(path)) {
+					continue; // Already loaded, and so are its own dependencies.
+				}
+
+				found_paths.push_back(path);
+				found_types.push_back(type);
+				next_paths.push_back(path);
+			}
+		}
+		level.paths = next_paths;
+	}
+
+	if (found_paths.is_empty()) {
+		return;
+	}
+
+	// Schedule the deepest dependencies first, so they are already loading by the time the resources
+	// referencing them start waiting. Loaders reaching for them later will just share these loads.
+	for (int64_t i = found_paths.size() - 1; i >= 0; i--) {
+		Ref<LoadToken> token = _load_start(found_paths[i], found_types[i], LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE);
+		if (token.is_valid()) {
+			r_tokens.push_back(token);
+		}
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	for (const String &E : found_paths) {
+		p_load_task.sub_tasks.insert(E);
+	}
+}
+
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
 	thread_load_mutex.lock();
 	if (user_load_tokens.has(p_path)) {
@@ -392,7 +490,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
@@ -423,7 +521,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_prefetch_dependencies) {
 	String local_path = _validate_local_path(p_path);
 
 	Ref<LoadToken> load_token;
@@ -460,6 +558,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.prefetch_dependencies = p_prefetch_dependencies && load_task.use_sub_threads && p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE;
 			if (p_cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -126,7 +126,7 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_prefetch_dependencies = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -175,10 +175,18 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
+		bool prefetch_dependencies = false; // Schedule the whole dependency graph before loading.
 		HashSet<String> sub_tasks;
 	};
 
+	struct DependencyPrefetchLevel {
+		LocalVector<String> paths;
+		LocalVector<List<String>> dependencies;
+	};
+
 	static void _thread_load_function(void *p_userdata);
+	static void _prefetch_dependencies_of(void *p_userdata, uint32_t p_index);
+	static void _prefetch_dependencies(ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens);
 
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
@@ -202,6 +210,8 @@ public:
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
+	// Whether loaders implemented by scripts or GDExtensions are registered, those may not expect calls from several threads.
+	static bool has_non_native_loaders();
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
 	static void get_classes_used(const String &p_path, HashSet<StringName> *r_classes);
@@ -1013,6 +1013,9 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+// Above this, connections are copied to the heap when emitting instead, so huge signals can't overflow the stack.
+#define MAX_STACK_SIGNAL_SLOTS 64
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1036,23 +1039,31 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	List<_ObjectSignalDisconnectData> disconnect_data;
 
 	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	LocalVector<Connection> slot_conns;
-	slot_conns.resize(s->slot_map.size());
+	// will not affect the signal calling. Only the callables and flags are
+	// needed, and they are kept on the stack unless there are a lot of them.
+	const uint32_t slot_count = s->slot_map.size();
+	const bool slots_on_stack = slot_count <= MAX_STACK_SIGNAL_SLOTS;
+	Callable *slot_callables = (Callable *)(slots_on_stack ? alloca(sizeof(Callable) * slot_count) : Memory::alloc_static(sizeof(Callable) * slot_count));
+	uint32_t *slot_flags = (uint32_t *)(slots_on_stack ? alloca(sizeof(uint32_t) * slot_count) : Memory::alloc_static(sizeof(uint32_t) * slot_count));
 	{
 		uint32_t idx = 0;
 		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			slot_conns[idx++] = slot_kv.value.conn;
+			memnew_placement(&slot_callables[idx], Callable(slot_kv.value.conn.callable));
+			slot_flags[idx] = slot_kv.value.conn.flags;
+			idx++;
 		}
-		DEV_ASSERT(idx == s->slot_map.size());
+		DEV_ASSERT(idx == slot_count);
 	}
 
 	OBJ_DEBUG_LOCK
 
 	Error err = OK;
 
-	for (const Connection &c : slot_conns) {
-		Object *target = c.callable.get_object();
+	for (uint32_t i = 0; i < slot_count; i++) {
+		const Callable &callable = slot_callables[i];
+		const uint32_t flags = slot_flags[i];
+
+		Object *target = callable.get_object();
 		if (!target) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
@@ -1061,33 +1072,33 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
-		if (c.flags & CONNECT_DEFERRED) {
-			MessageQueue::get_singleton()->push_callablep(c.callable, args, argc, true);
+		if (flags & CONNECT_DEFERRED) {
+			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
 		} else {
 			Callable::CallError ce;
 			_emitting = true;
 			Variant ret;
-			c.callable.callp(args, argc, ret, ce);
+			callable.callp(args, argc, ret, ce);
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
-				if (c.flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool())) {
+				if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool())) {
 					continue;
 				}
 #endif
 				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && !ClassDB::class_exists(target->get_class_name())) {
 					//most likely object is not initialized yet, do not throw error.
 				} else {
-					ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(c.callable, args, argc, ce) + ".");
+					ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(callable, args, argc, ce) + ".");
 					err = ERR_METHOD_NOT_FOUND;
 				}
 			}
 		}
 
-		bool disconnect = c.flags & CONNECT_ONE_SHOT;
+		bool disconnect = flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (c.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			//this signal was connected from the editor, and is being edited. just don't disconnect for now
 			disconnect = false;
 		}
@@ -1095,11 +1106,19 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		if (disconnect) {
 			_ObjectSignalDisconnectData dd;
 			dd.signal = p_name;
-			dd.callable = c.callable;
+			dd.callable = callable;
 			disconnect_data.push_back(dd);
 		}
 	}
 
+	for (uint32_t i = 0; i < slot_count; i++) {
+		slot_callables[i].~Callable();
+	}
+	if (!slots_on_stack) {
+		Memory::free_static(slot_callables);
+		Memory::free_static(slot_flags);
+	}
+
 	while (!disconnect_data.is_empty()) {
 		const _ObjectSignalDisconnectData &dd = disconnect_data.front()->get();
 
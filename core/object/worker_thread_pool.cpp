@@ -515,7 +515,26 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
-		group->done_semaphore.wait();
+		if (thread_ids.has(Thread::get_caller_id())) {
+			// Same as with tasks: a pool thread waiting on a group must keep processing
+			// the queue, otherwise nested groups could leave no thread to run them.
+			bool must_exit = false;
+			while (!group->done_semaphore.try_wait()) {
+				if (!must_exit && task_available_semaphore.try_wait()) {
+					if (exit_threads) {
+						must_exit = true;
+					} else {
+						bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
+						_process_task_queue();
+						set_current_thread_safe_for_nodes(safe_for_nodes_backup);
+						continue;
+					}
+				}
+				OS::get_singleton()->delay_usec(1);
+			}
+		} else {
+			group->done_semaphore.wait();
+		}
 
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
@@ -70,6 +70,66 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	return &sync_sems[idx];
 }
 
+void CommandQueueMT::_flush_level(uint32_t p_level) {
+	// A nested flush can add levels, so don't keep references to flush_levels
+	// across calls. The buffers themselves aren't written to while being flushed.
+	while (flush_levels[p_level].read_ptr < flush_levels[p_level].mem->size()) {
+		LocalVector<uint8_t> &mem = *flush_levels[p_level].mem;
+		uint64_t read_ptr = flush_levels[p_level].read_ptr;
+		uint64_t size = *(uint64_t *)&mem[read_ptr];
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&mem[read_ptr + 8]);
+		// Skip it before running it, so a flush started by the command doesn't run it again.
+		flush_levels[p_level].read_ptr = read_ptr + 8 + size;
+
+		cmd->call(); //execute the function
+		cmd->post(); //release in case it needs sync/ret
+		cmd->~CommandBase(); //should be done, so erase the command
+	}
+}
+
+void CommandQueueMT::_flush() {
+	MutexLock flush_lock(flush_mutex);
+
+	// Commands left in the buffers being flushed were pushed before any in the write buffer.
+	for (uint32_t i = 0; i < flush_levels.size(); i++) {
+		_flush_level(i);
+	}
+
+	bool nested = !flush_levels.is_empty();
+	LocalVector<uint8_t> *mem;
+
+	lock();
+	if (!nested) {
+		mem = &command_mem[write_index];
+		write_index = 1 - write_index;
+	} else {
+		// The other buffer is still being flushed, so it can't take new commands yet.
+		// Move the commands to a buffer of their own instead.
+		mem = memnew(LocalVector<uint8_t>(command_mem[write_index]));
+		command_mem[write_index].clear();
+	}
+	pending_commands.set(0);
+	unlock();
+
+	flush_levels.push_back({ mem, 0 });
+	_flush_level(flush_levels.size() - 1);
+	flush_levels.resize(flush_levels.size() - 1);
+
+	if (nested) {
+		memdelete(mem);
+	} else {
+		mem->clear();
+	}
+}
+
+CommandQueueMT::Stats CommandQueueMT::get_and_reset_stats() {
+	lock();
+	Stats ret = stats;
+	stats = Stats();
+	unlock();
+	return ret;
+}
+
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 	if (p_sync) {
 		sync = memnew(Semaphore);
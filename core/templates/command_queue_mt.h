@@ -36,6 +36,7 @@
 #include "core/os/semaphore.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -256,7 +257,7 @@
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
 		unlock();                                                            \
 		if (sync)                                                            \
-			sync->post();                                                    \
+			_post_wakeup();                                                  \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -273,7 +274,7 @@
 		cmd->sync_sem = ss;                                                                    \
 		unlock();                                                                              \
 		if (sync)                                                                              \
-			sync->post();                                                                      \
+			_post_wakeup();                                                                    \
 		ss->sem.wait();                                                                        \
 		ss->in_use = false;                                                                    \
 	}
@@ -291,7 +292,7 @@
 		cmd->sync_sem = ss;                                                           \
 		unlock();                                                                     \
 		if (sync)                                                                     \
-			sync->post();                                                             \
+			_post_wakeup();                                                           \
 		ss->sem.wait();                                                               \
 		ss->in_use = false;                                                           \
 	}
@@ -336,51 +337,74 @@ class CommandQueueMT {
 		SYNC_SEMAPHORES = 8
 	};
 
-	LocalVector<uint8_t> command_mem;
+public:
+	struct Stats {
+		uint64_t commands = 0;
+		uint64_t bytes = 0;
+		uint64_t stalls = 0; // Pushes that had to wait for another thread to release the queue.
+	};
+
+private:
+	// Commands are pushed into one buffer while the other one is being flushed,
+	// so producers only ever wait for each other or for a buffer swap, never for
+	// commands to execute.
+	LocalVector<uint8_t> command_mem[2];
+	uint32_t write_index = 0;
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex mutex;
+	Mutex flush_mutex;
 	Semaphore *sync = nullptr;
+	// Commands in the write buffer, so checking for them doesn't need the lock.
+	SafeNumeric<uint32_t> pending_commands;
+
+	struct FlushLevel {
+		LocalVector<uint8_t> *mem = nullptr;
+		uint64_t read_ptr = 0;
+	};
+	// Buffers being flushed, oldest first. A command can flush the queue again on
+	// the same thread, which then runs what's left of them before anything newer.
+	// Only touched with flush_mutex held.
+	LocalVector<FlushLevel> flush_levels;
+
+	// Pushes since wait_and_flush() last woke up. The semaphore is only posted when
+	// this goes from zero to one, so the consumer wakes up once per batch.
+	SafeNumeric<uint32_t> pending_wakeups;
+	Stats stats;
 
 	template <class T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
 		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		LocalVector<uint8_t> &mem = command_mem[write_index];
+		uint64_t size = mem.size();
+		mem.resize(size + alloc_size + 8);
+		*(uint64_t *)&mem[size] = alloc_size;
+		T *cmd = memnew_placement(&mem[size + 8], T);
+		pending_commands.increment();
+		stats.commands++;
+		stats.bytes += alloc_size + 8;
 		return cmd;
 	}
 
 	template <class T>
 	T *allocate_and_lock() {
-		lock();
+		if (!mutex.try_lock()) {
+			lock();
+			stats.stalls++;
+		}
 		T *ret = allocate<T>();
 		return ret;
 	}
 
-	void _flush() {
-		lock();
-
-		uint64_t read_ptr = 0;
-		uint64_t limit = command_mem.size();
-
-		while (read_ptr < limit) {
-			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
-			read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
-
-			cmd->call(); //execute the function
-			cmd->post(); //release in case it needs sync/ret
-			cmd->~CommandBase(); //should be done, so erase the command
-
-			read_ptr += size;
+	_FORCE_INLINE_ void _post_wakeup() {
+		if (pending_wakeups.postincrement() == 0) {
+			sync->post();
 		}
-
-		command_mem.clear();
-		unlock();
 	}
 
+	void _flush_level(uint32_t p_level);
+	void _flush();
+
 	void lock();
 	void unlock();
 	void wait_for_flush();
@@ -400,7 +424,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(pending_commands.get() > 0)) {
 			_flush();
 		}
 	}
@@ -411,9 +435,15 @@ public:
 	void wait_and_flush() {
 		ERR_FAIL_COND(!sync);
 		sync->wait();
+		// Everything pushed until now is run by this flush. Pushes from here on
+		// post again, as their commands may land after the buffers are swapped.
+		pending_wakeups.set(0);
 		_flush();
 	}
 
+	// Returns the number of commands and bytes pushed, and how many pushes stalled, since the last call.
+	Stats get_and_reset_stats();
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
@@ -35,12 +35,20 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
+#include <clocale>
+#include <cstdlib>
+
+// Parses a number token exactly. String::to_float() isn't correctly rounded for long mantissas and
+// extreme exponents, the C library is, but it follows the decimal point of the locale.
+static double _parse_float_exact(const String &p_num) {
+	const lconv *locale = localeconv();
+	if (locale && locale->decimal_point && locale->decimal_point[0] == '.' && locale->decimal_point[1] == 0) {
+		return strtod(p_num.ascii().get_data(), nullptr);
 	}
+	return p_num.to_float();
+}
 
+char32_t VariantParser::Stream::_get_char_refill() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
@@ -86,6 +94,37 @@ uint32_t VariantParser::StreamFile::_read_buffer(char32_t *p_buffer, uint32_t p_
 	return num_read;
 }
 
+void VariantParser::StreamBuffer::set_buffer(const uint8_t *p_data, uint64_t p_size) {
+	data = p_data;
+	size = p_size;
+	pos = 0;
+}
+
+bool VariantParser::StreamBuffer::is_utf8() const {
+	return true;
+}
+
+bool VariantParser::StreamBuffer::_is_eof() const {
+	return pos >= size;
+}
+
+uint32_t VariantParser::StreamBuffer::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
+	// The buffer is assumed to include at least one character (for null terminator)
+	ERR_FAIL_COND_V(!p_num_chars, 0);
+
+	uint32_t num_read = MIN((uint64_t)p_num_chars, size - pos);
+	const uint8_t *src = data + pos;
+
+	// translate to wchar
+	for (uint32_t n = 0; n < num_read; n++) {
+		p_buffer[n] = src[n];
+	}
+	pos += num_read;
+
+	// could be less than p_num_chars, or zero
+	return num_read;
+}
+
 bool VariantParser::StreamString::is_utf8() const {
 	return false;
 }
@@ -422,8 +461,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 #define READING_DONE 4
 					int reading = READING_INT;
 
+					bool negative = false;
 					if (cchar == '-') {
 						num += '-';
+						negative = true;
 						cchar = p_stream->get_char();
 					}
 
@@ -432,11 +473,22 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					bool exp_beg = false;
 					bool is_float = false;
 
+					// Integers are accumulated while reading, so they don't need to be parsed again from the buffer.
+					// Digits after the point are accumulated too, as the mantissa of floats.
+					uint64_t int_value = 0;
+					bool int_overflow = false;
+					int decimal_digits = 0;
+					int exp_value = 0;
+					bool exp_negative = false;
+
 					while (true) {
 						switch (reading) {
 							case READING_INT: {
 								if (is_digit(c)) {
-									//pass
+									if (int_value > (UINT64_MAX - 9) / 10) {
+										int_overflow = true;
+									}
+									int_value = int_value * 10 + (c - '0');
 								} else if (c == '.') {
 									reading = READING_DEC;
 									is_float = true;
@@ -450,6 +502,13 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 							case READING_DEC: {
 								if (is_digit(c)) {
+									if (int_value > (UINT64_MAX - 9) / 10) {
+										int_overflow = true;
+									}
+									int_value = int_value * 10 + (c - '0');
+									if (decimal_digits < INT16_MAX) {
+										decimal_digits++;
+									}
 								} else if (c == 'e') {
 									reading = READING_EXP;
 								} else {
@@ -460,9 +519,13 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							case READING_EXP: {
 								if (is_digit(c)) {
 									exp_beg = true;
+									if (exp_value < INT16_MAX) {
+										exp_value = exp_value * 10 + (c - '0');
+									}
 
 								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
 									exp_sign = true;
+									exp_negative = c == '-';
 
 								} else {
 									reading = READING_DONE;
@@ -482,9 +545,25 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					r_token.type = TK_NUMBER;
 
 					if (is_float) {
-						r_token.value = num.as_double();
+						// A mantissa below 2^53 and a power of ten below 10^23 are both exact doubles, so a
+						// single multiplication or division gives the correctly rounded value. Others are
+						// parsed from the buffer, exactly too.
+						static const double powers_of_ten[] = {
+							1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+							1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+						};
+						const int exponent = (exp_negative ? -exp_value : exp_value) - decimal_digits;
+						if (!int_overflow && int_value <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+							double value = (double)int_value;
+							value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+							r_token.value = negative ? -value : value;
+						} else {
+							r_token.value = _parse_float_exact(num.as_string());
+						}
+					} else if (!int_overflow && int_value <= (uint64_t)INT64_MAX) {
+						r_token.value = negative ? -(int64_t)int_value : (int64_t)int_value;
 					} else {
-						r_token.value = num.as_int();
+						r_token.value = num.as_int(); // Clamps and reports out of range values.
 					}
 					return OK;
 				} else if (is_ascii_char(cchar) || is_underscore(cchar)) {
@@ -45,6 +45,8 @@ public:
 		uint32_t readahead_filled = 0;
 		bool eof = false;
 
+		char32_t _get_char_refill();
+
 	protected:
 		bool readahead_enabled = true;
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
@@ -53,7 +55,13 @@ public:
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		_FORCE_INLINE_ char32_t get_char() {
+			// is within buffer?
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _get_char_refill();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -89,6 +97,25 @@ public:
 		StreamString(bool p_readahead_enabled = true) { readahead_enabled = p_readahead_enabled; }
 	};
 
+	// Reads UTF-8 text from contiguous memory, which must stay valid while parsing.
+	struct StreamBuffer : public Stream {
+	private:
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+		uint64_t pos = 0;
+
+	protected:
+		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) override;
+		virtual bool _is_eof() const override;
+
+	public:
+		void set_buffer(const uint8_t *p_data, uint64_t p_size);
+
+		virtual bool is_utf8() const override;
+
+		StreamBuffer(bool p_readahead_enabled = true) { readahead_enabled = p_readahead_enabled; }
+	};
+
 	typedef Error (*ParseResourceFunc)(void *p_self, Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
 
 	struct ResourceParser {
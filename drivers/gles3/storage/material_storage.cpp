@@ -1785,6 +1785,7 @@ void MaterialStorage::global_shader_parameter_add(const StringName &p_name, RS::
 	}
 
 	global_shader_uniforms.variables[p_name] = gv;
+	ShaderCompiler::global_uniforms_changed();
 }
 
 void MaterialStorage::global_shader_parameter_remove(const StringName &p_name) {
@@ -1801,6 +1802,7 @@ void MaterialStorage::global_shader_parameter_remove(const StringName &p_name) {
 	}
 
 	global_shader_uniforms.variables.erase(p_name);
+	ShaderCompiler::global_uniforms_changed();
 }
 
 Vector<StringName> MaterialStorage::global_shader_parameter_get_list() const {
@@ -1979,6 +1981,7 @@ void MaterialStorage::global_shader_parameters_load_settings(bool p_load_texture
 
 void MaterialStorage::global_shader_parameters_clear() {
 	global_shader_uniforms.variables.clear();
+	ShaderCompiler::global_uniforms_changed();
 }
 
 GLuint MaterialStorage::global_shader_parameters_get_uniform_buffer() const {
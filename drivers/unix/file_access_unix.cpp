@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -153,6 +154,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -248,6 +255,70 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+	// Files opened for reading are mapped on the first view.
+	uint64_t size = 0;
+	const uint8_t *data = _map(&size);
+	if (!data) {
+		return nullptr;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0 || (uint64_t)pos > size || p_length > size - (uint64_t)pos) {
+		return nullptr;
+	}
+
+	ERR_FAIL_COND_V(fseeko(f, pos + p_length, SEEK_SET), nullptr);
+	return data + pos;
+}
+
+const uint8_t *FileAccessUnix::map_read_only(uint64_t *r_size) {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+	return _map(r_size);
+}
+
+const uint8_t *FileAccessUnix::_map(uint64_t *r_size) const {
+	if (mapped) {
+		// Pages past the end of a truncated file raise SIGBUS when touched, so stop handing out the mapping then.
+		struct stat st = {};
+		if (fstat(fileno(f), &st) != 0 || (uint64_t)st.st_size < mapped_size) {
+			return nullptr;
+		}
+		if (r_size) {
+			*r_size = mapped_size;
+		}
+		return mapped;
+	}
+
+	if (flags != READ) {
+		return nullptr;
+	}
+
+#ifdef WEB_ENABLED
+	// Emscripten emulates mmap by reading the whole file into the heap.
+	return nullptr;
+#else
+	struct stat st = {};
+	if (fstat(fileno(f), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = (uint8_t *)ptr;
+	mapped_size = st.st_size;
+	if (r_size) {
+		*r_size = mapped_size;
+	}
+	return mapped;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable uint8_t *mapped = nullptr;
+	mutable uint64_t mapped_size = 0;
+
+	const uint8_t *_map(uint64_t *r_size) const;
 	void _close();
 
 public:
@@ -69,6 +73,8 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only(uint64_t *r_size = nullptr) override;
 
 	virtual Error get_error() const override; ///< get last error
 
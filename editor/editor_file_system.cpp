@@ -762,6 +762,83 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 }
 
 void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress) {
+	// Walk the directories first, then scan the files found in them in parallel. Reading the
+	// import metadata and the resource headers dominates the scan on large projects.
+	LocalVector<ScannedFile> scanned_files;
+	_scan_new_dir_tree(p_dir, da, scanned_files);
+
+	// Loaders and importers made in scripts or GDExtensions may not expect to be called from several threads,
+	// and can claim any file, so everything is scanned on this thread when one is registered.
+	bool serial = ResourceLoader::has_non_native_loaders();
+	if (!serial) {
+		List<Ref<ResourceImporter>> importers;
+		ResourceFormatImporter::get_singleton()->get_importers(&importers);
+		for (const Ref<ResourceImporter> &E : importers) {
+			ClassDB::APIType api = ClassDB::get_api_type(E->get_class_name());
+			if (E->get_script_instance() || api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+				serial = true;
+				break;
+			}
+		}
+	}
+
+	// Script parsers keep shared state, so scripts are scanned on this thread too.
+	HashSet<String> script_extensions;
+	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+		List<String> extensions;
+		ScriptServer::get_language(i)->get_recognized_extensions(&extensions);
+		for (const String &E : extensions) {
+			script_extensions.insert(E);
+		}
+	}
+	for (ScannedFile &sf : scanned_files) {
+		sf.serial = serial || script_extensions.has(sf.ext);
+	}
+
+	int total = scanned_files.size();
+	for (int from = 0; from < total; from += SCAN_FILES_BATCH_SIZE) {
+		int count = MIN(SCAN_FILES_BATCH_SIZE, total - from);
+
+		if (!serial && count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_scan_new_file_task, scanned_files.ptr() + from, count, -1, true, SNAME("EditorFileSystemScan"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (int i = 0; i < count; i++) {
+				_scan_new_file_task(i, scanned_files.ptr() + from);
+			}
+		}
+
+		// Anything touching shared state is applied here, in scan order.
+		for (int i = from; i < from + count; i++) {
+			ScannedFile &sf = scanned_files[i];
+			EditorFileSystemDirectory::FileInfo *fi = sf.info;
+
+			if (sf.serial) {
+				_scan_new_file(sf);
+			}
+
+			if (sf.read_script_class) {
+				fi->script_class_name = _get_global_script_class(fi->type, sf.path, &fi->script_class_extends, &fi->script_class_icon_path);
+			}
+
+			if (sf.update_script_class) {
+				_queue_update_script_class(sf.path);
+			}
+
+			if (sf.test_reimport) {
+				ItemAction ia;
+				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
+				ia.dir = sf.dir;
+				ia.file = fi->file;
+				scan_actions.push_back(ia);
+			}
+		}
+
+		p_progress.update(from + count, total);
+	}
+}
+
+void EditorFileSystem::_scan_new_dir_tree(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, LocalVector<ScannedFile> &r_files) {
 	List<String> dirs;
 	List<String> files;
 
@@ -801,10 +878,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 	dirs.sort_custom<NaturalNoCaseComparator>();
 	files.sort_custom<NaturalNoCaseComparator>();
 
-	int total = dirs.size() + files.size();
-	int idx = 0;
-
-	for (List<String>::Element *E = dirs.front(); E; E = E->next(), idx++) {
+	for (List<String>::Element *E = dirs.front(); E; E = E->next()) {
 		if (da->change_dir(E->get()) == OK) {
 			String d = da->get_current_dir();
 
@@ -816,7 +890,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 				efd->parent = p_dir;
 				efd->name = E->get();
 
-				_scan_new_dir(efd, da, p_progress.get_sub(idx, total));
+				_scan_new_dir_tree(efd, da, r_files);
 
 				int idx2 = 0;
 				for (int i = 0; i < p_dir->subdirs.size(); i++) {
@@ -836,11 +910,9 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 		} else {
 			ERR_PRINT("Cannot go into subdir '" + E->get() + "'.");
 		}
-
-		p_progress.update(idx, total);
 	}
 
-	for (List<String>::Element *E = files.front(); E; E = E->next(), idx++) {
+	for (List<String>::Element *E = files.front(); E; E = E->next()) {
 		String ext = E->get().get_extension().to_lower();
 		if (!valid_extensions.has(ext)) {
 			continue; //invalid
@@ -848,112 +920,118 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 
 		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
 		fi->file = E->get();
+		p_dir->files.push_back(fi);
 
-		String path = cd.path_join(fi->file);
-
-		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
-
-		if (import_extensions.has(ext)) {
-			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
+		ScannedFile sf;
+		sf.dir = p_dir;
+		sf.info = fi;
+		sf.path = cd.path_join(fi->file);
+		sf.ext = ext;
+		r_files.push_back(sf);
+	}
+}
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
-				fi->type = fc->type;
-				fi->resource_script_class = fc->resource_script_class;
-				fi->uid = fc->uid;
-				fi->deps = fc->deps;
-				fi->modified_time = fc->modification_time;
-				fi->import_modified_time = fc->import_modification_time;
+void EditorFileSystem::_scan_new_file_task(uint32_t p_index, ScannedFile *p_files) {
+	if (!p_files[p_index].serial) {
+		_scan_new_file(p_files[p_index]);
+	}
+}
 
-				fi->import_valid = fc->import_valid;
-				fi->script_class_name = fc->script_class_name;
-				fi->import_group_file = fc->import_group_file;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
+void EditorFileSystem::_scan_new_file(ScannedFile &p_file) {
+	EditorFileSystemDirectory::FileInfo *fi = p_file.info;
+	const String &path = p_file.path;
 
-				if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
-					ItemAction ia;
-					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-					ia.dir = p_dir;
-					ia.file = E->get();
-					scan_actions.push_back(ia);
-				}
+	const FileCache *fc = file_cache.getptr(path);
+	uint64_t mt = FileAccess::get_modified_time(path);
 
-				if (fc->type.is_empty()) {
-					fi->type = ResourceLoader::get_resource_type(path);
-					fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
-					fi->import_group_file = ResourceLoader::get_import_group_file(path);
-					//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
-					//note: I think this should not happen any longer..
-				}
+	if (import_extensions.has(p_file.ext)) {
+		//is imported
+		uint64_t import_mt = 0;
+		if (FileAccess::exists(path + ".import")) {
+			import_mt = FileAccess::get_modified_time(path + ".import");
+		}
 
-				if (fc->uid == ResourceUID::INVALID_ID) {
-					// imported files should always have a UID, so attempt to fetch it.
-					fi->uid = ResourceLoader::get_resource_uid(path);
-				}
+		if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			fi->type = fc->type;
+			fi->resource_script_class = fc->resource_script_class;
+			fi->uid = fc->uid;
+			fi->deps = fc->deps;
+			fi->modified_time = fc->modification_time;
+			fi->import_modified_time = fc->import_modification_time;
 
-			} else {
-				fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(path);
-				fi->uid = ResourceFormatImporter::get_singleton()->get_resource_uid(path);
-				fi->import_group_file = ResourceFormatImporter::get_singleton()->get_import_group_file(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->modified_time = 0;
-				fi->import_modified_time = 0;
-				fi->import_valid = fi->type == "TextFile" ? true : ResourceLoader::is_import_valid(path);
+			fi->import_valid = fc->import_valid;
+			fi->script_class_name = fc->script_class_name;
+			fi->import_group_file = fc->import_group_file;
+			fi->script_class_extends = fc->script_class_extends;
+			fi->script_class_icon_path = fc->script_class_icon_path;
 
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = E->get();
-				scan_actions.push_back(ia);
+			if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
+				p_file.test_reimport = true;
 			}
-		} else {
-			if (fc && fc->modification_time == mt) {
-				//not imported, so just update type if changed
-				fi->type = fc->type;
-				fi->resource_script_class = fc->resource_script_class;
-				fi->uid = fc->uid;
-				fi->modified_time = fc->modification_time;
-				fi->deps = fc->deps;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
-				fi->script_class_name = fc->script_class_name;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
-			} else {
-				//new or modified time
+
+			if (fc->type.is_empty()) {
 				fi->type = ResourceLoader::get_resource_type(path);
 				fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
-				if (fi->type == "" && textfile_extensions.has(ext)) {
-					fi->type = "TextFile";
-				}
+				fi->import_group_file = ResourceLoader::get_import_group_file(path);
+				//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
+				//note: I think this should not happen any longer..
+			}
+
+			if (fc->uid == ResourceUID::INVALID_ID) {
+				// imported files should always have a UID, so attempt to fetch it.
 				fi->uid = ResourceLoader::get_resource_uid(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->deps = _get_dependencies(path);
-				fi->modified_time = mt;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
-
-				if (ClassDB::is_parent_class(fi->type, SNAME("Script"))) {
-					_queue_update_script_class(path);
-				}
 			}
-		}
 
-		if (fi->uid != ResourceUID::INVALID_ID) {
-			if (ResourceUID::get_singleton()->has_id(fi->uid)) {
-				ResourceUID::get_singleton()->set_id(fi->uid, path);
-			} else {
-				ResourceUID::get_singleton()->add_id(fi->uid, path);
+		} else {
+			fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(path);
+			fi->uid = ResourceFormatImporter::get_singleton()->get_resource_uid(path);
+			fi->import_group_file = ResourceFormatImporter::get_singleton()->get_import_group_file(path);
+			p_file.read_script_class = true;
+			fi->modified_time = 0;
+			fi->import_modified_time = 0;
+			fi->import_valid = fi->type == "TextFile" ? true : ResourceLoader::is_import_valid(path);
+
+			p_file.test_reimport = true;
+		}
+	} else {
+		if (fc && fc->modification_time == mt) {
+			//not imported, so just update type if changed
+			fi->type = fc->type;
+			fi->resource_script_class = fc->resource_script_class;
+			fi->uid = fc->uid;
+			fi->modified_time = fc->modification_time;
+			fi->deps = fc->deps;
+			fi->import_modified_time = 0;
+			fi->import_valid = true;
+			fi->script_class_name = fc->script_class_name;
+			fi->script_class_extends = fc->script_class_extends;
+			fi->script_class_icon_path = fc->script_class_icon_path;
+		} else {
+			//new or modified time
+			fi->type = ResourceLoader::get_resource_type(path);
+			fi->resource_script_class = ResourceLoader::get_resource_script_class(path);
+			if (fi->type == "" && textfile_extensions.has(p_file.ext)) {
+				fi->type = "TextFile";
 			}
+			fi->uid = ResourceLoader::get_resource_uid(path);
+			p_file.read_script_class = true;
+			fi->deps = _get_dependencies(path);
+			fi->modified_time = mt;
+			fi->import_modified_time = 0;
+			fi->import_valid = true;
+
+			p_file.update_script_class = ClassDB::is_parent_class(fi->type, SNAME("Script"));
 		}
+	}
 
-		p_dir->files.push_back(fi);
-		p_progress.update(idx, total);
+	// Registered right away, so files scanned next can already resolve references to this one.
+	if (fi->uid != ResourceUID::INVALID_ID) {
+		MutexLock lock(scanned_uid_mutex);
+		if (ResourceUID::get_singleton()->has_id(fi->uid)) {
+			ResourceUID::get_singleton()->set_id(fi->uid, path);
+		} else {
+			ResourceUID::get_singleton()->add_id(fi->uid, path);
+		}
 	}
 }
 
@@ -227,7 +227,28 @@ class EditorFileSystem : public Node {
 	HashSet<String> valid_extensions;
 	HashSet<String> import_extensions;
 
+	// A file found while scanning a new directory, scanned in parallel with the others.
+	struct ScannedFile {
+		EditorFileSystemDirectory *dir = nullptr;
+		EditorFileSystemDirectory::FileInfo *info = nullptr;
+		String path;
+		String ext;
+		bool serial = false; // Must be scanned on the scanning thread.
+		bool read_script_class = false;
+		bool update_script_class = false;
+		bool test_reimport = false;
+	};
+
+	enum {
+		SCAN_FILES_BATCH_SIZE = 1024, // Files scanned between two progress updates.
+	};
+
 	void _scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress);
+	void _scan_new_dir_tree(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, LocalVector<ScannedFile> &r_files);
+	void _scan_new_file_task(uint32_t p_index, ScannedFile *p_files);
+	void _scan_new_file(ScannedFile &p_file);
+
+	Mutex scanned_uid_mutex; // Checking whether a UID is known and registering it must not interleave.
 
 	Thread thread_sources;
 	bool scanning_changes = false;
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/zip_io.h"
@@ -211,6 +212,16 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
+	// Compressed data is only kept when it is actually smaller, already compressed formats are stored as is.
+	Vector<uint8_t> compressed_data;
+	if (pd->compress && p_data.size() > 0) {
+		compressed_data = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_FILE_COMPRESSED_MAGIC, pd->compression_mode, PACK_FILE_COMPRESSED_BLOCK_SIZE);
+		if (compressed_data.size() > 0 && compressed_data.size() < p_data.size()) {
+			sd.compressed = true;
+			sd.size = compressed_data.size();
+		}
+	}
+
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = pd->f;
 
@@ -224,7 +235,11 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	if (sd.compressed) {
+		ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1508,6 +1523,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = p_preset->get_pck_compression() != EditorExportPreset::PCK_COMPRESSION_NONE;
+	pd.compression_mode = p_preset->get_pck_compression() == EditorExportPreset::PCK_COMPRESSION_FASTLZ ? Compression::MODE_FASTLZ : Compression::MODE_ZSTD;
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
 
@@ -1558,8 +1575,13 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	bool has_compressed = false;
+	for (int i = 0; i < pd.file_ofs.size(); i++) {
+		has_compressed = has_compressed || pd.file_ofs[i].compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(has_compressed ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_UNCOMPRESSED);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1646,6 +1668,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -293,6 +293,15 @@ bool EditorExportPreset::get_enc_directory() const {
 	return enc_directory;
 }
 
+void EditorExportPreset::set_pck_compression(PckCompression p_compression) {
+	pck_compression = p_compression;
+	EditorExport::singleton->save_presets();
+}
+
+EditorExportPreset::PckCompression EditorExportPreset::get_pck_compression() const {
+	return pck_compression;
+}
+
 void EditorExportPreset::set_script_encryption_key(const String &p_key) {
 	script_key = p_key;
 	EditorExport::singleton->save_presets();
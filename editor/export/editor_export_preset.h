@@ -47,6 +47,12 @@ public:
 		EXPORT_CUSTOMIZED,
 	};
 
+	enum PckCompression {
+		PCK_COMPRESSION_NONE,
+		PCK_COMPRESSION_FASTLZ,
+		PCK_COMPRESSION_ZSTD,
+	};
+
 	enum FileExportMode {
 		MODE_FILE_NOT_CUSTOMIZED,
 		MODE_FILE_STRIP,
@@ -83,6 +89,8 @@ private:
 	bool enc_pck = false;
 	bool enc_directory = false;
 
+	PckCompression pck_compression = PCK_COMPRESSION_NONE;
+
 	String script_key;
 
 protected:
@@ -149,6 +157,9 @@ public:
 	void set_enc_directory(bool p_enabled);
 	bool get_enc_directory() const;
 
+	void set_pck_compression(PckCompression p_compression);
+	PckCompression get_pck_compression() const;
+
 	void set_script_encryption_key(const String &p_key);
 	String get_script_encryption_key() const;
 
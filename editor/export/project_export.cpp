@@ -307,6 +307,8 @@ void ProjectExportDialog::_edit_preset(int p_index) {
 		enc_ex_filters->set_text(enc_ex_filters_str);
 	}
 
+	pck_compression->select(current->get_pck_compression());
+
 	bool enc_pck_mode = current->get_enc_pck();
 	enc_pck->set_pressed(enc_pck_mode);
 
@@ -481,6 +483,19 @@ void ProjectExportDialog::_open_key_help_link() {
 	OS::get_singleton()->shell_open(vformat("%s/contributing/development/compiling/compiling_with_script_encryption_key.html", VERSION_DOCS_URL));
 }
 
+void ProjectExportDialog::_pck_compression_changed(int p_idx) {
+	if (updating) {
+		return;
+	}
+
+	Ref<EditorExportPreset> current = get_current_preset();
+	ERR_FAIL_COND(current.is_null());
+
+	current->set_pck_compression(EditorExportPreset::PckCompression(p_idx));
+
+	_update_current_preset();
+}
+
 void ProjectExportDialog::_enc_pck_changed(bool p_pressed) {
 	if (updating) {
 		return;
@@ -1238,6 +1253,13 @@ ProjectExportDialog::ProjectExportDialog() {
 			exclude_filters);
 	exclude_filters->connect("text_changed", callable_mp(this, &ProjectExportDialog::_filter_changed));
 
+	pck_compression = memnew(OptionButton);
+	pck_compression->add_item(TTR("None"));
+	pck_compression->add_item(TTR("Fast (FastLZ)"));
+	pck_compression->add_item(TTR("Small (Zstandard)"));
+	resources_vb->add_margin_child(TTR("PCK Compression:"), pck_compression);
+	pck_compression->connect("item_selected", callable_mp(this, &ProjectExportDialog::_pck_compression_changed));
+
 	// Feature tags.
 
 	VBoxContainer *feature_vb = memnew(VBoxContainer);
@@ -138,6 +138,9 @@ private:
 	LineEdit *enc_in_filters = nullptr;
 	LineEdit *enc_ex_filters = nullptr;
 
+	OptionButton *pck_compression = nullptr;
+	void _pck_compression_changed(int p_idx);
+
 	void _open_export_template_manager();
 
 	void _export_pck_zip();
@@ -35,6 +35,7 @@
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
+#include "scene/resources/packed_scene.h"
 #include "servers/audio_server.h"
 #include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
@@ -85,6 +86,13 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_CONTENTIONS);
+	BIND_ENUM_CONSTANT(SCENE_POOL_HITS);
+	BIND_ENUM_CONSTANT(SCENE_POOL_MISSES);
+	BIND_ENUM_CONSTANT(SCENE_POOL_NODES);
+	BIND_ENUM_CONSTANT(SCENE_POOL_MEMORY);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +141,13 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"resource_cache/hits",
+		"resource_cache/misses",
+		"resource_cache/contentions",
+		"scene_pool/hits",
+		"scene_pool/misses",
+		"scene_pool/nodes",
+		"scene_pool/memory",
 
 	};
 
@@ -207,6 +222,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case RESOURCE_CACHE_HITS:
+			return ResourceCache::get_hit_count();
+		case RESOURCE_CACHE_MISSES:
+			return ResourceCache::get_miss_count();
+		case RESOURCE_CACHE_CONTENTIONS:
+			return ResourceCache::get_contention_count();
+		case SCENE_POOL_HITS:
+			return SceneState::get_pool_hit_count();
+		case SCENE_POOL_MISSES:
+			return SceneState::get_pool_miss_count();
+		case SCENE_POOL_NODES:
+			return SceneState::get_pooled_node_count();
+		case SCENE_POOL_MEMORY:
+			return SceneState::get_pooled_memory();
 
 		default: {
 		}
@@ -252,6 +281,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
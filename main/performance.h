@@ -100,6 +100,13 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		RESOURCE_CACHE_HITS,
+		RESOURCE_CACHE_MISSES,
+		RESOURCE_CACHE_CONTENTIONS,
+		SCENE_POOL_HITS,
+		SCENE_POOL_MISSES,
+		SCENE_POOL_NODES,
+		SCENE_POOL_MEMORY,
 		MONITOR_MAX
 	};
 
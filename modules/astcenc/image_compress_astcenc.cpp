@@ -30,12 +30,60 @@
 
 #include "image_compress_astcenc.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 #include <astcenc.h>
 
+// Images smaller than this are compressed on the calling thread.
+#define ASTCENC_THREADED_MIN_PIXELS (512 * 512)
+
+// Worker threads taken by the images being compressed at the same time. When there are threads left
+// (e.g. a single large texture being imported), an image uses a multithreaded context.
+static SafeNumeric<uint32_t> astcenc_reserved_threads;
+
+struct ASTCEncThreadReservation {
+	uint32_t threads = 1;
+	uint32_t reserved = 0;
+
+	ASTCEncThreadReservation(uint32_t p_pool_threads) {
+		// Taken in a single step, so images starting at the same time never count the same threads as free.
+		uint32_t used = astcenc_reserved_threads.postadd(p_pool_threads);
+		reserved = used < p_pool_threads ? p_pool_threads - used : 0;
+		astcenc_reserved_threads.sub(p_pool_threads - reserved);
+		threads = MAX(1u, reserved);
+	}
+
+	~ASTCEncThreadReservation() {
+		if (reserved) {
+			astcenc_reserved_threads.sub(reserved);
+		}
+	}
+};
+
+struct ASTCEncCompressImage {
+	astcenc_context *context = nullptr;
+	astcenc_image *image = nullptr;
+	const astcenc_swizzle *swizzle = nullptr;
+	uint8_t *dest = nullptr;
+	size_t dest_len = 0;
+	astcenc_error *status = nullptr; // One per thread.
+};
+
+static void _compress_astc_thread(void *p_userdata, uint32_t p_index) {
+	// Each thread of the context joins the compression of the same image with its own index.
+	ASTCEncCompressImage *compress = (ASTCEncCompressImage *)p_userdata;
+	compress->status[p_index] = astcenc_compress_image(compress->context, compress->image, compress->swizzle, compress->dest, compress->dest_len, p_index);
+}
+
 void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
+	_compress_astc_with_threads(r_img, p_format, -1);
+}
+
+void _compress_astc_with_threads(Image *r_img, Image::ASTCFormat p_format, int p_max_threads) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
 	// TODO: See how to handle lossy quality.
@@ -114,8 +162,19 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 
 	// Context allocation.
 
+	// Godot compresses multiple images each on a thread, which is more efficient for large amount of images imported.
+	// Only split the work of a single image when there are threads left.
+	uint32_t pool_threads = 0;
+	if (p_max_threads < 0 && width * height >= ASTCENC_THREADED_MIN_PIXELS && WorkerThreadPool::get_singleton()) {
+		pool_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	}
+	ASTCEncThreadReservation reservation(pool_threads);
+	unsigned int thread_count = reservation.threads;
+	if (p_max_threads > 0 && WorkerThreadPool::get_singleton()) {
+		thread_count = p_max_threads;
+	}
+
 	astcenc_context *context;
-	const unsigned int thread_count = 1; // Godot compresses multiple images each on a thread, which is more efficient for large amount of images imported.
 	status = astcenc_context_alloc(&config, thread_count, &context);
 	ERR_FAIL_COND_MSG(status != ASTCENC_SUCCESS,
 			vformat("astcenc: Context allocation failed: %s.", astcenc_get_error_string(status)));
@@ -156,7 +215,31 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 			ASTCENC_SWZ_R, ASTCENC_SWZ_G, ASTCENC_SWZ_B, ASTCENC_SWZ_A
 		};
 
-		status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		if (thread_count > 1) {
+			LocalVector<astcenc_error> thread_status;
+			thread_status.resize(thread_count);
+
+			ASTCEncCompressImage compress;
+			compress.context = context;
+			compress.image = &image;
+			compress.swizzle = &swizzle;
+			compress.dest = dest_mip_write;
+			compress.dest_len = comp_len;
+			compress.status = thread_status.ptr();
+
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_astc_thread, &compress, thread_count, thread_count, true, SNAME("ASTCEncCompressImage"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+			status = ASTCENC_SUCCESS;
+			for (astcenc_error thread_error : thread_status) {
+				if (thread_error != ASTCENC_SUCCESS) {
+					status = thread_error;
+					break;
+				}
+			}
+		} else {
+			status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		}
 
 		ERR_BREAK_MSG(status != ASTCENC_SUCCESS,
 				vformat("astcenc: ASTC image compression failed: %s.", astcenc_get_error_string(status)));
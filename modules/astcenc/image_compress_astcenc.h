@@ -34,6 +34,7 @@
 #include "core/io/image.h"
 
 void _compress_astc(Image *r_img, Image::ASTCFormat p_format);
+void _compress_astc_with_threads(Image *r_img, Image::ASTCFormat p_format, int p_max_threads); // Uses the worker threads left by other compressions when p_max_threads is negative.
 void _decompress_astc(Image *r_img);
 
 #endif // IMAGE_COMPRESS_ASTCENC_H
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  test_image_compress_astcenc.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_IMAGE_COMPRESS_ASTCENC_H
+#define TEST_IMAGE_COMPRESS_ASTCENC_H
+
+#include "../image_compress_astcenc.h"
+
+#include "tests/test_macros.h"
+
+namespace TestImageCompressASTCEnc {
+
+TEST_CASE("[Modules][ASTCEnc] Images split across threads compress like on a single thread") {
+	Vector<uint8_t> data;
+	data.resize(64 * 64 * 4);
+	for (int y = 0; y < 64; y++) {
+		for (int x = 0; x < 64; x++) {
+			uint8_t *pixel = data.ptrw() + (y * 64 + x) * 4;
+			pixel[0] = (x * 37 + y * 91) & 255;
+			pixel[1] = (x * y) & 255;
+			pixel[2] = (x ^ y) & 255;
+			pixel[3] = (x * 3 + y * 5) & 255;
+		}
+	}
+	Ref<Image> source = Image::create_from_data(64, 64, false, Image::FORMAT_RGBA8, data);
+	source->generate_mipmaps();
+
+	for (Image::ASTCFormat format : { Image::ASTC_FORMAT_4x4, Image::ASTC_FORMAT_8x8 }) {
+		Ref<Image> serial = source->duplicate();
+		Ref<Image> parallel = source->duplicate();
+		_compress_astc_with_threads(serial.ptr(), format, 1);
+		_compress_astc_with_threads(parallel.ptr(), format, 4);
+
+		REQUIRE(serial->is_compressed());
+		CHECK(parallel->get_format() == serial->get_format());
+		CHECK(parallel->get_mipmap_count() == serial->get_mipmap_count());
+		CHECK_MESSAGE(parallel->get_data() == serial->get_data(), "Compressing on several threads should give the same data, bit for bit, for format ", Image::get_format_name(serial->get_format()), ".");
+	}
+}
+
+} // namespace TestImageCompressASTCEnc
+
+#endif // TEST_IMAGE_COMPRESS_ASTCENC_H
@@ -30,12 +30,80 @@
 
 #include "image_compress_etcpak.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/safe_refcount.h"
 
 #include <ProcessDxtc.hpp>
 #include <ProcessRGB.hpp>
 
+// Images smaller than this are compressed on the calling thread.
+#define ETCPAK_THREADED_MIN_PIXELS (512 * 512)
+
+// Worker threads taken by the images being compressed at the same time. When there are threads left
+// (e.g. a single large texture being imported), an image is split across them.
+static SafeNumeric<uint32_t> etcpak_reserved_threads;
+
+struct EtcpakThreadReservation {
+	uint32_t threads = 1;
+	uint32_t reserved = 0;
+
+	EtcpakThreadReservation(uint32_t p_pool_threads) {
+		// Taken in a single step, so images starting at the same time never count the same threads as free.
+		uint32_t used = etcpak_reserved_threads.postadd(p_pool_threads);
+		reserved = used < p_pool_threads ? p_pool_threads - used : 0;
+		etcpak_reserved_threads.sub(p_pool_threads - reserved);
+		threads = MAX(1u, reserved);
+	}
+
+	~EtcpakThreadReservation() {
+		if (reserved) {
+			etcpak_reserved_threads.sub(reserved);
+		}
+	}
+};
+
+struct EtcpakCompressRows {
+	EtcpakType type = EtcpakType::ETCPAK_TYPE_ETC1;
+	const uint32_t *src = nullptr;
+	uint64_t *dest = nullptr;
+	int width = 0; // In pixels, multiple of 4.
+	int block_rows = 0;
+	int block_rows_per_task = 0;
+	int dest_words_per_block = 1;
+};
+
+static void _compress_etcpak_blocks(EtcpakType p_compresstype, const uint32_t *p_src, uint64_t *p_dest, uint32_t p_blocks, int p_width) {
+	if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
+		CompressEtc1RgbDither(p_src, p_dest, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2) {
+		CompressEtc2Rgb(p_src, p_dest, p_blocks, p_width, true);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
+		CompressEtc2Rgba(p_src, p_dest, p_blocks, p_width, true);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
+		CompressDxt1Dither(p_src, p_dest, p_blocks, p_width);
+	} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
+		CompressDxt5(p_src, p_dest, p_blocks, p_width);
+	}
+}
+
+static void _compress_etcpak_rows(void *p_userdata, uint32_t p_index) {
+	const EtcpakCompressRows *rows = (const EtcpakCompressRows *)p_userdata;
+
+	// etcpak reads blocks row by row, so a range of block rows is a contiguous range of blocks.
+	int from = p_index * rows->block_rows_per_task;
+	int count = MIN(rows->block_rows_per_task, rows->block_rows - from);
+	if (count <= 0) {
+		return;
+	}
+
+	int blocks_per_row = rows->width / 4;
+	const uint32_t *src = rows->src + (size_t)from * 4 * rows->width;
+	uint64_t *dest = rows->dest + (size_t)from * blocks_per_row * rows->dest_words_per_block;
+	_compress_etcpak_blocks(rows->type, src, dest, count * blocks_per_row, rows->width);
+}
+
 EtcpakType _determine_etc_type(Image::UsedChannels p_channels) {
 	switch (p_channels) {
 		case Image::USED_CHANNELS_L:
@@ -88,7 +156,7 @@ void _compress_bc(Image *r_img, Image::UsedChannels p_channels) {
 	_compress_etcpak(type, r_img);
 }
 
-void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
+void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, int p_max_threads) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
 	Image::Format img_format = r_img->get_format();
@@ -179,6 +247,12 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 	int mip_count = mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
 	Vector<uint32_t> padded_src;
 
+	uint32_t pool_threads = 0;
+	if (p_max_threads < 0 && width * height >= ETCPAK_THREADED_MIN_PIXELS && WorkerThreadPool::get_singleton()) {
+		pool_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	}
+	EtcpakThreadReservation reservation(pool_threads);
+
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
 		int orig_mip_w, orig_mip_h;
@@ -219,18 +293,32 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 			// Override the src_mip_read pointer to our temporary Vector.
 			src_mip_read = padded_src.ptr();
 		}
-		if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
-			CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2) {
-			CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
-			CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
-			CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
-			CompressDxt5(src_mip_read, dest_mip_write, blocks, mip_w);
+
+		int tasks = 1;
+		if (p_max_threads > 0 && WorkerThreadPool::get_singleton()) {
+			tasks = p_max_threads;
+		} else if (mip_w * mip_h >= ETCPAK_THREADED_MIN_PIXELS) {
+			tasks = reservation.threads;
+		}
+
+		if (tasks > 1) {
+			EtcpakCompressRows rows;
+			rows.type = p_compresstype;
+			rows.src = src_mip_read;
+			rows.dest = dest_mip_write;
+			rows.width = mip_w;
+			rows.block_rows = mip_h / 4;
+			rows.dest_words_per_block = (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) ? 2 : 1;
+
+			// Use more elements than tasks, so threads that finish early can pick up more rows.
+			int elements = MIN(rows.block_rows, tasks * 4);
+			rows.block_rows_per_task = (rows.block_rows + elements - 1) / elements;
+			elements = (rows.block_rows + rows.block_rows_per_task - 1) / rows.block_rows_per_task;
+
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_etcpak_rows, &rows, elements, tasks, true, SNAME("EtcpakCompressRows"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+			_compress_etcpak_blocks(p_compresstype, src_mip_read, dest_mip_write, blocks, mip_w);
 		}
 	}
 
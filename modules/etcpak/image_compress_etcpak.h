@@ -47,6 +47,6 @@ void _compress_etc1(Image *r_img);
 void _compress_etc2(Image *r_img, Image::UsedChannels p_channels);
 void _compress_bc(Image *r_img, Image::UsedChannels p_channels);
 
-void _compress_etcpak(EtcpakType p_compresstype, Image *r_img);
+void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, int p_max_threads = -1); // Uses the worker threads left by other compressions when p_max_threads is negative.
 
 #endif // IMAGE_COMPRESS_ETCPAK_H
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  test_image_compress_etcpak.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_IMAGE_COMPRESS_ETCPAK_H
+#define TEST_IMAGE_COMPRESS_ETCPAK_H
+
+#include "../image_compress_etcpak.h"
+
+#include "tests/test_macros.h"
+
+namespace TestImageCompressEtcpak {
+
+static Ref<Image> create_test_image(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size * p_size * 4);
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			uint8_t *pixel = data.ptrw() + (y * p_size + x) * 4;
+			pixel[0] = (x * 37 + y * 91) & 255;
+			pixel[1] = (x * y) & 255;
+			pixel[2] = (x ^ y) & 255;
+			pixel[3] = (x * 3 + y * 5) & 255;
+		}
+	}
+	Ref<Image> image = Image::create_from_data(p_size, p_size, false, Image::FORMAT_RGBA8, data);
+	image->generate_mipmaps();
+	return image;
+}
+
+TEST_CASE("[Modules][Etcpak] Images split across threads compress like on a single thread") {
+	const EtcpakType types[] = { EtcpakType::ETCPAK_TYPE_ETC1, EtcpakType::ETCPAK_TYPE_ETC2, EtcpakType::ETCPAK_TYPE_ETC2_ALPHA, EtcpakType::ETCPAK_TYPE_DXT1, EtcpakType::ETCPAK_TYPE_DXT5 };
+	for (EtcpakType type : types) {
+		Ref<Image> serial = create_test_image(256);
+		Ref<Image> parallel = serial->duplicate();
+		_compress_etcpak(type, serial.ptr(), 1);
+		_compress_etcpak(type, parallel.ptr(), 4);
+
+		REQUIRE(serial->is_compressed());
+		CHECK(parallel->get_format() == serial->get_format());
+		CHECK(parallel->get_mipmap_count() == serial->get_mipmap_count());
+		CHECK_MESSAGE(parallel->get_data() == serial->get_data(), "Compressing on several threads should give the same data, bit for bit, for format ", Image::get_format_name(serial->get_format()), ".");
+	}
+}
+
+} // namespace TestImageCompressEtcpak
+
+#endif // TEST_IMAGE_COMPRESS_ETCPAK_H
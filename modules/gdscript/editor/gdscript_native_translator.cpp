@@ -0,0 +1,905 @@
+/**************************************************************************/
+/*  gdscript_native_translator.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_translator.h"
+
+#include "../gdscript_native_registry.h"
+
+bool GDScriptNativeTranslator::_get_type(const GDScriptParser::DataType &p_datatype, bool p_allow_void, Type &r_type) {
+	if (!p_datatype.is_hard_type() || p_datatype.kind != GDScriptParser::DataType::BUILTIN) {
+		return false;
+	}
+	switch (p_datatype.builtin_type) {
+		case Variant::NIL:
+			r_type = TYPE_VOID;
+			return p_allow_void;
+		case Variant::BOOL:
+			r_type = TYPE_BOOL;
+			return true;
+		case Variant::INT:
+			r_type = TYPE_INT;
+			return true;
+		case Variant::FLOAT:
+			r_type = TYPE_FLOAT;
+			return true;
+		default:
+			return false;
+	}
+}
+
+String GDScriptNativeTranslator::_get_type_name(Type p_type) {
+	switch (p_type) {
+		case TYPE_VOID:
+			return "void";
+		case TYPE_BOOL:
+			return "bool";
+		case TYPE_INT:
+			return "int64_t";
+		case TYPE_FLOAT:
+			return "double";
+	}
+	return String();
+}
+
+String GDScriptNativeTranslator::_get_default_value(Type p_type) {
+	switch (p_type) {
+		case TYPE_BOOL:
+			return "false";
+		case TYPE_INT:
+			return "int64_t(0)";
+		case TYPE_FLOAT:
+			return "0.0";
+		case TYPE_VOID:
+			break;
+	}
+	return String();
+}
+
+String GDScriptNativeTranslator::_make_identifier(const String &p_name) {
+	String ret;
+	for (int i = 0; i < p_name.length(); i++) {
+		const char32_t c = p_name[i];
+		if (is_ascii_alphanumeric_char(c) || c == '_') {
+			ret += c;
+		} else {
+			ret += "_u" + String::num_int64(c, 16) + "_";
+		}
+	}
+	return ret;
+}
+
+String GDScriptNativeTranslator::_make_string_literal(const String &p_string) {
+	// Octal escapes for everything that isn't plain ASCII, they can't run into the next character.
+	const CharString utf8 = p_string.utf8();
+	String ret = "\"";
+	for (int i = 0; i < utf8.length(); i++) {
+		const uint8_t c = utf8[i];
+		if (c >= 0x20 && c < 0x7f && c != '"' && c != '\\' && c != '?') {
+			ret += c;
+		} else {
+			ret += "\\" + itos(c >> 6) + itos((c >> 3) & 7) + itos(c & 7);
+		}
+	}
+	return ret + "\"";
+}
+
+String GDScriptNativeTranslator::_make_literal(const Variant &p_value, Type &r_type) {
+	switch (p_value.get_type()) {
+		case Variant::BOOL:
+			r_type = TYPE_BOOL;
+			return bool(p_value) ? "true" : "false";
+		case Variant::INT: {
+			r_type = TYPE_INT;
+			const int64_t value = p_value;
+			if (value == INT64_MIN) {
+				return "INT64_MIN";
+			}
+			return "int64_t(" + itos(value) + ")";
+		}
+		case Variant::FLOAT: {
+			r_type = TYPE_FLOAT;
+			const double value = p_value;
+			if (Math::is_nan(value)) {
+				return "double(NAN)";
+			}
+			if (Math::is_inf(value)) {
+				return value > 0 ? "double(INFINITY)" : "(-double(INFINITY))";
+			}
+			// Enough digits to read back the same double.
+			char buffer[64];
+			snprintf(buffer, sizeof(buffer), "%.17g", value);
+			String ret = buffer;
+			if (!ret.contains(".") && !ret.contains("e")) {
+				ret += ".0";
+			}
+			return value < 0 ? "(" + ret + ")" : ret;
+		}
+		default:
+			r_type = TYPE_VOID;
+			return String();
+	}
+}
+
+String GDScriptNativeTranslator::_convert(const String &p_code, Type p_from, Type p_to) {
+	if (p_from == p_to) {
+		return p_code;
+	}
+	// Same as the Variant constructors.
+	switch (p_to) {
+		case TYPE_BOOL:
+			return "(" + p_code + " != 0)";
+		case TYPE_INT:
+			return "int64_t(" + p_code + ")";
+		case TYPE_FLOAT:
+			return "double(" + p_code + ")";
+		case TYPE_VOID:
+			break;
+	}
+	return p_code;
+}
+
+String GDScriptNativeTranslator::_indent(int p_level) {
+	return String("\t").repeat(p_level);
+}
+
+const GDScriptNativeTranslator::Local *GDScriptNativeTranslator::_get_local(const StringName &p_name) const {
+	for (int i = int(scopes.size()) - 1; i >= 0; i--) {
+		const Local *local = scopes[i].getptr(p_name);
+		if (local) {
+			return local;
+		}
+	}
+	return nullptr;
+}
+
+void GDScriptNativeTranslator::_add_local(const StringName &p_name, const String &p_cpp_name, Type p_type) {
+	Local local;
+	local.name = p_cpp_name;
+	local.type = p_type;
+	scopes[scopes.size() - 1].insert(p_name, local);
+}
+
+bool GDScriptNativeTranslator::_can_reach(const StringName &p_from, const StringName &p_to, HashSet<StringName> &r_visited) const {
+	const Function *function = functions.getptr(p_from);
+	if (!function) {
+		return false;
+	}
+	for (const StringName &callee : function->callees) {
+		if (callee == p_to) {
+			return true;
+		}
+		if (r_visited.has(callee)) {
+			continue;
+		}
+		r_visited.insert(callee);
+		if (_can_reach(callee, p_to, r_visited)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool _is_non_zero_int_constant(const GDScriptParser::ExpressionNode *p_expression) {
+	return p_expression && p_expression->is_constant && p_expression->reduced_value.get_type() == Variant::INT && int64_t(p_expression->reduced_value) != 0;
+}
+
+bool GDScriptNativeTranslator::_translate_binary(Variant::Operator p_op, const String &p_left, Type p_left_type, const String &p_right, Type p_right_type, const GDScriptParser::ExpressionNode *p_right_node, String &r_code, Type &r_type) const {
+	const bool numeric = (p_left_type == TYPE_INT || p_left_type == TYPE_FLOAT) && (p_right_type == TYPE_INT || p_right_type == TYPE_FLOAT);
+	const bool ints = p_left_type == TYPE_INT && p_right_type == TYPE_INT;
+	// Mixing int and float gives a float, like Variant operators.
+	const Type promoted = ints ? TYPE_INT : TYPE_FLOAT;
+
+	const char *op = nullptr;
+	Type operand_type = promoted;
+	r_type = promoted;
+
+	switch (p_op) {
+		case Variant::OP_ADD:
+			op = "+";
+			break;
+		case Variant::OP_SUBTRACT:
+			op = "-";
+			break;
+		case Variant::OP_MULTIPLY:
+			op = "*";
+			break;
+		case Variant::OP_DIVIDE:
+			// Integer division by zero is a runtime error, only translated when it can't happen.
+			if (ints && !_is_non_zero_int_constant(p_right_node)) {
+				return false;
+			}
+			op = "/";
+			break;
+		case Variant::OP_MODULE:
+			// Not defined for floats, and a runtime error by zero.
+			if (!ints || !_is_non_zero_int_constant(p_right_node)) {
+				return false;
+			}
+			op = "%";
+			break;
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR:
+			if (!ints) {
+				return false;
+			}
+			op = p_op == Variant::OP_BIT_AND ? "&" : (p_op == Variant::OP_BIT_OR ? "|" : "^");
+			break;
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+			if (p_left_type == TYPE_BOOL && p_right_type == TYPE_BOOL) {
+				r_code = "(" + p_left + (p_op == Variant::OP_EQUAL ? " == " : " != ") + p_right + ")";
+				r_type = TYPE_BOOL;
+				return true;
+			}
+			op = p_op == Variant::OP_EQUAL ? "==" : "!=";
+			r_type = TYPE_BOOL;
+			break;
+		case Variant::OP_LESS:
+			op = "<";
+			r_type = TYPE_BOOL;
+			break;
+		case Variant::OP_LESS_EQUAL:
+			op = "<=";
+			r_type = TYPE_BOOL;
+			break;
+		case Variant::OP_GREATER:
+			op = ">";
+			r_type = TYPE_BOOL;
+			break;
+		case Variant::OP_GREATER_EQUAL:
+			op = ">=";
+			r_type = TYPE_BOOL;
+			break;
+		case Variant::OP_AND:
+		case Variant::OP_OR:
+			if (p_left_type == TYPE_VOID || p_right_type == TYPE_VOID) {
+				return false;
+			}
+			r_code = "(" + _convert(p_left, p_left_type, TYPE_BOOL) + (p_op == Variant::OP_AND ? " && " : " || ") + _convert(p_right, p_right_type, TYPE_BOOL) + ")";
+			r_type = TYPE_BOOL;
+			return true;
+		default:
+			return false;
+	}
+
+	if (!numeric) {
+		return false;
+	}
+	r_code = "(" + _convert(p_left, p_left_type, operand_type) + " " + op + " " + _convert(p_right, p_right_type, operand_type) + ")";
+	return true;
+}
+
+bool GDScriptNativeTranslator::_translate_call(const GDScriptParser::CallNode *p_call, String &r_code, Type &r_type) {
+	if (p_call->is_super || p_call->get_callee_type() != GDScriptParser::Node::IDENTIFIER) {
+		return false;
+	}
+
+	LocalVector<String> arguments;
+	LocalVector<Type> argument_types;
+	for (const GDScriptParser::ExpressionNode *argument : p_call->arguments) {
+		String code;
+		Type type;
+		if (!_translate_expression(argument, code, type) || type == TYPE_VOID) {
+			return false;
+		}
+		arguments.push_back(code);
+		argument_types.push_back(type);
+	}
+
+	// Resolved in the same order as the analyzer: constructors, utility functions, then methods.
+	const StringName &name = p_call->function_name;
+	const Variant::Type builtin_type = GDScriptParser::get_builtin_type(name);
+	if (builtin_type < Variant::VARIANT_MAX) {
+		if (arguments.size() != 1) {
+			return false;
+		}
+		switch (builtin_type) {
+			case Variant::BOOL:
+				r_type = TYPE_BOOL;
+				break;
+			case Variant::INT:
+				r_type = TYPE_INT;
+				break;
+			case Variant::FLOAT:
+				r_type = TYPE_FLOAT;
+				break;
+			default:
+				return false;
+		}
+		r_code = _convert(arguments[0], argument_types[0], r_type);
+		return true;
+	}
+
+	String function;
+	LocalVector<Type> parameter_types;
+
+	struct Utility {
+		const char *name;
+		const char *function;
+		int argument_count;
+		Type type;
+	};
+	static const Utility utilities[] = {
+		{ "sqrt", "Math::sqrt", 1, TYPE_FLOAT },
+		{ "sin", "Math::sin", 1, TYPE_FLOAT },
+		{ "cos", "Math::cos", 1, TYPE_FLOAT },
+		{ "floorf", "Math::floor", 1, TYPE_FLOAT },
+		{ "ceilf", "Math::ceil", 1, TYPE_FLOAT },
+		{ "absf", "Math::absd", 1, TYPE_FLOAT },
+		{ "absi", "ABS", 1, TYPE_INT },
+		{ "minf", "MIN", 2, TYPE_FLOAT },
+		{ "maxf", "MAX", 2, TYPE_FLOAT },
+		{ "mini", "MIN", 2, TYPE_INT },
+		{ "maxi", "MAX", 2, TYPE_INT },
+		{ "clampf", "CLAMP", 3, TYPE_FLOAT },
+		{ "clampi", "CLAMP", 3, TYPE_INT },
+	};
+
+	for (const Utility &utility : utilities) {
+		if (name == utility.name) {
+			function = utility.function;
+			parameter_types.resize(utility.argument_count);
+			for (Type &type : parameter_types) {
+				type = utility.type;
+			}
+			r_type = utility.type;
+			break;
+		}
+	}
+
+	if (function.is_empty()) {
+		const Function *callee = functions.getptr(name);
+		if (!callee) {
+			return false;
+		}
+		function = callee->name;
+		parameter_types = callee->parameter_types;
+		r_type = callee->return_type;
+		current->callees.insert(name);
+	}
+
+	if (arguments.size() != parameter_types.size()) {
+		return false;
+	}
+	r_code = function + "(";
+	for (uint32_t i = 0; i < arguments.size(); i++) {
+		// Only the conversions done without warnings when calling the bytecode.
+		if (argument_types[i] != parameter_types[i] && !(argument_types[i] == TYPE_INT && parameter_types[i] == TYPE_FLOAT)) {
+			return false;
+		}
+		if (i > 0) {
+			r_code += ", ";
+		}
+		r_code += _convert(arguments[i], argument_types[i], parameter_types[i]);
+	}
+	r_code += ")";
+	return true;
+}
+
+bool GDScriptNativeTranslator::_translate_expression(const GDScriptParser::ExpressionNode *p_expression, String &r_code, Type &r_type) {
+	if (p_expression->is_constant) {
+		r_code = _make_literal(p_expression->reduced_value, r_type);
+		return r_type != TYPE_VOID;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			switch (identifier->source) {
+				case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
+				case GDScriptParser::IdentifierNode::LOCAL_VARIABLE:
+				case GDScriptParser::IdentifierNode::LOCAL_ITERATOR:
+					break;
+				default:
+					return false;
+			}
+			const Local *local = _get_local(identifier->name);
+			if (!local) {
+				return false;
+			}
+			r_code = local->name;
+			r_type = local->type;
+			return true;
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary_op = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			String left, right;
+			Type left_type, right_type;
+			if (!_translate_expression(binary_op->left_operand, left, left_type) || !_translate_expression(binary_op->right_operand, right, right_type)) {
+				return false;
+			}
+			return _translate_binary(binary_op->variant_op, left, left_type, right, right_type, binary_op->right_operand, r_code, r_type);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary_op = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			String operand;
+			Type operand_type;
+			if (!_translate_expression(unary_op->operand, operand, operand_type) || operand_type == TYPE_VOID) {
+				return false;
+			}
+			switch (unary_op->operation) {
+				case GDScriptParser::UnaryOpNode::OP_POSITIVE:
+				case GDScriptParser::UnaryOpNode::OP_NEGATIVE:
+					if (operand_type == TYPE_BOOL) {
+						return false;
+					}
+					r_code = unary_op->operation == GDScriptParser::UnaryOpNode::OP_NEGATIVE ? "(-" + operand + ")" : operand;
+					r_type = operand_type;
+					return true;
+				case GDScriptParser::UnaryOpNode::OP_COMPLEMENT:
+					if (operand_type != TYPE_INT) {
+						return false;
+					}
+					r_code = "(~" + operand + ")";
+					r_type = TYPE_INT;
+					return true;
+				case GDScriptParser::UnaryOpNode::OP_LOGIC_NOT:
+					r_code = "(!" + _convert(operand, operand_type, TYPE_BOOL) + ")";
+					r_type = TYPE_BOOL;
+					return true;
+			}
+			return false;
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary_op = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			String condition, true_expr, false_expr;
+			Type condition_type, true_type, false_type;
+			if (!_translate_expression(ternary_op->condition, condition, condition_type) || condition_type == TYPE_VOID) {
+				return false;
+			}
+			if (!_translate_expression(ternary_op->true_expr, true_expr, true_type) || !_translate_expression(ternary_op->false_expr, false_expr, false_type)) {
+				return false;
+			}
+			// The result isn't converted to a common type, it keeps the type of the branch taken.
+			if (true_type != false_type || true_type == TYPE_VOID) {
+				return false;
+			}
+			r_code = "(" + _convert(condition, condition_type, TYPE_BOOL) + " ? " + true_expr + " : " + false_expr + ")";
+			r_type = true_type;
+			return true;
+		}
+		case GDScriptParser::Node::CALL:
+			return _translate_call(static_cast<const GDScriptParser::CallNode *>(p_expression), r_code, r_type);
+		default:
+			return false;
+	}
+}
+
+bool GDScriptNativeTranslator::_translate_for(const GDScriptParser::ForNode *p_for, int p_indent, String &r_code) {
+	String from = "int64_t(0)";
+	String to;
+	int64_t step = 1;
+
+	const GDScriptParser::ExpressionNode *list = p_for->list;
+	const GDScriptParser::CallNode *range_call = nullptr;
+	if (list->type == GDScriptParser::Node::CALL) {
+		const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(list);
+		if (!call->is_super && call->get_callee_type() == GDScriptParser::Node::IDENTIFIER && call->function_name == "range") {
+			range_call = call;
+		}
+	}
+
+	if (range_call) {
+		const int argument_count = range_call->arguments.size();
+		if (argument_count < 1 || argument_count > 3) {
+			return false;
+		}
+		String arguments[2];
+		for (int i = 0; i < MIN(argument_count, 2); i++) {
+			Type type;
+			if (!_translate_expression(range_call->arguments[i], arguments[i], type) || type != TYPE_INT) {
+				return false;
+			}
+		}
+		if (argument_count == 1) {
+			to = arguments[0];
+		} else {
+			from = arguments[0];
+			to = arguments[1];
+		}
+		if (argument_count == 3) {
+			// The direction of the loop depends on the sign of the step, and a zero step is a runtime error.
+			if (!_is_non_zero_int_constant(range_call->arguments[2])) {
+				return false;
+			}
+			step = range_call->arguments[2]->reduced_value;
+		}
+	} else {
+		// Iterating over an int counts from 0 to it.
+		Type type;
+		if (!_translate_expression(list, to, type) || type != TYPE_INT) {
+			return false;
+		}
+	}
+
+	const String index = itos(loop_count++);
+	const String counter = "it_" + index;
+	const String end = "to_" + index;
+	const String variable = "l_" + _make_identifier(p_for->variable->name);
+
+	// The bounds are evaluated once, and assigning the loop variable doesn't change the iteration.
+	r_code += _indent(p_indent) + "{\n";
+	r_code += _indent(p_indent + 1) + "const int64_t " + end + " = " + to + ";\n";
+	r_code += _indent(p_indent + 1) + "for (int64_t " + counter + " = " + from + "; " + counter + (step > 0 ? " < " : " > ") + end + "; " + counter + " += " + itos(step) + ") {\n";
+	r_code += _indent(p_indent + 2) + "[[maybe_unused]] int64_t " + variable + " = " + counter + ";\n";
+
+	scopes.push_back(HashMap<StringName, Local>());
+	_add_local(p_for->variable->name, variable, TYPE_INT);
+	const bool ok = _translate_suite(p_for->loop, p_indent + 2, r_code);
+	scopes.resize(scopes.size() - 1);
+	if (!ok) {
+		return false;
+	}
+
+	r_code += _indent(p_indent + 1) + "}\n";
+	r_code += _indent(p_indent) + "}\n";
+	return true;
+}
+
+bool GDScriptNativeTranslator::_translate_statement(const GDScriptParser::Node *p_statement, int p_indent, String &r_code) {
+	const String indent = _indent(p_indent);
+
+	switch (p_statement->type) {
+		case GDScriptParser::Node::VARIABLE: {
+			const GDScriptParser::VariableNode *variable = static_cast<const GDScriptParser::VariableNode *>(p_statement);
+			Type type;
+			if (!_get_type(variable->get_datatype(), false, type)) {
+				return false;
+			}
+			String value;
+			if (variable->initializer) {
+				Type value_type;
+				if (!_translate_expression(variable->initializer, value, value_type) || value_type == TYPE_VOID) {
+					return false;
+				}
+				value = _convert(value, value_type, type);
+			} else {
+				value = _get_default_value(type);
+			}
+			const String name = "l_" + _make_identifier(variable->identifier->name);
+			r_code += indent + "[[maybe_unused]] " + _get_type_name(type) + " " + name + " = " + value + ";\n";
+			_add_local(variable->identifier->name, name, type);
+			return true;
+		}
+		case GDScriptParser::Node::CONSTANT:
+		case GDScriptParser::Node::PASS:
+			// Uses of local constants are reduced to their value.
+			return true;
+		case GDScriptParser::Node::ASSIGNMENT: {
+			const GDScriptParser::AssignmentNode *assignment = static_cast<const GDScriptParser::AssignmentNode *>(p_statement);
+			if (assignment->assignee->type != GDScriptParser::Node::IDENTIFIER) {
+				return false;
+			}
+			String target;
+			Type target_type;
+			if (!_translate_expression(assignment->assignee, target, target_type)) {
+				return false;
+			}
+			String value;
+			Type value_type;
+			if (!_translate_expression(assignment->assigned_value, value, value_type) || value_type == TYPE_VOID) {
+				return false;
+			}
+			if (assignment->operation != GDScriptParser::AssignmentNode::OP_NONE) {
+				String result;
+				Type result_type;
+				if (!_translate_binary(assignment->variant_op, target, target_type, value, value_type, assignment->assigned_value, result, result_type)) {
+					return false;
+				}
+				value = result;
+				value_type = result_type;
+			}
+			r_code += indent + target + " = " + _convert(value, value_type, target_type) + ";\n";
+			return true;
+		}
+		case GDScriptParser::Node::IF: {
+			const GDScriptParser::IfNode *if_node = static_cast<const GDScriptParser::IfNode *>(p_statement);
+			String condition;
+			Type condition_type;
+			if (!_translate_expression(if_node->condition, condition, condition_type) || condition_type == TYPE_VOID) {
+				return false;
+			}
+			r_code += indent + "if (" + _convert(condition, condition_type, TYPE_BOOL) + ") {\n";
+			if (!_translate_suite(if_node->true_block, p_indent + 1, r_code)) {
+				return false;
+			}
+			if (if_node->false_block) {
+				r_code += indent + "} else {\n";
+				if (!_translate_suite(if_node->false_block, p_indent + 1, r_code)) {
+					return false;
+				}
+			}
+			r_code += indent + "}\n";
+			return true;
+		}
+		case GDScriptParser::Node::WHILE: {
+			const GDScriptParser::WhileNode *while_node = static_cast<const GDScriptParser::WhileNode *>(p_statement);
+			String condition;
+			Type condition_type;
+			if (!_translate_expression(while_node->condition, condition, condition_type) || condition_type == TYPE_VOID) {
+				return false;
+			}
+			r_code += indent + "while (" + _convert(condition, condition_type, TYPE_BOOL) + ") {\n";
+			if (!_translate_suite(while_node->loop, p_indent + 1, r_code)) {
+				return false;
+			}
+			r_code += indent + "}\n";
+			return true;
+		}
+		case GDScriptParser::Node::FOR:
+			return _translate_for(static_cast<const GDScriptParser::ForNode *>(p_statement), p_indent, r_code);
+		case GDScriptParser::Node::BREAK:
+			r_code += indent + "break;\n";
+			return true;
+		case GDScriptParser::Node::CONTINUE:
+			r_code += indent + "continue;\n";
+			return true;
+		case GDScriptParser::Node::RETURN: {
+			const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(p_statement);
+			if (current->return_type == TYPE_VOID) {
+				// Returning the result of a void call.
+				if (return_node->return_value && !_translate_statement(return_node->return_value, p_indent, r_code)) {
+					return false;
+				}
+				r_code += indent + "return;\n";
+				return true;
+			}
+			String value;
+			Type value_type;
+			if (!return_node->return_value || !_translate_expression(return_node->return_value, value, value_type) || value_type == TYPE_VOID) {
+				return false;
+			}
+			r_code += indent + "return " + _convert(value, value_type, current->return_type) + ";\n";
+			return true;
+		}
+		case GDScriptParser::Node::CALL: {
+			String call;
+			Type type;
+			if (!_translate_call(static_cast<const GDScriptParser::CallNode *>(p_statement), call, type)) {
+				return false;
+			}
+			r_code += indent + (type == TYPE_VOID ? "" : "(void)") + call + ";\n";
+			return true;
+		}
+		default:
+			// Anything else may need the VM, or raise errors only it reports.
+			return false;
+	}
+}
+
+bool GDScriptNativeTranslator::_translate_suite(const GDScriptParser::SuiteNode *p_suite, int p_indent, String &r_code) {
+	scopes.push_back(HashMap<StringName, Local>());
+	bool ok = true;
+	for (const GDScriptParser::Node *statement : p_suite->statements) {
+		if (!_translate_statement(statement, p_indent, r_code)) {
+			ok = false;
+			break;
+		}
+	}
+	scopes.resize(scopes.size() - 1);
+	return ok;
+}
+
+bool GDScriptNativeTranslator::_translate_function(Function &p_function) {
+	current = &p_function;
+	p_function.callees.clear();
+	loop_count = 0;
+
+	scopes.clear();
+	scopes.push_back(HashMap<StringName, Local>());
+	for (int i = 0; i < p_function.node->parameters.size(); i++) {
+		const StringName &name = p_function.node->parameters[i]->identifier->name;
+		_add_local(name, "p_" + _make_identifier(name), p_function.parameter_types[i]);
+	}
+
+	String body;
+	const bool ok = _translate_suite(p_function.node->body, 1, body);
+	scopes.clear();
+	current = nullptr;
+	if (!ok) {
+		return false;
+	}
+
+	p_function.code = _get_prototype(p_function) + " {\n" + body;
+	const Vector<GDScriptParser::Node *> &statements = p_function.node->body->statements;
+	if (p_function.return_type != TYPE_VOID && (statements.is_empty() || statements[statements.size() - 1]->type != GDScriptParser::Node::RETURN)) {
+		// The analyzer made sure every path returns, this only keeps the compiler quiet.
+		p_function.code += "\treturn " + _get_default_value(p_function.return_type) + ";\n";
+	}
+	p_function.code += "}\n";
+	return true;
+}
+
+String GDScriptNativeTranslator::_get_prototype(const Function &p_function) const {
+	String ret = _get_type_name(p_function.return_type) + " " + p_function.name + "(";
+	for (int i = 0; i < p_function.node->parameters.size(); i++) {
+		if (i > 0) {
+			ret += ", ";
+		}
+		ret += _get_type_name(p_function.parameter_types[i]) + " p_" + _make_identifier(p_function.node->parameters[i]->identifier->name);
+	}
+	return ret + ")";
+}
+
+Error GDScriptNativeTranslator::translate(const GDScriptParser *p_parser, const String &p_script_path, const String &p_source, Result &r_result) {
+	const GDScriptParser::ClassNode *root = p_parser->get_tree();
+	ERR_FAIL_NULL_V(root, ERR_INVALID_PARAMETER);
+
+	GDScriptNativeTranslator translator;
+
+	// Inner classes share the path of the script, their functions aren't translated.
+	for (const GDScriptParser::ClassNode::Member &member : root->members) {
+		if (member.type != GDScriptParser::ClassNode::Member::FUNCTION) {
+			continue;
+		}
+		const GDScriptParser::FunctionNode *node = member.function;
+		if (node->is_coroutine || node->return_type == nullptr || node->parameters.size() > GDScriptNativeRegistry::MAX_ARGUMENTS) {
+			continue;
+		}
+		const StringName &name = node->identifier->name;
+		if (name == SNAME("_init") || name == SNAME("_static_init")) {
+			continue;
+		}
+
+		Function function;
+		function.node = node;
+		function.name = "f_" + _make_identifier(name);
+		if (!_get_type(node->get_datatype(), true, function.return_type)) {
+			continue;
+		}
+		bool valid = true;
+		for (const GDScriptParser::ParameterNode *parameter : node->parameters) {
+			// Default arguments are left to the bytecode.
+			Type type;
+			if (parameter->initializer || !_get_type(parameter->get_datatype(), false, type)) {
+				valid = false;
+				break;
+			}
+			function.parameter_types.push_back(type);
+		}
+		if (valid) {
+			translator.functions.insert(name, function);
+		}
+	}
+
+	// A function can't be translated if one it calls isn't, so translate again until none is dropped.
+	while (true) {
+		LocalVector<StringName> dropped;
+		for (KeyValue<StringName, Function> &E : translator.functions) {
+			if (!translator._translate_function(E.value)) {
+				dropped.push_back(E.key);
+			}
+		}
+		if (dropped.is_empty()) {
+			// Recursion stays on the bytecode, which reports running out of stack as an error instead of crashing.
+			for (const KeyValue<StringName, Function> &E : translator.functions) {
+				HashSet<StringName> visited;
+				if (translator._can_reach(E.key, E.key, visited)) {
+					dropped.push_back(E.key);
+				}
+			}
+		}
+		if (dropped.is_empty()) {
+			break;
+		}
+		for (const StringName &name : dropped) {
+			translator.functions.erase(name);
+		}
+	}
+
+	if (translator.functions.is_empty()) {
+		return ERR_SKIP;
+	}
+
+	r_result.functions.clear();
+	r_result.register_function = get_register_function_name(p_script_path);
+
+	String code = "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	code += "#include \"modules/gdscript/gdscript_native_registry.h\"\n\n";
+	code += "#include \"core/math/math_funcs.h\"\n";
+	code += "#include \"core/object/class_db.h\"\n";
+	code += "#include \"core/variant/variant_internal.h\"\n\n";
+	code += "namespace {\n\n";
+
+	for (const KeyValue<StringName, Function> &E : translator.functions) {
+		code += translator._get_prototype(E.value) + ";\n";
+	}
+	code += "\n";
+
+	for (const KeyValue<StringName, Function> &E : translator.functions) {
+		code += E.value.code + "\n";
+	}
+
+	for (const KeyValue<StringName, Function> &E : translator.functions) {
+		const Function &function = E.value;
+		code += "void call_" + function.name.trim_prefix("f_") + "(const Variant **p_args, Variant &r_ret) {\n\t";
+		if (function.return_type != TYPE_VOID) {
+			code += "r_ret = ";
+		}
+		code += function.name + "(";
+		for (uint32_t i = 0; i < function.parameter_types.size(); i++) {
+			if (i > 0) {
+				code += ", ";
+			}
+			switch (function.parameter_types[i]) {
+				case TYPE_BOOL:
+					code += "*VariantInternal::get_bool(p_args[" + itos(i) + "])";
+					break;
+				case TYPE_INT:
+					code += "*VariantInternal::get_int(p_args[" + itos(i) + "])";
+					break;
+				case TYPE_FLOAT:
+					code += "*VariantInternal::get_float(p_args[" + itos(i) + "])";
+					break;
+				case TYPE_VOID:
+					break;
+			}
+		}
+		code += ");\n}\n\n";
+	}
+
+	code += "} // namespace\n\n";
+
+	const String path = _make_string_literal(p_script_path);
+	const uint32_t source_hash = p_source.hash();
+	code += "void " + r_result.register_function + "() {\n";
+	for (const KeyValue<StringName, Function> &E : translator.functions) {
+		code += "\tGDScriptNativeRegistry::register_function(String::utf8(" + path + "), String::utf8(" + _make_string_literal(E.key) + "), " + itos(source_hash) + "u, " + itos(E.value.parameter_types.size()) + ", &call_" + E.value.name.trim_prefix("f_") + ");\n";
+		r_result.functions.push_back(E.key);
+	}
+	code += "}\n";
+
+	r_result.code = code;
+	return OK;
+}
+
+String GDScriptNativeTranslator::get_register_function_name(const String &p_script_path) {
+	// Readable, with the hash of the path to keep it unique.
+	const String name = p_script_path.trim_prefix("res://");
+	String ret = "gdscript_native_register_";
+	for (int i = 0; i < name.length(); i++) {
+		ret += is_ascii_alphanumeric_char(name[i]) ? name[i] : '_';
+	}
+	return ret + "_" + String::num_uint64(p_script_path.hash(), 16);
+}
+
+String GDScriptNativeTranslator::make_register_all(const Vector<String> &p_register_functions) {
+	String code = "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	for (const String &function : p_register_functions) {
+		code += "void " + function + "();\n";
+	}
+	code += "\nvoid gdscript_native_register_all() {\n";
+	for (const String &function : p_register_functions) {
+		code += "\t" + function + "();\n";
+	}
+	code += "}\n";
+	return code;
+}
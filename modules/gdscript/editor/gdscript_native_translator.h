@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  gdscript_native_translator.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_TRANSLATOR_H
+#define GDSCRIPT_NATIVE_TRANSLATOR_H
+
+#include "../gdscript_parser.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Translates the functions of an analyzed script that only use int, float and
+// bool values to C++ functions registered in GDScriptNativeRegistry.
+//
+// Only functions of the main class whose parameters, locals and return value
+// are statically typed as such are translated, and only if everything they do
+// has the same result in C++: arithmetic, comparisons, `if`, `while`, `for`
+// over `range()`, some math utility functions and calls to other translated
+// functions. Everything else, including recursion and anything that can raise
+// a runtime error, keeps the function on the bytecode.
+class GDScriptNativeTranslator {
+public:
+	struct Result {
+		String code;
+		String register_function;
+		Vector<StringName> functions;
+	};
+
+private:
+	enum Type {
+		TYPE_VOID,
+		TYPE_BOOL,
+		TYPE_INT,
+		TYPE_FLOAT,
+	};
+
+	struct Local {
+		String name;
+		Type type = TYPE_VOID;
+	};
+
+	struct Function {
+		const GDScriptParser::FunctionNode *node = nullptr;
+		String name;
+		Type return_type = TYPE_VOID;
+		LocalVector<Type> parameter_types;
+		String code;
+		HashSet<StringName> callees;
+	};
+
+	HashMap<StringName, Function> functions;
+
+	// State of the function being translated.
+	Function *current = nullptr;
+	LocalVector<HashMap<StringName, Local>> scopes;
+	int loop_count = 0;
+
+	static bool _get_type(const GDScriptParser::DataType &p_datatype, bool p_allow_void, Type &r_type);
+	static String _get_type_name(Type p_type);
+	static String _get_default_value(Type p_type);
+	static String _make_identifier(const String &p_name);
+	static String _make_string_literal(const String &p_string);
+	static String _make_literal(const Variant &p_value, Type &r_type);
+	static String _convert(const String &p_code, Type p_from, Type p_to);
+	static String _indent(int p_level);
+
+	const Local *_get_local(const StringName &p_name) const;
+	void _add_local(const StringName &p_name, const String &p_cpp_name, Type p_type);
+
+	bool _can_reach(const StringName &p_from, const StringName &p_to, HashSet<StringName> &r_visited) const;
+
+	bool _translate_binary(Variant::Operator p_op, const String &p_left, Type p_left_type, const String &p_right, Type p_right_type, const GDScriptParser::ExpressionNode *p_right_node, String &r_code, Type &r_type) const;
+	bool _translate_call(const GDScriptParser::CallNode *p_call, String &r_code, Type &r_type);
+	bool _translate_expression(const GDScriptParser::ExpressionNode *p_expression, String &r_code, Type &r_type);
+	bool _translate_for(const GDScriptParser::ForNode *p_for, int p_indent, String &r_code);
+	bool _translate_statement(const GDScriptParser::Node *p_statement, int p_indent, String &r_code);
+	bool _translate_suite(const GDScriptParser::SuiteNode *p_suite, int p_indent, String &r_code);
+	bool _translate_function(Function &p_function);
+
+	String _get_prototype(const Function &p_function) const;
+
+public:
+	// Returns ERR_SKIP if no function of the script can be translated.
+	static Error translate(const GDScriptParser *p_parser, const String &p_script_path, const String &p_source, Result &r_result);
+	static String get_register_function_name(const String &p_script_path);
+	// Source of the `gdscript_native_register_all()` function calling the register functions of the translated scripts.
+	static String make_register_all(const Vector<String> &p_register_functions);
+};
+
+#endif // GDSCRIPT_NATIVE_TRANSLATOR_H
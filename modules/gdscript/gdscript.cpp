@@ -31,10 +31,14 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
+#include "gdscript_bytecode_optimizer.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_native_registry.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_warning.h"
 
 #ifdef TOOLS_ENABLED
@@ -655,6 +659,17 @@ String GDScript::_get_debug_path() const {
 	}
 }
 
+void GDScript::_bind_native_functions() {
+	// Only the functions of the main class are translated, inner classes share its path.
+	if (_owner || path.is_empty() || GDScriptNativeRegistry::is_empty()) {
+		return;
+	}
+	const uint32_t source_hash = source.hash();
+	for (KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		E.value->native_call = GDScriptNativeRegistry::get_function(path, E.key, source_hash, E.value->get_argument_count());
+	}
+}
+
 Error GDScript::_static_init() {
 	if (static_initializer) {
 		Callable::CallError call_err;
@@ -752,8 +767,48 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+
+	Vector<uint8_t> bytecode;
+	if (!has_instances && GDScriptCache::take_bytecode_buffer(path, bytecode)) {
+		// Up to date bytecode was found when this script was first requested.
+		if (GDScriptBytecodeCache::deserialize(this, bytecode) == OK) {
+			_bind_native_functions();
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			if (can_run) {
+				Error err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+
+			reloading = false;
+			return OK;
+		}
+		// Otherwise fall back to compiling it from source.
+	}
+
+	// Reuse the tree if the script was just parsed through the cache, as when
+	// loaded by GDScriptCache or parsed at startup, but not analyzed yet: its
+	// analysis could otherwise be underway higher up in this call stack.
+	Ref<GDScriptParserRef> parser_ref;
+	if (!path.is_empty()) {
+		parser_ref = GDScriptCache::get_cached_parser(path);
+		if (parser_ref.is_valid() && (parser_ref->get_status() != GDScriptParserRef::PARSED || parser_ref->get_source_hash() != source.hash())) {
+			parser_ref.unref();
+		}
+	}
+
+	GDScriptParser local_parser;
+	GDScriptParser &parser = parser_ref.is_valid() ? *parser_ref->get_parser() : local_parser;
+	Error err = OK;
+	if (parser_ref.is_valid()) {
+		// Parsing errors would have been kept by the parser.
+		err = parser.get_errors().is_empty() ? OK : ERR_PARSE_ERROR;
+	} else {
+		uint64_t phase_start = OS::get_singleton()->get_ticks_usec();
+		err = parser.parse(source, path, false);
+		GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_PARSE, OS::get_singleton()->get_ticks_usec() - phase_start);
+	}
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -764,8 +819,18 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+	if (parser_ref.is_valid()) {
+		// Timed by the parser ref itself.
+		err = parser_ref->raise_status(GDScriptParserRef::FULLY_SOLVED);
+		if (err == OK) {
+			err = parser_ref->get_analyzer()->resolve_dependencies();
+		}
+	} else {
+		GDScriptAnalyzer analyzer(&parser);
+		uint64_t phase_start = OS::get_singleton()->get_ticks_usec();
+		err = analyzer.analyze();
+		GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_ANALYZE, OS::get_singleton()->get_ticks_usec() - phase_start);
+	}
 
 	if (err) {
 		if (EngineDebugger::is_active()) {
@@ -784,7 +849,9 @@ Error GDScript::reload(bool p_keep_state) {
 	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
 	GDScriptCompiler compiler;
+	uint64_t phase_start = OS::get_singleton()->get_ticks_usec();
 	err = compiler.compile(&parser, this, p_keep_state);
+	GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_COMPILE, OS::get_singleton()->get_ticks_usec() - phase_start);
 
 	if (err) {
 		if (can_run) {
@@ -800,6 +867,12 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		GDScriptBytecodeCache::save(this);
+	}
+
+	_bind_native_functions();
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1501,6 +1574,9 @@ void GDScript::clear(ClearData *p_clear_data) {
 
 	// If it's not the root, skip clearing the data
 	if (is_root) {
+		// Functions may have cached what names resolved to in these scripts.
+		GDScriptFunction::invalidate_inline_caches();
+
 		// All dependencies have been accounted for
 		for (GDScriptFunction *E : clear_data->functions) {
 			memdelete(E);
@@ -2080,6 +2156,29 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	if (GLOBAL_GET("gdscript/loading/parallel_parse_at_startup") && !Engine::get_singleton()->is_editor_hint()) {
+		// Scripts of named classes and autoloads are the ones most likely to be loaded right away.
+		Vector<String> paths;
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		for (const StringName &class_name : global_classes) {
+			if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(class_name));
+			}
+		}
+		for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+			if (E.value.path.get_extension().to_lower() == get_extension()) {
+				paths.push_back(E.value.path);
+			}
+		}
+		GDScriptCache::parse_scripts(paths);
+	}
+
+	GDScriptSamplingProfiler::register_debugger_profiler();
+	if (GLOBAL_GET("gdscript/sampling_profiler/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSamplingProfiler::start(int(GLOBAL_GET("gdscript/sampling_profiler/interval_usec")));
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2099,6 +2198,13 @@ void GDScriptLanguage::finish() {
 		_call_stack = nullptr;
 	}
 
+	if (GDScriptSamplingProfiler::is_started() && GLOBAL_GET("gdscript/sampling_profiler/enabled")) {
+		GDScriptSamplingProfiler::stop();
+		GDScriptSamplingProfiler::save_collapsed_stacks(GLOBAL_GET("gdscript/sampling_profiler/output_path"));
+	}
+	GDScriptSamplingProfiler::unregister_debugger_profiler();
+	GDScriptSamplingProfiler::finish();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2389,6 +2495,13 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 void GDScriptLanguage::frame() {
 	calls = 0;
 
+	if (unlikely(!first_frame_done)) {
+		// Scripts needed to start are loaded by the first frame, the others may never be.
+		first_frame_done = true;
+		GDScriptCache::release_preparsed_scripts();
+		print_verbose("GDScript: Time spent loading scripts during startup: " + GDScriptCache::get_load_times_text() + ".");
+	}
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(this->mutex);
@@ -2640,6 +2753,14 @@ GDScriptLanguage::GDScriptLanguage() {
 		_call_stack = nullptr;
 	}
 
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", false);
+	GLOBAL_DEF("gdscript/bytecode_cache/path", "user://gdscript_cache");
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/optimizer/mode", PROPERTY_HINT_ENUM, "Disabled,Release Only,Always"), GDScriptBytecodeOptimizer::MODE_RELEASE_ONLY);
+	GLOBAL_DEF("gdscript/loading/parallel_parse_at_startup", false);
+	GLOBAL_DEF("gdscript/sampling_profiler/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "100,1000000,1"), GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC);
+	GLOBAL_DEF("gdscript/sampling_profiler/output_path", "user://gdscript_samples.txt");
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptDocGen;
 	friend class GDScriptLanguage;
 	friend struct GDScriptUtilityFunctionsDefinitions;
@@ -134,6 +135,7 @@ class GDScript : public Script {
 	GDScriptFunction *static_initializer = nullptr;
 
 	Error _static_init();
+	void _bind_native_functions();
 
 	int subclass_count = 0;
 	RBSet<Object *> instances;
@@ -387,6 +389,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	uint64_t script_frame_time;
 
 	HashMap<String, ObjectID> orphan_subclasses;
+	bool first_frame_done = false;
 
 public:
 	int calls;
@@ -5247,7 +5247,18 @@ Ref<GDScriptParserRef> GDScriptAnalyzer::get_parser_for(const String &p_path) {
 }
 
 Error GDScriptAnalyzer::resolve_inheritance() {
-	return resolve_class_inheritance(parser->head, true);
+	Error err = resolve_class_inheritance(parser->head, true);
+	if (err) {
+		return err;
+	}
+
+	// Apply annotations. Done here rather than in analyze() so scripts analyzed through GDScriptCache get them too.
+	for (GDScriptParser::AnnotationNode *&E : parser->head->annotations) {
+		resolve_annotation(E);
+		E->apply(parser, parser->head);
+	}
+
+	return OK;
 }
 
 Error GDScriptAnalyzer::resolve_interface() {
@@ -5280,12 +5291,6 @@ Error GDScriptAnalyzer::analyze() {
 		return err;
 	}
 
-	// Apply annotations.
-	for (GDScriptParser::AnnotationNode *&E : parser->head->annotations) {
-		resolve_annotation(E);
-		E->apply(parser, parser->head);
-	}
-
 	resolve_interface();
 	resolve_body();
 	if (!parser->errors.is_empty()) {
@@ -31,6 +31,7 @@
 #include "gdscript_byte_codegen.h"
 
 #include "gdscript.h"
+#include "gdscript_bytecode_optimizer.h"
 
 #include "core/debugger/engine_debugger.h"
 
@@ -153,7 +154,7 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
-		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
+		append_opcode(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
 	}
 }
@@ -199,6 +200,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (GDScriptBytecodeOptimizer::is_enabled()) {
+		GDScriptBytecodeOptimizer::optimize(opcodes, instructions, function->default_arguments);
+	}
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -404,6 +409,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->_stack_size = RESERVED_STACK + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
 	function->_ptrcall_args_size = ptrcall_max;
+	function->_init_inline_caches(inline_cache_count);
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -579,6 +585,40 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(p_operator);
 }
 
+// Arithmetic on ints and floats is common enough to be computed by the VM itself.
+// Comparisons are left to the validated evaluators, which the optimizer fuses with the jumps using them.
+static GDScriptFunction::Opcode _get_inline_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+	}
+	if (p_left_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -590,6 +630,15 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		GDScriptFunction::Opcode inline_opcode = _get_inline_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (inline_opcode != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			append_opcode(inline_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -748,9 +797,67 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Opcodes reading or writing an element of an array of a known type directly, without going through the indexed getters and setters.
+static bool _get_indexed_array_opcodes(Variant::Type p_type, GDScriptFunction::Opcode &r_get, GDScriptFunction::Opcode &r_set) {
+	switch (p_type) {
+		case Variant::ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_ARRAY;
+			return true;
+		case Variant::PACKED_BYTE_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY;
+			return true;
+		case Variant::PACKED_INT32_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY;
+			return true;
+		case Variant::PACKED_INT64_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY;
+			return true;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY;
+			return true;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY;
+			return true;
+		case Variant::PACKED_STRING_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_STRING_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_STRING_ARRAY;
+			return true;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY;
+			return true;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY;
+			return true;
+		case Variant::PACKED_COLOR_ARRAY:
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY;
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY;
+			return true;
+		default:
+			return false;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
+		GDScriptFunction::Opcode get_opcode;
+		GDScriptFunction::Opcode set_opcode;
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && _get_indexed_array_opcodes(p_target.type.builtin_type, get_opcode, set_opcode) &&
+				(p_target.type.builtin_type == Variant::ARRAY || IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type)))) {
+			// Generic arrays take any value, Array::set() still checks it against the element type of typed arrays.
+			append_opcode(set_opcode);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
 			Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(p_target.type.builtin_type);
@@ -779,7 +886,15 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
+		GDScriptFunction::Opcode get_opcode;
+		GDScriptFunction::Opcode set_opcode;
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && _get_indexed_array_opcodes(p_source.type.builtin_type, get_opcode, set_opcode)) {
+			append_opcode(get_opcode);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
 			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED);
@@ -821,6 +936,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -839,6 +955,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1024,6 +1141,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1049,6 +1167,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1116,6 +1235,30 @@ void GDScriptByteCodeGenerator::write_call_utility(const Address &p_target, cons
 }
 
 void GDScriptByteCodeGenerator::write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, bool p_is_static, const Vector<Address> &p_arguments) {
+	GDScriptFunction::Opcode get_opcode;
+	GDScriptFunction::Opcode set_opcode;
+	if (!p_is_static && _get_indexed_array_opcodes(p_type, get_opcode, set_opcode)) {
+		// Common array methods, done inline instead of through a method call.
+		if (p_arguments.is_empty() && p_method == SNAME("size")) {
+			CallTarget ct = get_call_target(p_target, Variant::INT);
+			append_opcode(GDScriptFunction::OPCODE_ARRAY_SIZE);
+			append(p_base);
+			append(ct.target);
+			ct.cleanup();
+			return;
+		}
+		if (p_arguments.size() == 1 && (p_method == SNAME("append") || p_method == SNAME("push_back")) &&
+				(p_type == Variant::ARRAY || IS_BUILTIN_TYPE(p_arguments[0], Variant::get_indexed_element_type(p_type)))) {
+			CallTarget ct = get_call_target(p_target, p_type == Variant::ARRAY ? Variant::NIL : Variant::BOOL);
+			append_opcode(GDScriptFunction::OPCODE_ARRAY_APPEND);
+			append(p_base);
+			append(p_arguments[0]);
+			append(ct.target);
+			ct.cleanup();
+			return;
+		}
+	}
+
 	bool is_validated = false;
 
 	// Check if all types are correct.
@@ -1297,6 +1440,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1310,11 +1454,12 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
 void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
-	append_opcode_and_argcount(p_target.mode == Address::NIL ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN, 2 + p_arguments.size());
+	append_opcode_and_argcount(GDScriptFunction::OPCODE_CALL_SCRIPT_FUNCTION, 2 + p_arguments.size());
 	for (int i = 0; i < p_arguments.size(); i++) {
 		append(p_arguments[i]);
 	}
@@ -1323,6 +1468,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1439,6 +1585,19 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 	append(p_target);
 }
 
+void GDScriptByteCodeGenerator::write_await_timer(const Address &p_target, const Address &p_tree, const Vector<Address> &p_arguments) {
+	// Delay, process_always, process_in_physics and ignore_time_scale.
+	ERR_FAIL_COND(p_arguments.size() != 4);
+
+	append_opcode(GDScriptFunction::OPCODE_AWAIT_TIMER);
+	append(p_tree);
+	for (int i = 0; i < p_arguments.size(); i++) {
+		append(p_arguments[i]);
+	}
+	append_opcode(GDScriptFunction::OPCODE_AWAIT_RESUME);
+	append(p_target);
+}
+
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
@@ -0,0 +1,1997 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/extension/gdextension_manager.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/version.h"
+
+static const uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+struct GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+
+	void put_bytes(const uint8_t *p_data, uint32_t p_size) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + p_size);
+		if (p_size > 0) {
+			memcpy(&data[ofs], p_data, p_size);
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + 4);
+		encode_uint32(p_value, &data[ofs]);
+	}
+
+	void put_u64(uint64_t p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + 8);
+		encode_uint64(p_value, &data[ofs]);
+	}
+
+	void put_string(const String &p_value) {
+		CharString utf8 = p_value.utf8();
+		put_u32(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void put_names(const Vector<StringName> &p_names) {
+		put_u32(p_names.size());
+		for (const StringName &name : p_names) {
+			put_string(name);
+		}
+	}
+
+	void put_strings(const Vector<String> &p_strings) {
+		put_u32(p_strings.size());
+		for (const String &string : p_strings) {
+			put_string(string);
+		}
+	}
+
+	void put_property_info(const PropertyInfo &p_info) {
+		put_u32(p_info.type);
+		put_string(p_info.name);
+		put_string(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+
+	bool put_plain_variant(const Variant &p_value) {
+		int len = 0;
+		if (encode_variant(p_value, nullptr, len) != OK) {
+			return false;
+		}
+		put_u32(len);
+		uint32_t ofs = data.size();
+		data.resize(ofs + len);
+		return encode_variant(p_value, &data[ofs], len) == OK;
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool error = false;
+
+	bool has(uint32_t p_bytes) {
+		if (error || p_bytes > size - position) {
+			error = true;
+			return false;
+		}
+		return true;
+	}
+
+	bool get_bytes(uint8_t *r_data, uint32_t p_size) {
+		if (!has(p_size)) {
+			return false;
+		}
+		memcpy(r_data, data + position, p_size);
+		position += p_size;
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[position++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(data + position);
+		position += 4;
+		return value;
+	}
+
+	uint64_t get_u64() {
+		if (!has(8)) {
+			return 0;
+		}
+		uint64_t value = decode_uint64(data + position);
+		position += 8;
+		return value;
+	}
+
+	// Every element takes at least one byte, so a count larger than what's
+	// left can only come from a corrupt file.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (!has(count)) {
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		uint32_t len = get_count();
+		if (error || len == 0) {
+			return String();
+		}
+		String string;
+		if (string.parse_utf8((const char *)data + position, len) != OK) {
+			error = true;
+			return String();
+		}
+		position += len;
+		return string;
+	}
+
+	StringName get_name() {
+		return get_string();
+	}
+
+	Vector<StringName> get_names() {
+		Vector<StringName> names;
+		names.resize(get_count());
+		for (int i = 0; i < names.size(); i++) {
+			names.write[i] = get_name();
+		}
+		return names;
+	}
+
+	Vector<String> get_strings() {
+		Vector<String> strings;
+		strings.resize(get_count());
+		for (int i = 0; i < strings.size(); i++) {
+			strings.write[i] = get_string();
+		}
+		return strings;
+	}
+
+	PropertyInfo get_property_info() {
+		PropertyInfo info;
+		info.type = Variant::Type(get_u32());
+		info.name = get_string();
+		info.class_name = get_name();
+		info.hint = PropertyHint(get_u32());
+		info.hint_string = get_string();
+		info.usage = get_u32();
+		if (info.type >= Variant::VARIANT_MAX) {
+			error = true;
+		}
+		return info;
+	}
+
+	bool get_plain_variant(Variant &r_value) {
+		uint32_t len = get_count();
+		if (error) {
+			return false;
+		}
+		int used = 0;
+		if (decode_variant(r_value, data + position, len, &used) != OK || uint32_t(used) != len) {
+			error = true;
+			return false;
+		}
+		position += len;
+		return true;
+	}
+
+	Reader(const Vector<uint8_t> &p_buffer) {
+		data = p_buffer.ptr();
+		size = p_buffer.size();
+	}
+};
+
+Mutex GDScriptBytecodeCache::mutex;
+GDScriptBytecodeCache::Symbols *GDScriptBytecodeCache::symbols = nullptr;
+HashMap<ObjectID, StringName> GDScriptBytecodeCache::global_objects;
+int GDScriptBytecodeCache::global_objects_size = -1;
+uint64_t GDScriptBytecodeCache::globals_fingerprint = 0;
+int GDScriptBytecodeCache::globals_fingerprint_size = -1;
+String GDScriptBytecodeCache::engine_fingerprint;
+
+template <class M, class K, class V>
+static void _add_symbol(M &p_map, K p_key, const V &p_symbol) {
+	// Different symbols can share an implementation, keeping the first one is
+	// enough since it resolves back to the same pointer.
+	if (p_key != nullptr && !p_map.has(p_key)) {
+		p_map.insert(p_key, p_symbol);
+	}
+}
+
+const GDScriptBytecodeCache::Symbols &GDScriptBytecodeCache::_get_symbols() {
+	MutexLock lock(mutex);
+
+	if (symbols) {
+		return *symbols;
+	}
+
+	symbols = memnew(Symbols);
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				OperatorSymbol symbol;
+				symbol.op = Variant::Operator(op);
+				symbol.left = type;
+				symbol.right = Variant::Type(j);
+				_add_symbol(symbols->operators, Variant::get_validated_operator_evaluator(symbol.op, symbol.left, symbol.right), symbol);
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			_add_symbol(symbols->setters, Variant::get_member_validated_setter(type, member), Pair<Variant::Type, StringName>(type, member));
+			_add_symbol(symbols->getters, Variant::get_member_validated_getter(type, member), Pair<Variant::Type, StringName>(type, member));
+		}
+
+		_add_symbol(symbols->keyed_setters, Variant::get_member_validated_keyed_setter(type), type);
+		_add_symbol(symbols->keyed_getters, Variant::get_member_validated_keyed_getter(type), type);
+		_add_symbol(symbols->indexed_setters, Variant::get_member_validated_indexed_setter(type), type);
+		_add_symbol(symbols->indexed_getters, Variant::get_member_validated_indexed_getter(type), type);
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			_add_symbol(symbols->builtin_methods, Variant::get_validated_builtin_method(type, method), Pair<Variant::Type, StringName>(type, method));
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			_add_symbol(symbols->constructors, Variant::get_validated_constructor(type, j), Pair<Variant::Type, int>(type, j));
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		_add_symbol(symbols->utilities, Variant::get_validated_utility_function(utility), utility);
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		_add_symbol(symbols->gds_utilities, GDScriptUtilityFunctions::get_function(utility), utility);
+	}
+
+	return *symbols;
+}
+
+StringName GDScriptBytecodeCache::_get_global_name(const Object *p_object) {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	MutexLock lock(mutex);
+
+	if (global_objects_size != language->get_global_array_size()) {
+		global_objects.clear();
+		const Variant *globals = language->get_global_array();
+		for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+			Object *object = globals[E.value].get_validated_object();
+			if (object) {
+				global_objects.insert(object->get_instance_id(), E.key);
+			}
+		}
+		global_objects_size = language->get_global_array_size();
+	}
+
+	const StringName *name = global_objects.getptr(p_object->get_instance_id());
+	return name ? *name : StringName();
+}
+
+uint64_t GDScriptBytecodeCache::_get_globals_fingerprint() {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	MutexLock lock(mutex);
+
+	// Global indices are baked in the bytecode, so any change in the global
+	// identifiers (e.g. a new autoload) invalidates every cached script.
+	if (globals_fingerprint_size != language->get_global_array_size()) {
+		uint64_t hash = hash_djb2_one_64(0);
+		for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+			hash = hash_djb2_one_64(String(E.key).hash64(), hash);
+			hash = hash_djb2_one_64(E.value, hash);
+		}
+		globals_fingerprint = hash;
+		globals_fingerprint_size = language->get_global_array_size();
+	}
+
+	return globals_fingerprint;
+}
+
+String GDScriptBytecodeCache::_get_engine_fingerprint() {
+	MutexLock lock(mutex);
+
+	if (!engine_fingerprint.is_empty()) {
+		return engine_fingerprint;
+	}
+
+	String fingerprint = String(VERSION_FULL_BUILD) + "." + VERSION_HASH;
+#ifdef DEBUG_ENABLED
+	fingerprint += ".debug";
+#endif
+#ifdef TOOLS_ENABLED
+	fingerprint += ".tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	fingerprint += ".double";
+#endif
+
+	// Method binds are resolved by name, but a different build of an extension
+	// can change what they take or return, so any change in them counts too.
+	GDExtensionManager *extension_manager = GDExtensionManager::get_singleton();
+	if (extension_manager) {
+		Vector<String> extensions = extension_manager->get_loaded_extensions();
+		extensions.sort();
+		for (const String &path : extensions) {
+			Ref<GDExtension> extension = extension_manager->get_extension(path);
+			String library_path = extension.is_valid() ? extension->get_library_path() : String();
+			fingerprint += "|" + path + ":" + FileAccess::get_md5(path);
+			if (!library_path.is_empty()) {
+				fingerprint += ":" + itos(FileAccess::get_modified_time(library_path));
+			}
+		}
+	}
+
+	engine_fingerprint = fingerprint;
+	return engine_fingerprint;
+}
+
+void GDScriptBytecodeCache::_update_function_pointers(GDScriptFunction *p_function) {
+	// Same as what GDScriptByteCodeGenerator::write_end() does.
+	p_function->_constants_ptr = p_function->constants.ptrw();
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_global_names_ptr = p_function->global_names.ptr();
+	p_function->_global_names_count = p_function->global_names.size();
+	p_function->_code_ptr = p_function->code.ptr();
+	p_function->_code_size = p_function->code.size();
+	p_function->_default_arg_ptr = p_function->default_arguments.ptr();
+	p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.ptr();
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_setters_ptr = p_function->setters.ptr();
+	p_function->_setters_count = p_function->setters.size();
+	p_function->_getters_ptr = p_function->getters.ptr();
+	p_function->_getters_count = p_function->getters.size();
+	p_function->_keyed_setters_ptr = p_function->keyed_setters.ptr();
+	p_function->_keyed_setters_count = p_function->keyed_setters.size();
+	p_function->_keyed_getters_ptr = p_function->keyed_getters.ptr();
+	p_function->_keyed_getters_count = p_function->keyed_getters.size();
+	p_function->_indexed_setters_ptr = p_function->indexed_setters.ptr();
+	p_function->_indexed_setters_count = p_function->indexed_setters.size();
+	p_function->_indexed_getters_ptr = p_function->indexed_getters.ptr();
+	p_function->_indexed_getters_count = p_function->indexed_getters.size();
+	p_function->_builtin_methods_ptr = p_function->builtin_methods.ptr();
+	p_function->_builtin_methods_count = p_function->builtin_methods.size();
+	p_function->_constructors_ptr = p_function->constructors.ptr();
+	p_function->_constructors_count = p_function->constructors.size();
+	p_function->_utilities_ptr = p_function->utilities.ptr();
+	p_function->_utilities_count = p_function->utilities.size();
+	p_function->_gds_utilities_ptr = p_function->gds_utilities.ptr();
+	p_function->_gds_utilities_count = p_function->gds_utilities.size();
+	p_function->_methods_ptr = p_function->methods.ptrw();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_lambdas_ptr = p_function->lambdas.ptrw();
+	p_function->_lambdas_count = p_function->lambdas.size();
+}
+
+bool GDScriptBytecodeCache::_validate_function(const GDScriptFunction *p_function, int p_member_count) {
+	typedef GDScriptFunction F;
+
+	const int *code = p_function->code.ptr();
+	const int code_size = p_function->code.size();
+	const int address_limits[F::ADDR_TYPE_MAX] = { p_function->_stack_size, p_function->constants.size(), p_member_count };
+
+	// Self, class and nil always live at the start of the stack, followed by the arguments.
+	if (p_function->_stack_size < 3 || p_function->_stack_size > F::ADDR_MASK || p_function->_argument_count < 0 || p_function->_argument_count > p_function->_stack_size - 3) {
+		return false;
+	}
+	const int default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	if (p_function->_argument_count > p_function->argument_types.size() || default_arg_count > p_function->_argument_count) {
+		return false;
+	}
+	if (p_function->_instruction_args_size < 0 || p_function->_instruction_args_size > code_size || p_function->_ptrcall_args_size < 0 || p_function->_ptrcall_args_size > code_size) {
+		return false;
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < 3 || E.key >= p_function->_stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+			return false;
+		}
+	}
+
+	LocalVector<bool> is_instruction;
+	is_instruction.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		is_instruction[i] = false;
+	}
+	LocalVector<int> jump_targets;
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		jump_targets.push_back(p_function->default_arguments[i]);
+	}
+
+	bool valid = true;
+	int ip = 0;
+	int last_opcode = -1;
+
+	// Marks the instruction invalid unless the operand at `p_ofs` is an index in a table of `p_size` elements.
+	auto check_index = [&](int p_ofs, int p_size) {
+		const int value = code[ip + p_ofs];
+		valid = valid && value >= 0 && value < p_size;
+	};
+	auto check_type = [&](int p_ofs) {
+		check_index(p_ofs, Variant::VARIANT_MAX);
+	};
+	auto check_addresses = [&](int p_ofs, int p_count) {
+		for (int i = p_ofs; i < p_ofs + p_count; i++) {
+			const int address = code[ip + i];
+			const int type = (address & F::ADDR_TYPE_MASK) >> F::ADDR_BITS;
+			valid = valid && type >= 0 && type < F::ADDR_TYPE_MAX && (address & F::ADDR_MASK) < address_limits[type];
+		}
+	};
+	auto check_followed_by_resume = [&](int p_ofs) {
+		valid = valid && ip + p_ofs < code_size && code[ip + p_ofs] == F::OPCODE_AWAIT_RESUME;
+	};
+
+	while (valid && ip < code_size) {
+		is_instruction[ip] = true;
+		const int opcode = code[ip];
+		last_opcode = opcode;
+
+		// Instructions taking a variable amount of addresses store how many first, and the other operands after them.
+		int arg_count = 0;
+		int trailing = -1;
+		switch (opcode) {
+			case F::OPCODE_CONSTRUCT_ARRAY:
+			case F::OPCODE_CONSTRUCT_DICTIONARY:
+				trailing = 1;
+				break;
+			case F::OPCODE_CONSTRUCT:
+			case F::OPCODE_CONSTRUCT_VALIDATED:
+			case F::OPCODE_CALL_METHOD_BIND:
+			case F::OPCODE_CALL_METHOD_BIND_RET:
+			case F::OPCODE_CALL_NATIVE_STATIC:
+			case F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			case F::OPCODE_CALL_UTILITY:
+			case F::OPCODE_CALL_UTILITY_VALIDATED:
+			case F::OPCODE_CALL_GDSCRIPT_UTILITY:
+			case F::OPCODE_CALL_SELF_BASE:
+			case F::OPCODE_CREATE_LAMBDA:
+			case F::OPCODE_CREATE_SELF_LAMBDA:
+				trailing = 2;
+				break;
+			case F::OPCODE_CONSTRUCT_TYPED_ARRAY:
+			case F::OPCODE_CALL:
+			case F::OPCODE_CALL_RETURN:
+			case F::OPCODE_CALL_ASYNC:
+			case F::OPCODE_CALL_BUILTIN_STATIC:
+			case F::OPCODE_CALL_SCRIPT_FUNCTION:
+				trailing = 3;
+				break;
+			default:
+				if (opcode >= F::OPCODE_CALL_PTRCALL_NO_RETURN && opcode <= F::OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY) {
+					trailing = 2;
+				}
+				break;
+		}
+
+		int length = 0;
+		if (trailing >= 0) {
+			if (ip + 1 >= code_size) {
+				return false;
+			}
+			arg_count = code[ip + 1];
+			if (arg_count < 0 || arg_count > p_function->_instruction_args_size || arg_count > code_size - ip - 2 - trailing) {
+				return false;
+			}
+			length = 2 + arg_count + trailing;
+			check_addresses(2, arg_count);
+		} else {
+			switch (opcode) {
+				case F::OPCODE_BREAKPOINT:
+				case F::OPCODE_END:
+				case F::OPCODE_JUMP_TO_DEF_ARGUMENT:
+					length = 1;
+					break;
+				case F::OPCODE_ASSIGN_TRUE:
+				case F::OPCODE_ASSIGN_FALSE:
+				case F::OPCODE_AWAIT:
+				case F::OPCODE_AWAIT_RESUME:
+				case F::OPCODE_RETURN:
+				case F::OPCODE_JUMP:
+				case F::OPCODE_LINE:
+					length = 2;
+					break;
+				case F::OPCODE_ARRAY_SIZE:
+				case F::OPCODE_SET_MEMBER:
+				case F::OPCODE_GET_MEMBER:
+				case F::OPCODE_ASSIGN:
+				case F::OPCODE_JUMP_IF:
+				case F::OPCODE_JUMP_IF_NOT:
+				case F::OPCODE_JUMP_IF_SHARED:
+				case F::OPCODE_RETURN_TYPED_BUILTIN:
+				case F::OPCODE_RETURN_TYPED_NATIVE:
+				case F::OPCODE_RETURN_TYPED_SCRIPT:
+				case F::OPCODE_STORE_GLOBAL:
+				case F::OPCODE_STORE_NAMED_GLOBAL:
+				case F::OPCODE_ASSERT:
+					length = 3;
+					break;
+				case F::OPCODE_TYPE_TEST_BUILTIN:
+				case F::OPCODE_TYPE_TEST_NATIVE:
+				case F::OPCODE_TYPE_TEST_SCRIPT:
+				case F::OPCODE_SET_KEYED:
+				case F::OPCODE_GET_KEYED:
+				case F::OPCODE_ARRAY_APPEND:
+				case F::OPCODE_SET_NAMED_VALIDATED:
+				case F::OPCODE_GET_NAMED_VALIDATED:
+				case F::OPCODE_SET_STATIC_VARIABLE:
+				case F::OPCODE_GET_STATIC_VARIABLE:
+				case F::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case F::OPCODE_ASSIGN_TYPED_NATIVE:
+				case F::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case F::OPCODE_CAST_TO_BUILTIN:
+				case F::OPCODE_CAST_TO_NATIVE:
+				case F::OPCODE_CAST_TO_SCRIPT:
+				case F::OPCODE_OPERATOR_ADD_INT:
+				case F::OPCODE_OPERATOR_SUBTRACT_INT:
+				case F::OPCODE_OPERATOR_MULTIPLY_INT:
+				case F::OPCODE_OPERATOR_ADD_FLOAT:
+				case F::OPCODE_OPERATOR_SUBTRACT_FLOAT:
+				case F::OPCODE_OPERATOR_MULTIPLY_FLOAT:
+				case F::OPCODE_OPERATOR_DIVIDE_FLOAT:
+					length = 4;
+					break;
+				case F::OPCODE_OPERATOR:
+				case F::OPCODE_OPERATOR_VALIDATED:
+				case F::OPCODE_SET_KEYED_VALIDATED:
+				case F::OPCODE_SET_INDEXED_VALIDATED:
+				case F::OPCODE_GET_KEYED_VALIDATED:
+				case F::OPCODE_GET_INDEXED_VALIDATED:
+				case F::OPCODE_SET_NAMED:
+				case F::OPCODE_GET_NAMED:
+				case F::OPCODE_RETURN_TYPED_ARRAY:
+					length = 5;
+					break;
+				case F::OPCODE_TYPE_TEST_ARRAY:
+				case F::OPCODE_ASSIGN_TYPED_ARRAY:
+				case F::OPCODE_AWAIT_TIMER:
+				case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+				case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+					length = 6;
+					break;
+				default:
+					if ((opcode >= F::OPCODE_GET_INDEXED_ARRAY && opcode <= F::OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY)) {
+						length = 4;
+					} else if (opcode >= F::OPCODE_ITERATE_BEGIN && opcode <= F::OPCODE_ITERATE_OBJECT) {
+						length = 5;
+					} else if (opcode >= F::OPCODE_TYPE_ADJUST_BOOL && opcode <= F::OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY) {
+						length = 2;
+					} else {
+						return false; // Unknown opcode.
+					}
+					break;
+			}
+			if (length > code_size - ip) {
+				return false;
+			}
+		}
+
+		// Operands after the variable amount of addresses, if any.
+		const int t = 2 + arg_count;
+		const int argc = trailing >= 0 ? code[ip + t] : 0;
+
+		switch (opcode) {
+			case F::OPCODE_OPERATOR:
+				check_addresses(1, 3);
+				check_index(4, Variant::OP_MAX);
+				break;
+			case F::OPCODE_OPERATOR_VALIDATED:
+				check_addresses(1, 3);
+				check_index(4, p_function->operator_funcs.size());
+				break;
+			case F::OPCODE_TYPE_TEST_BUILTIN:
+			case F::OPCODE_ASSIGN_TYPED_BUILTIN:
+			case F::OPCODE_CAST_TO_BUILTIN:
+				check_addresses(1, 2);
+				check_type(3);
+				break;
+			case F::OPCODE_TYPE_TEST_ARRAY:
+			case F::OPCODE_ASSIGN_TYPED_ARRAY:
+				check_addresses(1, 3);
+				check_type(4);
+				check_index(5, p_function->global_names.size());
+				break;
+			case F::OPCODE_TYPE_TEST_NATIVE:
+				check_addresses(1, 2);
+				check_index(3, p_function->global_names.size());
+				break;
+			case F::OPCODE_SET_KEYED_VALIDATED:
+				check_addresses(1, 3);
+				check_index(4, p_function->keyed_setters.size());
+				break;
+			case F::OPCODE_SET_INDEXED_VALIDATED:
+				check_addresses(1, 3);
+				check_index(4, p_function->indexed_setters.size());
+				break;
+			case F::OPCODE_GET_KEYED_VALIDATED:
+				check_addresses(1, 3);
+				check_index(4, p_function->keyed_getters.size());
+				break;
+			case F::OPCODE_GET_INDEXED_VALIDATED:
+				check_addresses(1, 3);
+				check_index(4, p_function->indexed_getters.size());
+				break;
+			case F::OPCODE_SET_NAMED:
+			case F::OPCODE_GET_NAMED:
+				check_addresses(1, 2);
+				check_index(3, p_function->global_names.size());
+				check_index(4, p_function->_inline_cache_count);
+				break;
+			case F::OPCODE_SET_NAMED_VALIDATED:
+				check_addresses(1, 2);
+				check_index(3, p_function->setters.size());
+				break;
+			case F::OPCODE_GET_NAMED_VALIDATED:
+				check_addresses(1, 2);
+				check_index(3, p_function->getters.size());
+				break;
+			case F::OPCODE_SET_MEMBER:
+			case F::OPCODE_GET_MEMBER:
+			case F::OPCODE_STORE_NAMED_GLOBAL:
+				check_addresses(1, 1);
+				check_index(2, p_function->global_names.size());
+				break;
+			case F::OPCODE_SET_STATIC_VARIABLE:
+			case F::OPCODE_GET_STATIC_VARIABLE:
+				// The index is checked against the class found at runtime.
+				check_addresses(1, 2);
+				check_index(3, INT32_MAX);
+				break;
+			case F::OPCODE_STORE_GLOBAL:
+				check_addresses(1, 1);
+				check_index(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+				break;
+			case F::OPCODE_AWAIT:
+				// Resumes with the operand of the next instruction.
+				check_addresses(1, 1);
+				check_followed_by_resume(2);
+				break;
+			case F::OPCODE_AWAIT_TIMER:
+				check_addresses(1, 5);
+				check_followed_by_resume(6);
+				break;
+			case F::OPCODE_JUMP:
+				jump_targets.push_back(code[ip + 1]);
+				break;
+			case F::OPCODE_JUMP_IF:
+			case F::OPCODE_JUMP_IF_NOT:
+			case F::OPCODE_JUMP_IF_SHARED:
+				check_addresses(1, 1);
+				jump_targets.push_back(code[ip + 2]);
+				break;
+			case F::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				valid = valid && !p_function->default_arguments.is_empty();
+				break;
+			case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+				check_addresses(1, 3);
+				check_index(4, p_function->operator_funcs.size());
+				jump_targets.push_back(code[ip + 5]);
+				break;
+			case F::OPCODE_RETURN_TYPED_BUILTIN:
+				check_addresses(1, 1);
+				check_type(2);
+				break;
+			case F::OPCODE_RETURN_TYPED_ARRAY:
+				check_addresses(1, 2);
+				check_type(3);
+				check_index(4, p_function->global_names.size());
+				break;
+			case F::OPCODE_LINE:
+			case F::OPCODE_BREAKPOINT:
+			case F::OPCODE_END:
+				break;
+
+			case F::OPCODE_CONSTRUCT:
+				check_index(t, arg_count);
+				check_type(t + 1);
+				break;
+			case F::OPCODE_CONSTRUCT_VALIDATED:
+				check_index(t, arg_count);
+				check_index(t + 1, p_function->constructors.size());
+				break;
+			case F::OPCODE_CONSTRUCT_ARRAY:
+				check_index(t, arg_count);
+				break;
+			case F::OPCODE_CONSTRUCT_TYPED_ARRAY:
+				check_index(t, arg_count - 1);
+				check_type(t + 1);
+				check_index(t + 2, p_function->global_names.size());
+				break;
+			case F::OPCODE_CONSTRUCT_DICTIONARY:
+				valid = valid && argc >= 0 && argc <= (arg_count - 1) / 2;
+				break;
+			case F::OPCODE_CALL:
+			case F::OPCODE_CALL_RETURN:
+			case F::OPCODE_CALL_ASYNC:
+			case F::OPCODE_CALL_SCRIPT_FUNCTION:
+				check_index(t, arg_count - 1);
+				check_index(t + 1, p_function->global_names.size());
+				check_index(t + 2, p_function->_inline_cache_count);
+				break;
+			case F::OPCODE_CALL_METHOD_BIND:
+			case F::OPCODE_CALL_METHOD_BIND_RET:
+				check_index(t, arg_count - 1);
+				check_index(t + 1, p_function->methods.size());
+				break;
+			case F::OPCODE_CALL_BUILTIN_STATIC:
+				check_type(t);
+				check_index(t + 1, p_function->global_names.size());
+				check_index(t + 2, arg_count);
+				break;
+			case F::OPCODE_CALL_NATIVE_STATIC:
+				check_index(t, p_function->methods.size());
+				check_index(t + 1, arg_count);
+				break;
+			case F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+				check_index(t, arg_count - 1);
+				check_index(t + 1, p_function->builtin_methods.size());
+				break;
+			case F::OPCODE_CALL_UTILITY:
+			case F::OPCODE_CALL_SELF_BASE:
+				check_index(t, arg_count);
+				check_index(t + 1, p_function->global_names.size());
+				break;
+			case F::OPCODE_CALL_UTILITY_VALIDATED:
+				check_index(t, arg_count);
+				check_index(t + 1, p_function->utilities.size());
+				break;
+			case F::OPCODE_CALL_GDSCRIPT_UTILITY:
+				check_index(t, arg_count);
+				check_index(t + 1, p_function->gds_utilities.size());
+				break;
+			case F::OPCODE_CREATE_LAMBDA:
+			case F::OPCODE_CREATE_SELF_LAMBDA:
+				check_index(t, arg_count);
+				check_index(t + 1, p_function->lambdas.size());
+				break;
+
+			default:
+				if (opcode >= F::OPCODE_CALL_PTRCALL_NO_RETURN && opcode <= F::OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY) {
+					// The arguments are also converted in a buffer of `_ptrcall_args_size` pointers.
+					check_index(t, arg_count - 1);
+					valid = valid && argc <= p_function->_ptrcall_args_size;
+					check_index(t + 1, p_function->methods.size());
+				} else if (opcode >= F::OPCODE_ITERATE_BEGIN && opcode <= F::OPCODE_ITERATE_OBJECT) {
+					check_addresses(1, 3);
+					jump_targets.push_back(code[ip + 4]);
+				} else if (trailing < 0) {
+					// Everything else only takes addresses.
+					check_addresses(1, length - 1);
+				}
+				break;
+		}
+
+		ip += length;
+	}
+
+	// Nothing can run past the end of the code, the release VM doesn't check it.
+	if (!valid || ip != code_size || last_opcode != F::OPCODE_END) {
+		return false;
+	}
+
+	for (const int target : jump_targets) {
+		if (target < 0 || target >= code_size || !is_instruction[target]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Writing */
+
+bool GDScriptBytecodeCache::_write_variant(Writer &p_writer, const Variant &p_value, const GDScript *p_owner) {
+	switch (p_value.get_type()) {
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			// Only valid in the current run.
+			return false;
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_u8(VARIANT_TAG_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			if (!_write_variant(p_writer, array.get_typed_script(), p_owner)) {
+				return false;
+			}
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!_write_variant(p_writer, array[i], p_owner)) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_u8(VARIANT_TAG_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u32(dictionary.size());
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			for (const Variant &key : keys) {
+				if (!_write_variant(p_writer, key, p_owner) || !_write_variant(p_writer, dictionary[key], p_owner)) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::OBJECT: {
+			const Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(VARIANT_TAG_NULL_OBJECT);
+				return true;
+			}
+
+			StringName global_name = _get_global_name(object);
+			if (global_name != StringName()) {
+				p_writer.put_u8(VARIANT_TAG_GLOBAL);
+				p_writer.put_string(global_name);
+				return true;
+			}
+
+			const GDScript *script = Object::cast_to<GDScript>(object);
+			if (script) {
+				// Stored as the root script and the inner class names leading to it.
+				Vector<StringName> class_path;
+				const GDScript *root = script;
+				while (root->_owner) {
+					class_path.push_back(root->name);
+					root = root->_owner;
+				}
+				const GDScript *owner_root = p_owner;
+				while (owner_root->_owner) {
+					owner_root = owner_root->_owner;
+				}
+
+				bool local = root == owner_root;
+				if (!local && !root->path.is_resource_file()) {
+					return false;
+				}
+				p_writer.put_u8(VARIANT_TAG_SCRIPT);
+				p_writer.put_u8(local);
+				if (!local) {
+					p_writer.put_string(root->path);
+				}
+				class_path.reverse();
+				p_writer.put_names(class_path);
+				return true;
+			}
+
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && resource->get_path().is_resource_file()) {
+				p_writer.put_u8(Object::cast_to<PackedScene>(object) ? VARIANT_TAG_PACKED_SCENE : VARIANT_TAG_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				return true;
+			}
+
+			// Built-in resources and plain objects can't be restored.
+			return false;
+		} break;
+		default: {
+			p_writer.put_u8(VARIANT_TAG_PLAIN);
+			return p_writer.put_plain_variant(p_value);
+		} break;
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_owner) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	if (p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT) {
+		p_writer.put_u8(p_type.script_type_ref.is_valid());
+		if (!_write_variant(p_writer, Variant(p_type.script_type), p_owner)) {
+			return false;
+		}
+	}
+	p_writer.put_u8(p_type.has_container_element_type());
+	if (p_type.has_container_element_type()) {
+		return _write_data_type(p_writer, p_type.get_container_element_type(), p_owner);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info, const GDScript *p_owner) {
+	p_writer.put_u32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	return _write_data_type(p_writer, p_info.data_type, p_owner);
+}
+
+bool GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_owner) {
+	const Symbols &table = _get_symbols();
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	if (!_write_variant(p_writer, p_function->rpc_config, p_owner)) {
+		return false;
+	}
+	if (!_write_data_type(p_writer, p_function->return_type, p_owner)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_function->_argument_count);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &type : p_function->argument_types) {
+		if (!_write_data_type(p_writer, type, p_owner)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		p_writer.put_u32(address);
+	}
+#ifdef TOOLS_ENABLED
+	p_writer.put_names(p_function->arg_names);
+	p_writer.put_u32(p_function->default_arg_values.size());
+	for (const Variant &value : p_function->default_arg_values) {
+		if (!_write_variant(p_writer, value, p_owner)) {
+			return false;
+		}
+	}
+#endif
+
+	p_writer.put_u32(p_function->_initial_line);
+	p_writer.put_u32(p_function->_stack_size);
+	p_writer.put_u32(p_function->_instruction_args_size);
+	p_writer.put_u32(p_function->_ptrcall_args_size);
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_u32(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	p_writer.put_u32(p_function->code.size());
+	for (int code : p_function->code) {
+		p_writer.put_u32(code);
+	}
+	p_writer.put_u32(p_function->_inline_cache_count);
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_variant(p_writer, constant, p_owner)) {
+			return false;
+		}
+	}
+	p_writer.put_names(p_function->global_names);
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const OperatorSymbol *symbol = table.operators.getptr(evaluator);
+		if (!symbol) {
+			return false;
+		}
+		p_writer.put_u32(symbol->op);
+		p_writer.put_u32(symbol->left);
+		p_writer.put_u32(symbol->right);
+	}
+
+#define WRITE_MEMBER_TABLE(m_table, m_symbols)                  \
+	p_writer.put_u32(p_function->m_table.size());               \
+	for (int i = 0; i < p_function->m_table.size(); i++) {      \
+		const Pair<Variant::Type, StringName> *symbol =         \
+				table.m_symbols.getptr(p_function->m_table[i]); \
+		if (!symbol) {                                          \
+			return false;                                       \
+		}                                                       \
+		p_writer.put_u32(symbol->first);                        \
+		p_writer.put_string(symbol->second);                    \
+	}
+
+#define WRITE_TYPE_TABLE(m_table, m_symbols)                                          \
+	p_writer.put_u32(p_function->m_table.size());                                     \
+	for (int i = 0; i < p_function->m_table.size(); i++) {                            \
+		const Variant::Type *symbol = table.m_symbols.getptr(p_function->m_table[i]); \
+		if (!symbol) {                                                                \
+			return false;                                                             \
+		}                                                                             \
+		p_writer.put_u32(*symbol);                                                    \
+	}
+
+	WRITE_MEMBER_TABLE(setters, setters);
+	WRITE_MEMBER_TABLE(getters, getters);
+	WRITE_TYPE_TABLE(keyed_setters, keyed_setters);
+	WRITE_TYPE_TABLE(keyed_getters, keyed_getters);
+	WRITE_TYPE_TABLE(indexed_setters, indexed_setters);
+	WRITE_TYPE_TABLE(indexed_getters, indexed_getters);
+	WRITE_MEMBER_TABLE(builtin_methods, builtin_methods);
+
+#undef WRITE_MEMBER_TABLE
+#undef WRITE_TYPE_TABLE
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Pair<Variant::Type, int> *symbol = table.constructors.getptr(constructor);
+		if (!symbol) {
+			return false;
+		}
+		p_writer.put_u32(symbol->first);
+		p_writer.put_u32(symbol->second);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *symbol = table.utilities.getptr(utility);
+		if (!symbol) {
+			return false;
+		}
+		p_writer.put_string(*symbol);
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *symbol = table.gds_utilities.getptr(utility);
+		if (!symbol) {
+			return false;
+		}
+		p_writer.put_string(*symbol);
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		if (!_write_function(p_writer, lambda, p_owner)) {
+			return false;
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	p_writer.put_strings(p_function->operator_names);
+	p_writer.put_strings(p_function->setter_names);
+	p_writer.put_strings(p_function->getter_names);
+	p_writer.put_strings(p_function->builtin_methods_names);
+	p_writer.put_strings(p_function->constructors_names);
+	p_writer.put_strings(p_function->utilities_names);
+	p_writer.put_strings(p_function->gds_utilities_names);
+#endif
+
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_class_tree(Writer &p_writer, const GDScript *p_class) {
+	p_writer.put_string(p_class->name);
+	p_writer.put_string(p_class->fully_qualified_name);
+	p_writer.put_u32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		p_writer.put_string(E.key);
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_write_class(Writer &p_writer, const GDScript *p_class) {
+	p_writer.put_u8(p_class->tool);
+	p_writer.put_string(p_class->native.is_valid() ? p_class->native->get_name() : StringName());
+	if (!_write_variant(p_writer, p_class->base, p_class)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_class->members.size());
+	for (const StringName &member : p_class->members) {
+		p_writer.put_string(member);
+	}
+
+	p_writer.put_u32(p_class->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->member_indices) {
+		p_writer.put_string(E.key);
+		if (!_write_member_info(p_writer, E.value, p_class)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_class->member_info.size());
+	for (const KeyValue<StringName, PropertyInfo> &E : p_class->member_info) {
+		p_writer.put_string(E.key);
+		p_writer.put_property_info(E.value);
+	}
+
+	p_writer.put_u32(p_class->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->static_variables_indices) {
+		p_writer.put_string(E.key);
+		if (!_write_member_info(p_writer, E.value, p_class)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_class->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_writer, E.value, p_class)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_class->_signals.size());
+	for (const KeyValue<StringName, Vector<StringName>> &E : p_class->_signals) {
+		p_writer.put_string(E.key);
+		p_writer.put_names(E.value);
+	}
+
+	p_writer.put_u32(p_class->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+		if (!_write_function(p_writer, E.value, p_class)) {
+			return false;
+		}
+	}
+
+	const GDScriptFunction *implicit_functions[3] = { p_class->implicit_initializer, p_class->implicit_ready, p_class->static_initializer };
+	for (const GDScriptFunction *function : implicit_functions) {
+		p_writer.put_u8(function != nullptr);
+		if (function && !_write_function(p_writer, function, p_class)) {
+			return false;
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	p_writer.put_u32(p_class->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_class->member_default_values) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_writer, E.value, p_class)) {
+			return false;
+		}
+	}
+#endif
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		if (!_write_class(p_writer, E.value.ptr())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Reading */
+
+bool GDScriptBytecodeCache::_read_variant(Reader &p_reader, Variant &r_value, GDScript *p_owner) {
+	GDScript *owner_root = p_owner;
+	while (owner_root->_owner) {
+		owner_root = owner_root->_owner;
+	}
+
+	switch (p_reader.get_u8()) {
+		case VARIANT_TAG_PLAIN: {
+			return p_reader.get_plain_variant(r_value);
+		} break;
+		case VARIANT_TAG_ARRAY: {
+			bool read_only = p_reader.get_u8();
+			Variant::Type builtin_type = Variant::Type(p_reader.get_u32());
+			StringName class_name = p_reader.get_name();
+			Variant script;
+			if (!_read_variant(p_reader, script, p_owner) || builtin_type >= Variant::VARIANT_MAX) {
+				return false;
+			}
+
+			Array array;
+			if (builtin_type != Variant::NIL) {
+				array.set_typed(builtin_type, class_name, script);
+			}
+			array.resize(p_reader.get_count());
+			for (int i = 0; i < array.size(); i++) {
+				Variant element;
+				if (!_read_variant(p_reader, element, p_owner)) {
+					return false;
+				}
+				array[i] = element;
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+		} break;
+		case VARIANT_TAG_DICTIONARY: {
+			bool read_only = p_reader.get_u8();
+			uint32_t size = p_reader.get_count();
+
+			Dictionary dictionary;
+			for (uint32_t i = 0; i < size; i++) {
+				Variant key;
+				Variant value;
+				if (!_read_variant(p_reader, key, p_owner) || !_read_variant(p_reader, value, p_owner)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+		} break;
+		case VARIANT_TAG_NULL_OBJECT: {
+			r_value = (Object *)nullptr;
+		} break;
+		case VARIANT_TAG_GLOBAL: {
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			const int *index = language->get_global_map().getptr(p_reader.get_name());
+			if (!index) {
+				return false;
+			}
+			r_value = language->get_global_array()[*index];
+		} break;
+		case VARIANT_TAG_SCRIPT: {
+			bool local = p_reader.get_u8();
+
+			Ref<GDScript> script;
+			if (local) {
+				script = Ref<GDScript>(owner_root);
+			} else {
+				String path = p_reader.get_string();
+				if (p_reader.error) {
+					return false;
+				}
+				Error err = OK;
+				script = GDScriptCache::get_shallow_script(path, err, owner_root->path);
+				if (err != OK || script.is_null()) {
+					return false;
+				}
+			}
+
+			Vector<StringName> class_path = p_reader.get_names();
+			for (const StringName &name : class_path) {
+				const Ref<GDScript> *subclass = script->subclasses.getptr(name);
+				if (!subclass) {
+					return false;
+				}
+				script = *subclass;
+			}
+			r_value = script;
+		} break;
+		case VARIANT_TAG_RESOURCE: {
+			String path = p_reader.get_string();
+			if (p_reader.error) {
+				return false;
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				return false;
+			}
+			r_value = resource;
+		} break;
+		case VARIANT_TAG_PACKED_SCENE: {
+			String path = p_reader.get_string();
+			if (p_reader.error) {
+				return false;
+			}
+			Error err = OK;
+			Ref<PackedScene> scene = GDScriptCache::get_packed_scene(path, err, owner_root->path);
+			if (err != OK || scene.is_null()) {
+				return false;
+			}
+			r_value = scene;
+		} break;
+		default: {
+			return false;
+		} break;
+	}
+
+	return !p_reader.error;
+}
+
+bool GDScriptBytecodeCache::_read_data_type(Reader &p_reader, GDScriptDataType &r_type, GDScript *p_owner) {
+	r_type.has_type = p_reader.get_u8();
+	r_type.kind = GDScriptDataType::Kind(p_reader.get_u8());
+	r_type.builtin_type = Variant::Type(p_reader.get_u32());
+	r_type.native_type = p_reader.get_name();
+	if (r_type.kind > GDScriptDataType::GDSCRIPT || r_type.builtin_type >= Variant::VARIANT_MAX) {
+		return false;
+	}
+
+	if (r_type.kind == GDScriptDataType::SCRIPT || r_type.kind == GDScriptDataType::GDSCRIPT) {
+		bool strong_ref = p_reader.get_u8();
+		Variant script;
+		if (!_read_variant(p_reader, script, p_owner)) {
+			return false;
+		}
+		r_type.script_type = Object::cast_to<Script>(script);
+		if (strong_ref) {
+			r_type.script_type_ref = Ref<Script>(r_type.script_type);
+		}
+	}
+
+	if (p_reader.get_u8()) {
+		GDScriptDataType element_type;
+		if (!_read_data_type(p_reader, element_type, p_owner)) {
+			return false;
+		}
+		r_type.set_container_element_type(element_type);
+	}
+
+	return !p_reader.error;
+}
+
+bool GDScriptBytecodeCache::_read_member_info(Reader &p_reader, GDScript::MemberInfo &r_info, GDScript *p_owner) {
+	r_info.index = p_reader.get_u32();
+	r_info.setter = p_reader.get_name();
+	r_info.getter = p_reader.get_name();
+	return _read_data_type(p_reader, r_info.data_type, p_owner);
+}
+
+bool GDScriptBytecodeCache::_read_function_data(Reader &p_reader, GDScriptFunction *p_function, GDScript *p_owner) {
+	p_function->_static = p_reader.get_u8();
+	if (!_read_variant(p_reader, p_function->rpc_config, p_owner)) {
+		return false;
+	}
+	if (!_read_data_type(p_reader, p_function->return_type, p_owner)) {
+		return false;
+	}
+
+	p_function->_argument_count = p_reader.get_u32();
+	p_function->argument_types.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		if (!_read_data_type(p_reader, p_function->argument_types.write[i], p_owner)) {
+			return false;
+		}
+	}
+	p_function->default_arguments.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		p_function->default_arguments.write[i] = p_reader.get_u32();
+	}
+#ifdef TOOLS_ENABLED
+	p_function->arg_names = p_reader.get_names();
+	p_function->default_arg_values.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->default_arg_values.size(); i++) {
+		if (!_read_variant(p_reader, p_function->default_arg_values.write[i], p_owner)) {
+			return false;
+		}
+	}
+#endif
+
+	p_function->_initial_line = p_reader.get_u32();
+	p_function->_stack_size = p_reader.get_u32();
+	p_function->_instruction_args_size = p_reader.get_u32();
+	p_function->_ptrcall_args_size = p_reader.get_u32();
+
+	uint32_t temporary_count = p_reader.get_count();
+	for (uint32_t i = 0; i < temporary_count; i++) {
+		int slot = p_reader.get_u32();
+		p_function->temporary_slots[slot] = Variant::Type(p_reader.get_u32());
+	}
+
+	p_function->code.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->code.size(); i++) {
+		p_function->code.write[i] = p_reader.get_u32();
+	}
+	// Every cached instruction takes several words, so this also bounds the allocation.
+	uint32_t inline_cache_count = p_reader.get_u32();
+	if (inline_cache_count > (uint32_t)p_function->code.size()) {
+		return false;
+	}
+	p_function->_init_inline_caches(inline_cache_count);
+
+	p_function->constants.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		if (!_read_variant(p_reader, p_function->constants.write[i], p_owner)) {
+			return false;
+		}
+	}
+	p_function->global_names = p_reader.get_names();
+
+	p_function->operator_funcs.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->operator_funcs.size(); i++) {
+		Variant::Operator op = Variant::Operator(p_reader.get_u32());
+		Variant::Type left = Variant::Type(p_reader.get_u32());
+		Variant::Type right = Variant::Type(p_reader.get_u32());
+		if (op >= Variant::OP_MAX || left >= Variant::VARIANT_MAX || right >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		p_function->operator_funcs.write[i] = Variant::get_validated_operator_evaluator(op, left, right);
+	}
+
+	p_function->setters.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->setters.size(); i++) {
+		Variant::Type type = Variant::Type(p_reader.get_u32());
+		StringName member = p_reader.get_name();
+		p_function->setters.write[i] = type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(type, member) : nullptr;
+	}
+
+	p_function->getters.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->getters.size(); i++) {
+		Variant::Type type = Variant::Type(p_reader.get_u32());
+		StringName member = p_reader.get_name();
+		p_function->getters.write[i] = type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(type, member) : nullptr;
+	}
+
+#define READ_TYPE_TABLE(m_table, m_getter)                                                              \
+	p_function->m_table.resize(p_reader.get_count());                                                   \
+	for (int i = 0; i < p_function->m_table.size(); i++) {                                              \
+		Variant::Type type = Variant::Type(p_reader.get_u32());                                         \
+		p_function->m_table.write[i] = type < Variant::VARIANT_MAX ? Variant::m_getter(type) : nullptr; \
+	}
+
+	READ_TYPE_TABLE(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPE_TABLE(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPE_TABLE(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPE_TABLE(indexed_getters, get_member_validated_indexed_getter);
+
+#undef READ_TYPE_TABLE
+
+	p_function->builtin_methods.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->builtin_methods.size(); i++) {
+		Variant::Type type = Variant::Type(p_reader.get_u32());
+		StringName method = p_reader.get_name();
+		if (type >= Variant::VARIANT_MAX || !Variant::has_builtin_method(type, method)) {
+			return false;
+		}
+		p_function->builtin_methods.write[i] = Variant::get_validated_builtin_method(type, method);
+	}
+
+	p_function->constructors.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->constructors.size(); i++) {
+		Variant::Type type = Variant::Type(p_reader.get_u32());
+		int constructor = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX || constructor >= Variant::get_constructor_count(type)) {
+			return false;
+		}
+		p_function->constructors.write[i] = Variant::get_validated_constructor(type, constructor);
+	}
+
+	p_function->utilities.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->utilities.size(); i++) {
+		p_function->utilities.write[i] = Variant::get_validated_utility_function(p_reader.get_name());
+	}
+
+	p_function->gds_utilities.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->gds_utilities.size(); i++) {
+		p_function->gds_utilities.write[i] = GDScriptUtilityFunctions::get_function(p_reader.get_name());
+	}
+
+	p_function->methods.resize(p_reader.get_count());
+	for (int i = 0; i < p_function->methods.size(); i++) {
+		StringName class_name = p_reader.get_name();
+		StringName method = p_reader.get_name();
+		p_function->methods.write[i] = ClassDB::get_method(class_name, method);
+	}
+
+	uint32_t lambda_count = p_reader.get_count();
+	for (uint32_t i = 0; i < lambda_count; i++) {
+		GDScriptFunction *lambda = _read_function(p_reader, p_owner);
+		if (!lambda) {
+			return false;
+		}
+		p_function->lambdas.push_back(lambda);
+	}
+
+#ifdef DEBUG_ENABLED
+	p_function->operator_names = p_reader.get_strings();
+	p_function->setter_names = p_reader.get_strings();
+	p_function->getter_names = p_reader.get_strings();
+	p_function->builtin_methods_names = p_reader.get_strings();
+	p_function->constructors_names = p_reader.get_strings();
+	p_function->utilities_names = p_reader.get_strings();
+	p_function->gds_utilities_names = p_reader.get_strings();
+#endif
+
+	if (p_reader.error) {
+		return false;
+	}
+
+	// Any symbol which doesn't resolve anymore makes the whole function unusable.
+#define CHECK_RESOLVED(m_table)                            \
+	for (int i = 0; i < p_function->m_table.size(); i++) { \
+		if (p_function->m_table[i] == nullptr) {           \
+			return false;                                  \
+		}                                                  \
+	}
+
+	CHECK_RESOLVED(operator_funcs);
+	CHECK_RESOLVED(setters);
+	CHECK_RESOLVED(getters);
+	CHECK_RESOLVED(keyed_setters);
+	CHECK_RESOLVED(keyed_getters);
+	CHECK_RESOLVED(indexed_setters);
+	CHECK_RESOLVED(indexed_getters);
+	CHECK_RESOLVED(builtin_methods);
+	CHECK_RESOLVED(constructors);
+	CHECK_RESOLVED(utilities);
+	CHECK_RESOLVED(gds_utilities);
+	CHECK_RESOLVED(methods);
+
+#undef CHECK_RESOLVED
+
+	// Static functions run without an instance, so they can't address members.
+	if (!_validate_function(p_function, p_function->_static ? 0 : p_owner->member_indices.size())) {
+		return false;
+	}
+
+	_update_function_pointers(p_function);
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, GDScript *p_owner) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_owner;
+	function->source = p_owner->get_script_path();
+	function->name = p_reader.get_name();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	if (!_read_function_data(p_reader, function, p_owner)) {
+		memdelete(function);
+		return nullptr;
+	}
+	return function;
+}
+
+bool GDScriptBytecodeCache::_read_class_tree(Reader &p_reader, GDScript *p_class) {
+	p_class->name = p_reader.get_string();
+	p_class->fully_qualified_name = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_class->subclasses;
+	p_class->subclasses.clear();
+
+	uint32_t subclass_count = p_reader.get_count();
+	for (uint32_t i = 0; i < subclass_count; i++) {
+		StringName name = p_reader.get_name();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_class;
+		subclass->path = p_class->path;
+		p_class->subclasses.insert(name, subclass);
+
+		if (!_read_class_tree(p_reader, subclass.ptr())) {
+			return false;
+		}
+	}
+
+	return !p_reader.error;
+}
+
+bool GDScriptBytecodeCache::_read_class(Reader &p_reader, GDScript *p_class) {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	GDScript *root = p_class;
+	while (root->_owner) {
+		root = root->_owner;
+	}
+
+	p_class->tool = p_reader.get_u8();
+
+	const int *native_index = language->get_global_map().getptr(p_reader.get_name());
+	if (!native_index) {
+		return false;
+	}
+	p_class->native = language->get_global_array()[*native_index];
+	if (p_class->native.is_null()) {
+		return false;
+	}
+
+	Variant base_value;
+	if (!_read_variant(p_reader, base_value, p_class)) {
+		return false;
+	}
+	Ref<GDScript> base = base_value;
+	if (base.is_valid()) {
+		if (!root->has_class(base.ptr()) && !base->is_valid()) {
+			// Same as the compiler, external base classes must be fully loaded first.
+			Error err = OK;
+			Ref<GDScript> base_root = GDScriptCache::get_full_script(base->path, err, root->path);
+			if (err != OK || base_root.is_null()) {
+				return false;
+			}
+			base = Ref<GDScript>(base_root->find_class(base->fully_qualified_name));
+			if (base.is_null() || (!base->is_valid() && !base->reloading)) {
+				return false;
+			}
+		}
+		p_class->base = base;
+		p_class->_base = base.ptr();
+	}
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		p_class->members.insert(p_reader.get_name());
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		GDScript::MemberInfo info;
+		if (!_read_member_info(p_reader, info, p_class)) {
+			return false;
+		}
+		p_class->member_indices.insert(name, info);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		p_class->member_info.insert(name, p_reader.get_property_info());
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		GDScript::MemberInfo info;
+		if (!_read_member_info(p_reader, info, p_class)) {
+			return false;
+		}
+		p_class->static_variables_indices.insert(name, info);
+	}
+	p_class->static_variables.resize(p_class->static_variables_indices.size());
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		Variant value;
+		if (!_read_variant(p_reader, value, p_class)) {
+			return false;
+		}
+		p_class->constants.insert(name, value);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		p_class->_signals.insert(name, p_reader.get_names());
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_class);
+		if (!function) {
+			return false;
+		}
+		p_class->member_functions.insert(function->name, function);
+		if (function->name == language->strings._init) {
+			p_class->initializer = function;
+		}
+	}
+
+	GDScriptFunction **implicit_functions[3] = { &p_class->implicit_initializer, &p_class->implicit_ready, &p_class->static_initializer };
+	for (GDScriptFunction **function : implicit_functions) {
+		if (p_reader.get_u8()) {
+			*function = _read_function(p_reader, p_class);
+			if (!*function) {
+				return false;
+			}
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name = p_reader.get_name();
+		Variant value;
+		if (!_read_variant(p_reader, value, p_class)) {
+			return false;
+		}
+		p_class->member_default_values.insert(name, value);
+	}
+#endif
+
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		if (!_read_class(p_reader, E.value.ptr())) {
+			return false;
+		}
+	}
+
+	if (p_reader.error) {
+		return false;
+	}
+
+	p_class->_init_rpc_methods_properties();
+
+	p_class->valid = true;
+	return true;
+}
+
+Error GDScriptBytecodeCache::_read_header(Reader &p_reader, const GDScript *p_script, bool p_validate, Vector<String> *r_dependencies, bool *r_register_static) {
+	uint8_t magic[4];
+	if (!p_reader.get_bytes(magic, 4) || memcmp(magic, BYTECODE_CACHE_MAGIC, 4) != 0) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (p_reader.get_u32() != FORMAT_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	uint32_t checksum = p_reader.get_u32();
+	if (p_reader.error) {
+		return ERR_FILE_CORRUPT;
+	}
+	if (p_validate && checksum != hash_murmur3_buffer(p_reader.data + p_reader.position, p_reader.size - p_reader.position)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	String engine_fingerprint = p_reader.get_string();
+	uint64_t globals = p_reader.get_u64();
+	String source_hash = p_reader.get_string();
+	if (p_reader.error) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	bool up_to_date = !p_validate || (engine_fingerprint == _get_engine_fingerprint() && globals == _get_globals_fingerprint() && source_hash == p_script->source.md5_text());
+
+	uint32_t dependency_count = p_reader.get_count();
+	for (uint32_t i = 0; i < dependency_count; i++) {
+		String path = p_reader.get_string();
+		String hash = p_reader.get_string();
+		if (p_reader.error) {
+			return ERR_FILE_CORRUPT;
+		}
+		if (up_to_date && p_validate && GDScriptCache::get_source_hash(path) != hash) {
+			up_to_date = false;
+		}
+		if (r_dependencies) {
+			r_dependencies->push_back(path);
+		}
+	}
+
+	bool register_static = p_reader.get_u8();
+	if (p_reader.error) {
+		return ERR_FILE_CORRUPT;
+	}
+	if (!up_to_date) {
+		return ERR_FILE_MISSING_DEPENDENCIES;
+	}
+
+	if (r_register_static) {
+		*r_register_static = register_static;
+	}
+	return OK;
+}
+
+/* Public API */
+
+bool GDScriptBytecodeCache::is_enabled() {
+	// The editor needs the parser for its tooling and the debugger needs line
+	// information that isn't kept in the cache, so it's only used when running.
+	if (Engine::get_singleton()->is_editor_hint() || EngineDebugger::is_active()) {
+		return false;
+	}
+	return GLOBAL_GET("gdscript/bytecode_cache/enabled");
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	String cache_dir = GLOBAL_GET("gdscript/bytecode_cache/path");
+	return cache_dir.path_join(p_script_path.md5_text() + ".gdbc");
+}
+
+Error GDScriptBytecodeCache::serialize(const GDScript *p_script, const Vector<Dependency> &p_dependencies, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_script->valid || p_script->_owner, ERR_INVALID_PARAMETER, "Only valid root scripts can be serialized.");
+
+	Writer writer;
+	writer.put_bytes(BYTECODE_CACHE_MAGIC, 4);
+	writer.put_u32(FORMAT_VERSION);
+	writer.put_u32(0); // Checksum, filled once everything is written.
+	writer.put_string(_get_engine_fingerprint());
+	writer.put_u64(_get_globals_fingerprint());
+	writer.put_string(p_script->source.md5_text());
+	writer.put_u32(p_dependencies.size());
+	for (const Dependency &dependency : p_dependencies) {
+		writer.put_string(dependency.path);
+		writer.put_string(dependency.source_hash);
+	}
+	writer.put_u8(GDScriptCache::singleton && GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+
+	_write_class_tree(writer, p_script);
+	if (!_write_class(writer, p_script)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const uint32_t body_offset = HEADER_CHECKSUM_OFFSET + 4;
+	encode_uint32(hash_murmur3_buffer(&writer.data[body_offset], writer.data.size() - body_offset), &writer.data[HEADER_CHECKSUM_OFFSET]);
+
+	r_buffer.resize(writer.data.size());
+	memcpy(r_buffer.ptrw(), writer.data.ptr(), writer.data.size());
+	return OK;
+}
+
+Error GDScriptBytecodeCache::deserialize_class_tree(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader(p_buffer);
+	Error err = _read_header(reader, p_script, false);
+	if (err != OK) {
+		return err;
+	}
+	if (!_read_class_tree(reader, p_script)) {
+		return ERR_FILE_CORRUPT;
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader(p_buffer);
+	bool register_static = false;
+	Error err = _read_header(reader, p_script, false, nullptr, &register_static);
+	if (err != OK) {
+		return err;
+	}
+
+	p_script->_owner = nullptr;
+	if (!_read_class_tree(reader, p_script) || !_read_class(reader, p_script)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (register_static) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+Error GDScriptBytecodeCache::save(GDScript *p_script) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	const String &path = p_script->path;
+	if (!path.is_resource_file()) {
+		// Built-in scripts are saved with their owner resource.
+		return ERR_UNAVAILABLE;
+	}
+
+	Vector<Dependency> dependencies;
+	Error err = GDScriptCache::get_bytecode_dependencies(path, dependencies);
+	if (err != OK) {
+		return err;
+	}
+
+	Vector<uint8_t> buffer;
+	err = serialize(p_script, dependencies, buffer);
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: Not caching bytecode of "%s", it holds values which can't be stored.)", path));
+		return err;
+	}
+
+	String cache_path = get_cache_path(path);
+	err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	if (err != OK) {
+		return err;
+	}
+
+	// Written to a temporary file first, so other processes never see it partially written.
+	String temp_path = cache_path + "." + itos(OS::get_singleton()->get_process_id()) + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		if (f.is_null()) {
+			return err;
+		}
+		f->store_buffer(buffer.ptr(), buffer.size());
+		err = f->get_error();
+	}
+	Ref<DirAccess> da = DirAccess::create_for_path(cache_path);
+	if (err == OK) {
+		err = da->rename(temp_path, cache_path);
+	}
+	if (err != OK) {
+		da->remove(temp_path);
+	}
+	return err;
+}
+
+Error GDScriptBytecodeCache::load_buffer(const GDScript *p_script, Vector<uint8_t> &r_buffer, Vector<String> *r_dependencies) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	if (!p_script->path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	String cache_path = get_cache_path(p_script->path);
+	if (!FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	r_buffer = FileAccess::get_file_as_bytes(cache_path, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	err = check_buffer(p_script, r_buffer, r_dependencies);
+	if (err != OK) {
+		r_buffer.clear();
+	}
+	return err;
+}
+
+Error GDScriptBytecodeCache::check_buffer(const GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<String> *r_dependencies) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader(p_buffer);
+	return _read_header(reader, p_script, true, r_dependencies);
+}
+
+void GDScriptBytecodeCache::finish() {
+	MutexLock lock(mutex);
+
+	if (symbols) {
+		memdelete(symbols);
+		symbols = nullptr;
+	}
+	global_objects.clear();
+	global_objects_size = -1;
+	globals_fingerprint_size = -1;
+	engine_fingerprint = String();
+}
@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/pair.h"
+#include "core/variant/variant.h"
+
+// Stores compiled scripts on disk so later runs can skip parsing, analysis
+// and compilation. The bytecode itself only holds indices, so a function is
+// saved as its code plus its tables, with every native pointer in those
+// tables replaced by the symbol it was resolved from (operator and types,
+// member name, class and method...) and resolved again when loading.
+//
+// A cache file is only used if it's intact, was made by the same engine build
+// with the same GDExtensions and global identifiers, and if neither the script
+// nor any script it transitively depends on changed since. The bytecode is also
+// checked to only reference what its tables hold before being used, since the
+// VM trusts it in release builds.
+class GDScriptBytecodeCache {
+public:
+	struct Dependency {
+		String path;
+		String source_hash;
+	};
+
+private:
+	enum {
+		FORMAT_VERSION = 8,
+		HEADER_CHECKSUM_OFFSET = 8, // After the magic and the version, covers everything that follows it.
+	};
+
+	enum VariantTag {
+		VARIANT_TAG_PLAIN,
+		VARIANT_TAG_ARRAY,
+		VARIANT_TAG_DICTIONARY,
+		VARIANT_TAG_NULL_OBJECT,
+		VARIANT_TAG_GLOBAL,
+		VARIANT_TAG_SCRIPT,
+		VARIANT_TAG_RESOURCE,
+		VARIANT_TAG_PACKED_SCENE,
+	};
+
+	struct Writer;
+	struct Reader;
+
+	struct PointerHasher {
+		template <class T>
+		static _FORCE_INLINE_ uint32_t hash(const T p_pointer) { return hash_one_uint64((uint64_t)(uintptr_t)p_pointer); }
+	};
+
+	struct OperatorSymbol {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left = Variant::NIL;
+		Variant::Type right = Variant::NIL;
+	};
+
+	// Reverse lookups from the pointers stored in the function tables back to
+	// the symbols they were resolved from. Built once, on first save.
+	struct Symbols {
+		HashMap<Variant::ValidatedOperatorEvaluator, OperatorSymbol, PointerHasher> operators;
+		HashMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>, PointerHasher> setters;
+		HashMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>, PointerHasher> getters;
+		HashMap<Variant::ValidatedKeyedSetter, Variant::Type, PointerHasher> keyed_setters;
+		HashMap<Variant::ValidatedKeyedGetter, Variant::Type, PointerHasher> keyed_getters;
+		HashMap<Variant::ValidatedIndexedSetter, Variant::Type, PointerHasher> indexed_setters;
+		HashMap<Variant::ValidatedIndexedGetter, Variant::Type, PointerHasher> indexed_getters;
+		HashMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>, PointerHasher> builtin_methods;
+		HashMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>, PointerHasher> constructors;
+		HashMap<Variant::ValidatedUtilityFunction, StringName, PointerHasher> utilities;
+		HashMap<GDScriptUtilityFunctions::FunctionPtr, StringName, PointerHasher> gds_utilities;
+	};
+
+	static Mutex mutex;
+	static Symbols *symbols;
+	static HashMap<ObjectID, StringName> global_objects;
+	static int global_objects_size;
+	static uint64_t globals_fingerprint;
+	static int globals_fingerprint_size;
+	static String engine_fingerprint;
+
+	static const Symbols &_get_symbols();
+	static StringName _get_global_name(const Object *p_object);
+	static uint64_t _get_globals_fingerprint();
+	static String _get_engine_fingerprint();
+
+	static void _update_function_pointers(GDScriptFunction *p_function);
+	static bool _validate_function(const GDScriptFunction *p_function, int p_member_count);
+
+	static bool _write_variant(Writer &p_writer, const Variant &p_value, const GDScript *p_owner);
+	static bool _write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_owner);
+	static bool _write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info, const GDScript *p_owner);
+	static bool _write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_owner);
+	static void _write_class_tree(Writer &p_writer, const GDScript *p_class);
+	static bool _write_class(Writer &p_writer, const GDScript *p_class);
+
+	static bool _read_variant(Reader &p_reader, Variant &r_value, GDScript *p_owner);
+	static bool _read_data_type(Reader &p_reader, GDScriptDataType &r_type, GDScript *p_owner);
+	static bool _read_member_info(Reader &p_reader, GDScript::MemberInfo &r_info, GDScript *p_owner);
+	static bool _read_function_data(Reader &p_reader, GDScriptFunction *p_function, GDScript *p_owner);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_owner);
+	static bool _read_class_tree(Reader &p_reader, GDScript *p_class);
+	static bool _read_class(Reader &p_reader, GDScript *p_class);
+
+	static Error _read_header(Reader &p_reader, const GDScript *p_script, bool p_validate, Vector<String> *r_dependencies = nullptr, bool *r_register_static = nullptr);
+
+public:
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+
+	// Buffers passed to the deserialize functions must come from serialize() or load_buffer().
+	static Error serialize(const GDScript *p_script, const Vector<Dependency> &p_dependencies, Vector<uint8_t> &r_buffer);
+	// Only fills the inner class tree of `p_script`, so it can be referenced before being fully loaded.
+	static Error deserialize_class_tree(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+
+	static Error save(GDScript *p_script);
+	// Reads the cache file of `p_script` and checks it is still up to date.
+	static Error load_buffer(const GDScript *p_script, Vector<uint8_t> &r_buffer, Vector<String> *r_dependencies = nullptr);
+	// Checks a buffer is intact and still up to date for `p_script`, as load_buffer() does with the file contents.
+	static Error check_buffer(const GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<String> *r_dependencies = nullptr);
+
+	static void finish();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -0,0 +1,330 @@
+/**************************************************************************/
+/*  gdscript_bytecode_optimizer.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_optimizer.h"
+
+#include "gdscript_function.h"
+
+#include "core/config/project_settings.h"
+#include "core/templates/local_vector.h"
+
+bool GDScriptBytecodeOptimizer::verification_mode = false;
+
+int GDScriptBytecodeOptimizer::_get_jump_operand(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 2;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return 5;
+		default:
+			break;
+	}
+
+	// Every iterate instruction jumps to the end of the loop once done.
+	if (p_opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && p_opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+		return 4;
+	}
+	return -1;
+}
+
+bool GDScriptBytecodeOptimizer::_is_terminator(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_END:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptBytecodeOptimizer::_verify(const Vector<int> &p_code, const Vector<int> &p_instructions, const Vector<int> &p_default_arguments) {
+	const int code_size = p_code.size();
+	const int instruction_count = p_instructions.size();
+	ERR_FAIL_COND_V(instruction_count == 0 || p_instructions[0] != 0, false);
+	ERR_FAIL_COND_V(p_code[p_instructions[instruction_count - 1]] != GDScriptFunction::OPCODE_END, false);
+
+	// The end of the code is a valid jump destination too.
+	LocalVector<bool> is_instruction;
+	is_instruction.resize(code_size + 1);
+	for (int i = 0; i < code_size; i++) {
+		is_instruction[i] = false;
+	}
+	is_instruction[code_size] = true;
+
+	for (int i = 0; i < instruction_count; i++) {
+		const int end = i + 1 < instruction_count ? p_instructions[i + 1] : code_size;
+		ERR_FAIL_COND_V(p_instructions[i] >= end || end > code_size, false);
+		is_instruction[p_instructions[i]] = true;
+	}
+
+	for (int i = 0; i < instruction_count; i++) {
+		const int pos = p_instructions[i];
+		const int end = i + 1 < instruction_count ? p_instructions[i + 1] : code_size;
+		const int operand = _get_jump_operand(p_code[pos]);
+		if (operand < 0) {
+			continue;
+		}
+		ERR_FAIL_COND_V(pos + operand >= end, false);
+		const int target = p_code[pos + operand];
+		ERR_FAIL_COND_V(target < 0 || target > code_size || !is_instruction[target], false);
+	}
+
+	for (int i = 0; i < p_default_arguments.size(); i++) {
+		const int target = p_default_arguments[i];
+		ERR_FAIL_COND_V(target < 0 || target > code_size || !is_instruction[target], false);
+	}
+
+	return true;
+}
+
+bool GDScriptBytecodeOptimizer::is_enabled() {
+	if (verification_mode) {
+		return true;
+	}
+
+	switch (int(GLOBAL_GET("gdscript/optimizer/mode"))) {
+		case MODE_RELEASE_ONLY:
+#ifdef DEBUG_ENABLED
+			return false;
+#else
+			return true;
+#endif
+		case MODE_ALWAYS:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptBytecodeOptimizer::optimize(Vector<int> &r_code, Vector<int> &r_instructions, Vector<int> &r_default_arguments) {
+	// Only work on code that can be fully understood.
+	if (!_verify(r_code, r_instructions, r_default_arguments)) {
+		return false;
+	}
+
+	Vector<int> code = r_code;
+	int *code_ptr = code.ptrw();
+	const int code_size = code.size();
+	const int *instructions = r_instructions.ptr();
+	const int instruction_count = r_instructions.size();
+	bool changed = false;
+
+	// Maps positions to instruction indices, with the end of the code as an extra one.
+	LocalVector<int> instruction_at;
+	instruction_at.resize(code_size + 1);
+	for (int i = 0; i < code_size; i++) {
+		instruction_at[i] = -1;
+	}
+	for (int i = 0; i < instruction_count; i++) {
+		instruction_at[instructions[i]] = i;
+	}
+	instruction_at[code_size] = instruction_count;
+
+	// Jumps that land on an unconditional jump can go to its destination directly.
+	for (int i = 0; i < instruction_count; i++) {
+		const int pos = instructions[i];
+		const int operand = _get_jump_operand(code_ptr[pos]);
+		if (operand < 0) {
+			continue;
+		}
+		int target = code_ptr[pos + operand];
+		for (int hops = 0; hops < MAX_JUMP_THREADING && target < code_size && code_ptr[target] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			target = code_ptr[target + 1];
+		}
+		if (target != code_ptr[pos + operand]) {
+			code_ptr[pos + operand] = target;
+			changed = true;
+		}
+	}
+
+	LocalVector<bool> is_target;
+	is_target.resize(code_size + 1);
+	for (int i = 0; i <= code_size; i++) {
+		is_target[i] = false;
+	}
+	for (int i = 0; i < instruction_count; i++) {
+		const int operand = _get_jump_operand(code_ptr[instructions[i]]);
+		if (operand >= 0) {
+			is_target[code_ptr[instructions[i] + operand]] = true;
+		}
+	}
+	for (int i = 0; i < r_default_arguments.size(); i++) {
+		is_target[r_default_arguments[i]] = true;
+	}
+
+	// Nothing falls through a jump or a return, so what follows them can only run if jumped to.
+	// The last OPCODE_END is always kept so the code never runs past its end.
+	LocalVector<bool> removed;
+	removed.resize(instruction_count);
+	bool reachable = true;
+	for (int i = 0; i < instruction_count; i++) {
+		const int pos = instructions[i];
+		if (is_target[pos]) {
+			reachable = true;
+		}
+		if (!reachable && i < instruction_count - 1) {
+			removed[i] = true;
+			changed = true;
+			continue;
+		}
+		removed[i] = false;
+		if (_is_terminator(code_ptr[pos])) {
+			reachable = false;
+		}
+	}
+
+	// Unconditional jumps to the next instruction that is kept do nothing. Going backwards so
+	// chains of them all go.
+	for (int i = instruction_count - 1; i >= 0; i--) {
+		const int pos = instructions[i];
+		if (removed[i] || code_ptr[pos] != GDScriptFunction::OPCODE_JUMP) {
+			continue;
+		}
+		const int target_index = instruction_at[code_ptr[pos + 1]];
+		if (target_index <= i) {
+			continue;
+		}
+		bool skips_code = false;
+		for (int j = i + 1; j < target_index; j++) {
+			if (!removed[j]) {
+				skips_code = true;
+				break;
+			}
+		}
+		if (!skips_code) {
+			removed[i] = true;
+			changed = true;
+		}
+	}
+
+	// Conditions are usually a comparison stored in a temporary and tested right away. Do both
+	// in one instruction, as long as nothing jumps in between them. The result is still stored,
+	// so any later use of it is unaffected.
+	LocalVector<int> fused;
+	fused.resize(instruction_count);
+	for (int i = 0; i < instruction_count; i++) {
+		fused[i] = -1;
+		if (i + 1 >= instruction_count || removed[i] || removed[i + 1]) {
+			continue;
+		}
+		const int pos = instructions[i];
+		const int next = instructions[i + 1];
+		if (code_ptr[pos] != GDScriptFunction::OPCODE_OPERATOR_VALIDATED || is_target[next] || code_ptr[next + 1] != code_ptr[pos + 3]) {
+			continue;
+		}
+		if (code_ptr[next] == GDScriptFunction::OPCODE_JUMP_IF) {
+			fused[i] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+		} else if (code_ptr[next] == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+			fused[i] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+		} else {
+			continue;
+		}
+		removed[i + 1] = true;
+		changed = true;
+	}
+
+	if (!changed) {
+		return false;
+	}
+
+	// Removed instructions are mapped to the next one that is kept.
+	LocalVector<int> new_positions;
+	new_positions.resize(instruction_count + 1);
+	int new_code_size = 0;
+	int new_instruction_count = 0;
+	for (int i = 0; i < instruction_count; i++) {
+		new_positions[i] = new_code_size;
+		if (removed[i]) {
+			continue;
+		}
+		const int end = i + 1 < instruction_count ? instructions[i + 1] : code_size;
+		new_code_size += fused[i] >= 0 ? 6 : end - instructions[i];
+		new_instruction_count++;
+	}
+	new_positions[instruction_count] = new_code_size;
+
+	Vector<int> new_code;
+	new_code.resize(new_code_size);
+	int *new_code_ptr = new_code.ptrw();
+	Vector<int> new_instructions;
+	new_instructions.resize(new_instruction_count);
+	int *new_instructions_ptr = new_instructions.ptrw();
+
+	int instruction_idx = 0;
+	for (int i = 0; i < instruction_count; i++) {
+		if (removed[i]) {
+			continue;
+		}
+		const int pos = instructions[i];
+		const int new_pos = new_positions[i];
+		new_instructions_ptr[instruction_idx++] = new_pos;
+
+		if (fused[i] >= 0) {
+			// Operands of the operator, then the destination of the jump.
+			new_code_ptr[new_pos] = fused[i];
+			for (int j = 1; j < 5; j++) {
+				new_code_ptr[new_pos + j] = code_ptr[pos + j];
+			}
+			new_code_ptr[new_pos + 5] = code_ptr[instructions[i + 1] + 2];
+		} else {
+			const int end = i + 1 < instruction_count ? instructions[i + 1] : code_size;
+			for (int j = pos; j < end; j++) {
+				new_code_ptr[new_pos + j - pos] = code_ptr[j];
+			}
+		}
+
+		const int operand = _get_jump_operand(new_code_ptr[new_pos]);
+		if (operand >= 0) {
+			new_code_ptr[new_pos + operand] = new_positions[instruction_at[new_code_ptr[new_pos + operand]]];
+		}
+	}
+
+	Vector<int> new_default_arguments = r_default_arguments;
+	for (int i = 0; i < new_default_arguments.size(); i++) {
+		new_default_arguments.write[i] = new_positions[instruction_at[new_default_arguments[i]]];
+	}
+
+	ERR_FAIL_COND_V_MSG(!_verify(new_code, new_instructions, new_default_arguments), false, "Optimized GDScript bytecode failed verification, keeping the original code.");
+
+	r_code = new_code;
+	r_instructions = new_instructions;
+	r_default_arguments = new_default_arguments;
+	return true;
+}
@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  gdscript_bytecode_optimizer.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_OPTIMIZER_H
+#define GDSCRIPT_BYTECODE_OPTIMIZER_H
+
+#include "core/templates/vector.h"
+
+// Rewrites the bytecode of a function after the code generator is done with
+// it, before it's handed to the GDScriptFunction. Only rewrites that keep the
+// exact behavior of the original code are made:
+//
+// - Jumps that land on an unconditional jump go straight to its destination.
+// - Unconditional jumps to the next instruction are removed.
+// - Instructions that can't be reached (after a jump or a return, until the
+//   next jump destination) are removed.
+// - A validated operator followed by a conditional jump on its result is
+//   fused into a single instruction.
+//
+// Operands are only decoded for jump destinations, any other instruction is
+// copied as is. The result is checked before being used, and the original
+// code is kept if anything looks wrong.
+class GDScriptBytecodeOptimizer {
+public:
+	enum Mode {
+		MODE_DISABLED,
+		MODE_RELEASE_ONLY,
+		MODE_ALWAYS,
+	};
+
+private:
+	enum {
+		MAX_JUMP_THREADING = 16,
+	};
+
+	static bool verification_mode;
+
+	static int _get_jump_operand(int p_opcode);
+	static bool _is_terminator(int p_opcode);
+	static bool _verify(const Vector<int> &p_code, const Vector<int> &p_instructions, const Vector<int> &p_default_arguments);
+
+public:
+	static bool is_enabled();
+
+	// Makes every function go through the optimizer regardless of the project
+	// settings, so running the test scripts checks the optimized code behaves
+	// like the original one.
+	static void set_verification_mode(bool p_enabled) { verification_mode = p_enabled; }
+	static bool is_verification_mode() { return verification_mode; }
+
+	// `r_instructions` holds the position of every instruction in `r_code`.
+	// Everything is updated in place, and left untouched if nothing could be
+	// optimized.
+	static bool optimize(Vector<int> &r_code, Vector<int> &r_instructions, Vector<int> &r_default_arguments);
+};
+
+#endif // GDSCRIPT_BYTECODE_OPTIMIZER_H
@@ -36,6 +36,9 @@
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 #include "scene/resources/packed_scene.h"
 
@@ -51,6 +54,10 @@ GDScriptParser *GDScriptParserRef::get_parser() const {
 	return parser;
 }
 
+uint32_t GDScriptParserRef::get_source_hash() const {
+	return source_hash;
+}
+
 GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 	if (analyzer == nullptr) {
 		analyzer = memnew(GDScriptAnalyzer(parser));
@@ -67,27 +74,37 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 
 	while (p_new_status > status) {
 		switch (status) {
-			case EMPTY:
+			case EMPTY: {
 				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
-				break;
+				String source = GDScriptCache::get_source_code(path);
+				source_hash = source.hash();
+				uint64_t start = OS::get_singleton()->get_ticks_usec();
+				result = parser->parse(source, path, false);
+				GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_PARSE, OS::get_singleton()->get_ticks_usec() - start);
+			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
+				uint64_t start = OS::get_singleton()->get_ticks_usec();
 				Error inheritance_result = get_analyzer()->resolve_inheritance();
+				GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_ANALYZE, OS::get_singleton()->get_ticks_usec() - start);
 				if (result == OK) {
 					result = inheritance_result;
 				}
 			} break;
 			case INHERITANCE_SOLVED: {
 				status = INTERFACE_SOLVED;
+				uint64_t start = OS::get_singleton()->get_ticks_usec();
 				Error interface_result = get_analyzer()->resolve_interface();
+				GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_ANALYZE, OS::get_singleton()->get_ticks_usec() - start);
 				if (result == OK) {
 					result = interface_result;
 				}
 			} break;
 			case INTERFACE_SOLVED: {
 				status = FULLY_SOLVED;
+				uint64_t start = OS::get_singleton()->get_ticks_usec();
 				Error body_result = get_analyzer()->resolve_body();
+				GDScriptCache::add_load_time(GDScriptCache::LOAD_PHASE_ANALYZE, OS::get_singleton()->get_ticks_usec() - start);
 				if (result == OK) {
 					result = body_result;
 				}
@@ -186,10 +203,14 @@ void GDScriptCache::remove_script(const String &p_path) {
 		singleton->parser_map[p_path]->clear();
 		singleton->parser_map.erase(p_path);
 	}
+	singleton->preparsed_parsers.erase(p_path);
 
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
+	singleton->bytecode_buffers.erase(p_path);
+	singleton->bytecode_dependencies.erase(p_path);
+	singleton->source_hashes.erase(p_path);
 }
 
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
@@ -204,6 +225,8 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 			r_error = ERR_INVALID_DATA;
 			return ref;
 		}
+		// From now on, kept alive by whoever requested it, as usual.
+		singleton->preparsed_parsers.erase(p_path);
 	} else {
 		if (!FileAccess::exists(p_path)) {
 			r_error = ERR_FILE_NOT_FOUND;
@@ -220,6 +243,15 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+Ref<GDScriptParserRef> GDScriptCache::get_cached_parser(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+	if (!singleton->parser_map.has(p_path)) {
+		return Ref<GDScriptParserRef>();
+	}
+	// May be null if it's being freed.
+	return Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
+}
+
 String GDScriptCache::get_source_code(const String &p_path) {
 	Vector<uint8_t> source_file;
 	Error err;
@@ -239,7 +271,29 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
+String GDScriptCache::get_source_hash(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	const String *cached_hash = singleton->source_hashes.getptr(p_path);
+	if (cached_hash) {
+		return *cached_hash;
+	}
+
+	if (!FileAccess::exists(p_path)) {
+		return String();
+	}
+
+	String hash = get_source_code(p_path).md5_text();
+	singleton->source_hashes[p_path] = hash;
+	return hash;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
+	Ref<GDScriptParserRef> parser_ref;
+	return _get_shallow_script(p_path, r_error, p_owner, parser_ref);
+}
+
+Ref<GDScript> GDScriptCache::_get_shallow_script(const String &p_path, Error &r_error, const String &p_owner, Ref<GDScriptParserRef> &r_parser_ref) {
 	MutexLock lock(singleton->mutex);
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
@@ -260,9 +314,24 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+	if (GDScriptBytecodeCache::is_enabled()) {
+		Vector<uint8_t> buffer;
+		Vector<String> bytecode_dependencies;
+		if (GDScriptBytecodeCache::load_buffer(script.ptr(), buffer, &bytecode_dependencies) == OK && GDScriptBytecodeCache::deserialize_class_tree(script.ptr(), buffer) == OK) {
+			// No need to parse, the rest is loaded from the buffer once the full script is needed.
+			HashSet<String> &script_dependencies = singleton->bytecode_dependencies[p_path];
+			for (const String &E : bytecode_dependencies) {
+				script_dependencies.insert(E);
+			}
+			singleton->bytecode_buffers[p_path] = buffer;
+			singleton->shallow_gdscript_cache[p_path] = script;
+			return script;
+		}
+	}
+
+	r_parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		GDScriptCompiler::make_scripts(script.ptr(), r_parser_ref->get_parser()->get_tree(), true);
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -277,6 +346,8 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	}
 
 	Ref<GDScript> script;
+	// Kept alive until the script is reloaded below, so it can compile from the same tree.
+	Ref<GDScriptParserRef> parser_ref;
 	r_error = OK;
 	if (singleton->full_gdscript_cache.has(p_path)) {
 		script = singleton->full_gdscript_cache[p_path];
@@ -286,7 +357,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	}
 
 	if (script.is_null()) {
-		script = get_shallow_script(p_path, r_error);
+		script = _get_shallow_script(p_path, r_error, String(), parser_ref);
 		if (r_error) {
 			return script;
 		}
@@ -331,6 +402,13 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 
 	HashSet<String> depends = singleton->dependencies[p_owner];
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		HashSet<String> &bytecode_depends = singleton->bytecode_dependencies[p_owner];
+		for (const String &E : depends) {
+			bytecode_depends.insert(E);
+		}
+	}
+
 	Error err = OK;
 	for (const String &E : depends) {
 		Error this_err = OK;
@@ -357,6 +435,159 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+Error GDScriptCache::get_bytecode_dependencies(const String &p_path, Vector<GDScriptBytecodeCache::Dependency> &r_dependencies) {
+	MutexLock lock(singleton->mutex);
+
+	// Collect every script the bytecode transitively depends on, since a change in
+	// any of them can change how this one compiles.
+	HashSet<String> visited;
+	List<String> pending;
+	visited.insert(p_path);
+	pending.push_back(p_path);
+
+	while (!pending.is_empty()) {
+		String current = pending.front()->get();
+		pending.pop_front();
+
+		const HashSet<String> *depends = singleton->bytecode_dependencies.getptr(current);
+		if (!depends) {
+			// Not compiled in this run, so what it depends on is unknown.
+			return ERR_UNAVAILABLE;
+		}
+
+		for (const String &E : *depends) {
+			if (visited.has(E)) {
+				continue;
+			}
+			visited.insert(E);
+			pending.push_back(E);
+
+			GDScriptBytecodeCache::Dependency dependency;
+			dependency.path = E;
+			dependency.source_hash = get_source_hash(E);
+			if (dependency.source_hash.is_empty()) {
+				return ERR_FILE_NOT_FOUND;
+			}
+			r_dependencies.push_back(dependency);
+		}
+	}
+
+	return OK;
+}
+
+bool GDScriptCache::take_bytecode_buffer(const String &p_path, Vector<uint8_t> &r_buffer) {
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, Vector<uint8_t>>::Iterator E = singleton->bytecode_buffers.find(p_path);
+	if (!E) {
+		return false;
+	}
+
+	r_buffer = E->value;
+	singleton->bytecode_buffers.remove(E);
+	return true;
+}
+
+void GDScriptCache::_parse_script_task(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *parsers = (Ref<GDScriptParserRef> *)p_userdata;
+	parsers[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	LocalVector<Ref<GDScriptParserRef>> parsers;
+	{
+		MutexLock lock(singleton->mutex);
+		for (const String &path : p_paths) {
+			if (singleton->parser_map.has(path) || singleton->shallow_gdscript_cache.has(path) || singleton->full_gdscript_cache.has(path)) {
+				continue;
+			}
+			if (!FileAccess::exists(path)) {
+				continue;
+			}
+			if (GDScriptBytecodeCache::is_enabled() && FileAccess::exists(GDScriptBytecodeCache::get_cache_path(path))) {
+				continue; // Likely loaded from the bytecode cache without parsing.
+			}
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->parser = memnew(GDScriptParser);
+			ref->path = path;
+			parsers.push_back(ref);
+		}
+	}
+
+	if (parsers.is_empty()) {
+		return;
+	}
+
+	// Fills the lookup table it uses, which isn't safe to do from several threads at once.
+	GDScriptParser::get_builtin_type(StringName());
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+
+	// The parser only reads the source and global tables, so scripts don't depend on each other until analyzed.
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	if (parsers.size() < 2 || !wtp || wtp->get_thread_count() < 2) {
+		for (uint32_t i = 0; i < parsers.size(); i++) {
+			_parse_script_task(parsers.ptr(), i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = wtp->add_native_group_task(&_parse_script_task, parsers.ptr(), parsers.size(), -1, true, SNAME("GDScriptParse"));
+		wtp->wait_for_group_task_completion(group);
+	}
+
+	print_verbose(vformat("GDScript: Parsed %d scripts ahead in %.1f ms.", parsers.size(), (OS::get_singleton()->get_ticks_usec() - start) / 1000.0));
+
+	MutexLock lock(singleton->mutex);
+	for (Ref<GDScriptParserRef> &ref : parsers) {
+		if (singleton->parser_map.has(ref->path)) {
+			// Requested by another thread meanwhile. Clear the path so freeing this
+			// one doesn't remove the other from the map.
+			ref->path = String();
+			continue;
+		}
+		singleton->parser_map[ref->path] = ref.ptr();
+		singleton->preparsed_parsers[ref->path] = ref;
+	}
+}
+
+void GDScriptCache::release_preparsed_scripts() {
+	if (singleton == nullptr) {
+		return;
+	}
+	MutexLock lock(singleton->mutex);
+	singleton->preparsed_parsers.clear();
+}
+
+void GDScriptCache::add_load_time(LoadPhase p_phase, uint64_t p_usec) {
+	if (singleton == nullptr) {
+		return;
+	}
+	singleton->load_phase_usec[p_phase].add(p_usec);
+	singleton->load_phase_count[p_phase].increment();
+}
+
+uint64_t GDScriptCache::get_load_phase_count(LoadPhase p_phase) {
+	ERR_FAIL_INDEX_V(p_phase, LOAD_PHASE_MAX, 0);
+	return singleton->load_phase_count[p_phase].get();
+}
+
+String GDScriptCache::get_load_times_text() {
+	static const char *phase_names[LOAD_PHASE_MAX] = {
+		"parse",
+		"analyze",
+		"compile",
+	};
+
+	String text;
+	for (int i = 0; i < LOAD_PHASE_MAX; i++) {
+		if (i > 0) {
+			text += ", ";
+		}
+		text += vformat("%s %.1f ms (%d)", phase_names[i], singleton->load_phase_usec[i].get() / 1000.0, singleton->load_phase_count[i].get());
+	}
+	return text;
+}
+
 Ref<PackedScene> GDScriptCache::get_packed_scene(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -433,10 +664,14 @@ void GDScriptCache::clear() {
 	singleton->packed_scene_dependencies.clear();
 	singleton->packed_scene_cache.clear();
 
+	singleton->preparsed_parsers.clear();
 	parser_map_refs.clear();
 	singleton->parser_map.clear();
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
+	singleton->bytecode_buffers.clear();
+	singleton->bytecode_dependencies.clear();
+	singleton->source_hashes.clear();
 
 	singleton->packed_scene_cache.clear();
 	singleton->packed_scene_dependencies.clear();
@@ -32,11 +32,13 @@
 #define GDSCRIPT_CACHE_H
 
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 
 #include "core/object/ref_counted.h"
 #include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/resources/packed_scene.h"
 
 class GDScriptAnalyzer;
@@ -58,6 +60,7 @@ private:
 	Status status = EMPTY;
 	Error result = OK;
 	String path;
+	uint32_t source_hash = 0;
 	bool cleared = false;
 
 	friend class GDScriptCache;
@@ -66,6 +69,7 @@ public:
 	bool is_valid() const;
 	Status get_status() const;
 	GDScriptParser *get_parser() const;
+	uint32_t get_source_hash() const;
 	GDScriptAnalyzer *get_analyzer();
 	Error raise_status(Status p_new_status);
 	void clear();
@@ -75,16 +79,31 @@ public:
 };
 
 class GDScriptCache {
+public:
+	enum LoadPhase {
+		LOAD_PHASE_PARSE, // Includes tokenizing, which is done as the parser goes.
+		LOAD_PHASE_ANALYZE,
+		LOAD_PHASE_COMPILE,
+		LOAD_PHASE_MAX,
+	};
+
+private:
 	// String key is full path.
 	HashMap<String, GDScriptParserRef *> parser_map;
+	// Parsed ahead of time by parse_scripts(), kept alive until first requested.
+	HashMap<String, Ref<GDScriptParserRef>> preparsed_parsers;
 	HashMap<String, Ref<GDScript>> shallow_gdscript_cache;
 	HashMap<String, Ref<GDScript>> full_gdscript_cache;
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, Ref<PackedScene>> packed_scene_cache;
 	HashMap<String, HashSet<String>> packed_scene_dependencies;
+	HashMap<String, Vector<uint8_t>> bytecode_buffers;
+	HashMap<String, HashSet<String>> bytecode_dependencies;
+	HashMap<String, String> source_hashes;
 
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -94,11 +113,22 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	// Time spent in each phase, in microseconds, and how many times it ran.
+	// Updated from any thread.
+	SafeNumeric<uint64_t> load_phase_usec[LOAD_PHASE_MAX];
+	SafeNumeric<uint64_t> load_phase_count[LOAD_PHASE_MAX];
+
+	static void _parse_script_task(void *p_userdata, uint32_t p_index);
+	static Ref<GDScript> _get_shallow_script(const String &p_path, Error &r_error, const String &p_owner, Ref<GDScriptParserRef> &r_parser_ref);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
+	// Returns the parser of the given script if one is in use, without parsing it.
+	static Ref<GDScriptParserRef> get_cached_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
+	static String get_source_hash(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
@@ -106,6 +136,22 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static Error get_bytecode_dependencies(const String &p_path, Vector<GDScriptBytecodeCache::Dependency> &r_dependencies);
+	static bool take_bytecode_buffer(const String &p_path, Vector<uint8_t> &r_buffer);
+
+	// Parses the given scripts in parallel on the WorkerThreadPool, so loading
+	// them later doesn't have to. Scripts that are already loaded or parsed are
+	// skipped. Only parsing is done ahead: the analyzer resolves dependencies
+	// through the cache as it goes, so analysis and compilation still happen in
+	// dependency order when the scripts are loaded.
+	static void parse_scripts(const Vector<String> &p_paths);
+	// Frees what parse_scripts() parsed but nothing requested since.
+	static void release_preparsed_scripts();
+
+	static void add_load_time(LoadPhase p_phase, uint64_t p_usec);
+	static uint64_t get_load_phase_count(LoadPhase p_phase);
+	static String get_load_times_text();
+
 	static Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error, const String &p_owner = "");
 	static void clear_unreferenced_packed_scenes();
 
@@ -69,6 +69,47 @@ bool GDScriptCompiler::_is_local_or_parameter(CodeGen &codegen, const StringName
 	return codegen.parameters.has(p_name) || codegen.locals.has(p_name);
 }
 
+// Returns the `create_timer()` call if `p_awaited` is `<SceneTree>.create_timer(...).timeout`
+// with arguments statically known to match the method, so it can use OPCODE_AWAIT_TIMER.
+const GDScriptParser::CallNode *GDScriptCompiler::_get_await_timer_call(const GDScriptParser::ExpressionNode *p_awaited) {
+	if (p_awaited == nullptr || p_awaited->type != GDScriptParser::Node::SUBSCRIPT) {
+		return nullptr;
+	}
+	const GDScriptParser::SubscriptNode *signal = static_cast<const GDScriptParser::SubscriptNode *>(p_awaited);
+	if (!signal->is_attribute || signal->attribute->name != SNAME("timeout") || signal->base->type != GDScriptParser::Node::CALL) {
+		return nullptr;
+	}
+
+	const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(signal->base);
+	if (call->is_super || call->function_name != SNAME("create_timer") || call->callee == nullptr || call->callee->type != GDScriptParser::Node::SUBSCRIPT) {
+		return nullptr;
+	}
+	const GDScriptParser::SubscriptNode *callee = static_cast<const GDScriptParser::SubscriptNode *>(call->callee);
+	if (!callee->is_attribute) {
+		return nullptr;
+	}
+
+	const GDScriptParser::DataType tree_type = callee->base->get_datatype();
+	if (!tree_type.is_hard_type() || tree_type.kind != GDScriptParser::DataType::NATIVE || tree_type.native_type != SNAME("SceneTree")) {
+		return nullptr;
+	}
+
+	if (call->arguments.size() < 1 || call->arguments.size() > 4) {
+		return nullptr;
+	}
+	for (int i = 0; i < call->arguments.size(); i++) {
+		const GDScriptParser::DataType arg_type = call->arguments[i]->get_datatype();
+		if (!arg_type.is_hard_type() || arg_type.kind != GDScriptParser::DataType::BUILTIN) {
+			return nullptr;
+		}
+		if (i == 0 ? (arg_type.builtin_type != Variant::FLOAT && arg_type.builtin_type != Variant::INT) : arg_type.builtin_type != Variant::BOOL) {
+			return nullptr;
+		}
+	}
+
+	return call;
+}
+
 void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::Node *p_node) {
 	if (!error.is_empty()) {
 		return;
@@ -599,6 +640,11 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 						} else {
 							if (is_awaited) {
 								gen->write_call_self_async(result, call->function_name, arguments);
+							} else if (call->function_name != SNAME("_ready")) {
+								// Script function, call it directly.
+								GDScriptCodeGenerator::Address self;
+								self.mode = GDScriptCodeGenerator::Address::SELF;
+								gen->write_call_script_function(result, self, call->function_name, arguments);
 							} else {
 								gen->write_call_self(result, call->function_name, arguments);
 							}
@@ -638,6 +684,9 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 											// Not exact arguments, but still can use method bind call.
 											gen->write_call_method_bind(result, base, method, arguments);
 										}
+									} else if (base.type.kind == GDScriptDataType::GDSCRIPT && !subscript->base->get_datatype().is_meta_type && call->function_name != SNAME("_ready")) {
+										// Script function on a script instance, call it directly.
+										gen->write_call_script_function(result, base, call->function_name, arguments);
 									} else {
 										gen->write_call(result, base, call->function_name, arguments);
 									}
@@ -692,6 +741,46 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 			const GDScriptParser::AwaitNode *await = static_cast<const GDScriptParser::AwaitNode *>(p_expression);
 
 			GDScriptCodeGenerator::Address result = codegen.add_temporary(_gdtype_from_datatype(p_expression->get_datatype(), codegen.script));
+
+			// `await <SceneTree>.create_timer(...).timeout` skips the timer object and its signal.
+			const GDScriptParser::CallNode *timer_call = _get_await_timer_call(await->to_await);
+			if (timer_call != nullptr) {
+				const GDScriptParser::SubscriptNode *callee = static_cast<const GDScriptParser::SubscriptNode *>(timer_call->callee);
+				GDScriptCodeGenerator::Address tree = _parse_expression(codegen, r_error, callee->base);
+				if (r_error) {
+					return GDScriptCodeGenerator::Address();
+				}
+
+				// Defaults of `SceneTree.create_timer()`.
+				static const bool default_flags[3] = { true, false, false };
+
+				Vector<GDScriptCodeGenerator::Address> arguments;
+				for (int i = 0; i < 4; i++) {
+					if (i < timer_call->arguments.size()) {
+						GDScriptCodeGenerator::Address argument = _parse_expression(codegen, r_error, timer_call->arguments[i]);
+						if (r_error) {
+							return GDScriptCodeGenerator::Address();
+						}
+						arguments.push_back(argument);
+					} else {
+						arguments.push_back(codegen.add_constant(default_flags[i - 1]));
+					}
+				}
+
+				gen->write_await_timer(result, tree, arguments);
+
+				for (int i = 0; i < arguments.size(); i++) {
+					if (arguments[i].mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+						gen->pop_temporary();
+					}
+				}
+				if (tree.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+					gen->pop_temporary();
+				}
+
+				return result;
+			}
+
 			GDScriptParser::ExpressionNode *previous_awaited_node = awaited_node;
 			awaited_node = await->to_await;
 			GDScriptCodeGenerator::Address argument = _parse_expression(codegen, r_error, await->to_await);
@@ -2499,6 +2588,11 @@ Error GDScriptCompiler::_populate_class_members(GDScript *p_script, const GDScri
 
 	p_script->clearing = true;
 
+	// Recompiling, functions may have cached what the old members resolved to.
+	if (p_script->implicit_initializer || !p_script->member_functions.is_empty() || !p_script->member_indices.is_empty()) {
+		GDScriptFunction::invalidate_inline_caches();
+	}
+
 	p_script->native = Ref<GDScriptNativeClass>();
 	p_script->base = Ref<GDScript>();
 	p_script->_base = nullptr;
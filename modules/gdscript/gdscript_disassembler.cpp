@@ -140,6 +140,29 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_INLINE(m_op, m_type)               \
+	case OPCODE_OPERATOR_##m_op##_##m_type: {                   \
+		text += "operator (typed ";                             \
+		text += #m_type;                                        \
+		text += ") ";                                           \
+		text += DADDR(3);                                       \
+		text += " = ";                                          \
+		text += DADDR(1);                                       \
+		text += " ";                                            \
+		text += Variant::get_operator_name(Variant::OP_##m_op); \
+		text += " ";                                            \
+		text += DADDR(2);                                       \
+		incr += 4;                                              \
+	} break
+
+				DISASSEMBLE_OPERATOR_INLINE(ADD, INT);
+				DISASSEMBLE_OPERATOR_INLINE(SUBTRACT, INT);
+				DISASSEMBLE_OPERATOR_INLINE(MULTIPLY, INT);
+				DISASSEMBLE_OPERATOR_INLINE(ADD, FLOAT);
+				DISASSEMBLE_OPERATOR_INLINE(SUBTRACT, FLOAT);
+				DISASSEMBLE_OPERATOR_INLINE(MULTIPLY, FLOAT);
+				DISASSEMBLE_OPERATOR_INLINE(DIVIDE, FLOAT);
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -258,6 +281,67 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_GET_INDEXED(m_type) \
+	case OPCODE_GET_INDEXED_##m_type: { \
+		text += "get indexed (typed ";  \
+		text += #m_type;                \
+		text += ") ";                   \
+		text += DADDR(3);               \
+		text += " = ";                  \
+		text += DADDR(1);               \
+		text += "[";                    \
+		text += DADDR(2);               \
+		text += "]";                    \
+		incr += 4;                      \
+	} break
+
+#define DISASSEMBLE_SET_INDEXED(m_type) \
+	case OPCODE_SET_INDEXED_##m_type: { \
+		text += "set indexed (typed ";  \
+		text += #m_type;                \
+		text += ") ";                   \
+		text += DADDR(1);               \
+		text += "[";                    \
+		text += DADDR(2);               \
+		text += "] = ";                 \
+		text += DADDR(3);               \
+		incr += 4;                      \
+	} break
+
+#define DISASSEMBLE_INDEXED_ARRAY_TYPES(m_macro) \
+	m_macro(ARRAY);                              \
+	m_macro(PACKED_BYTE_ARRAY);                  \
+	m_macro(PACKED_INT32_ARRAY);                 \
+	m_macro(PACKED_INT64_ARRAY);                 \
+	m_macro(PACKED_FLOAT32_ARRAY);               \
+	m_macro(PACKED_FLOAT64_ARRAY);               \
+	m_macro(PACKED_STRING_ARRAY);                \
+	m_macro(PACKED_VECTOR2_ARRAY);               \
+	m_macro(PACKED_VECTOR3_ARRAY);               \
+	m_macro(PACKED_COLOR_ARRAY)
+
+				DISASSEMBLE_INDEXED_ARRAY_TYPES(DISASSEMBLE_GET_INDEXED);
+				DISASSEMBLE_INDEXED_ARRAY_TYPES(DISASSEMBLE_SET_INDEXED);
+			case OPCODE_ARRAY_SIZE: {
+				text += "array size ";
+				text += DADDR(2);
+				text += " = ";
+				text += DADDR(1);
+
+				incr += 3;
+			} break;
+			case OPCODE_ARRAY_APPEND: {
+				text += "array append ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += ".append(";
+				text += DADDR(2);
+				text += ")";
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -266,7 +350,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -287,7 +371,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -589,7 +673,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -859,12 +943,48 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 4 + argc;
 			} break;
+			case OPCODE_CALL_SCRIPT_FUNCTION: {
+				int instr_var_args = _code_ptr[++ip];
+
+				text += "call-script-function ";
+
+				int argc = _code_ptr[ip + 1 + instr_var_args];
+				text += DADDR(2 + argc) + " = ";
+
+				text += DADDR(1 + argc) + ".";
+				text += String(_global_names_ptr[_code_ptr[ip + 2 + instr_var_args]]);
+				text += "(";
+
+				for (int i = 0; i < argc; i++) {
+					if (i > 0) {
+						text += ", ";
+					}
+					text += DADDR(1 + i);
+				}
+				text += ")";
+
+				incr = 6 + argc;
+			} break;
 			case OPCODE_AWAIT: {
 				text += "await ";
 				text += DADDR(1);
 
 				incr = 2;
 			} break;
+			case OPCODE_AWAIT_TIMER: {
+				text += "await timer ";
+				text += DADDR(1);
+				text += ".create_timer(";
+				for (int i = 0; i < 4; i++) {
+					if (i > 0) {
+						text += ", ";
+					}
+					text += DADDR(2 + i);
+				}
+				text += ")";
+
+				incr = 6;
+			} break;
 			case OPCODE_AWAIT_RESUME: {
 				text += "await resume ";
 				text += DADDR(1);
@@ -946,6 +1066,21 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF ? ", jump-if to " : ", jump-if-not to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
 			case OPCODE_RETURN: {
 				text += "return ";
 				text += DADDR(1);
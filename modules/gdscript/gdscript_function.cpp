@@ -31,6 +31,7 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_sampling_profiler.h"
 
 const int *GDScriptFunction::get_code() const {
 	return _code_ptr;
@@ -138,6 +139,17 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch;
+Mutex GDScriptFunction::inline_cache_mutex;
+
+void GDScriptFunction::_init_inline_caches(int p_count) {
+	ERR_FAIL_COND(_inline_caches != nullptr);
+	_inline_cache_count = p_count;
+	if (p_count > 0) {
+		_inline_caches = memnew_arr(InlineCache, p_count);
+	}
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -149,6 +161,10 @@ GDScriptFunction::GDScriptFunction() {
 }
 
 GDScriptFunction::~GDScriptFunction() {
+	if (GDScriptSamplingProfiler::is_active()) {
+		GDScriptSamplingProfiler::function_freed(this);
+	}
+
 	get_script()->member_functions.erase(name);
 
 	for (int i = 0; i < lambdas.size(); i++) {
@@ -160,6 +176,19 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	for (int i = 0; i < _inline_cache_count; i++) {
+		const InlineCacheState *state = _inline_caches[i].state.load(std::memory_order_acquire);
+		if (state) {
+			memdelete(const_cast<InlineCacheState *>(state));
+		}
+	}
+	for (const InlineCacheState *state : retired_inline_cache_states) {
+		memdelete(const_cast<InlineCacheState *>(state));
+	}
+	if (_inline_caches) {
+		memdelete_arr(_inline_caches);
+	}
+
 #ifdef DEBUG_ENABLED
 
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
@@ -168,6 +197,73 @@ GDScriptFunction::~GDScriptFunction() {
 #endif
 }
 
+Vector<uint8_t> GDScriptFunction::_take_await_frame(uint32_t p_size) {
+	Vector<uint8_t> frame;
+	await_frame_pool_lock.lock();
+	if (!await_frame_pool.is_empty()) {
+		frame = await_frame_pool[await_frame_pool.size() - 1];
+		await_frame_pool.resize(await_frame_pool.size() - 1);
+	}
+	await_frame_pool_lock.unlock();
+
+	if ((uint32_t)frame.size() != p_size) {
+		frame.resize(p_size);
+	}
+	return frame;
+}
+
+void GDScriptFunction::_recycle_await_frame(Vector<uint8_t> &r_frame) {
+	if (r_frame.is_empty()) {
+		return;
+	}
+	await_frame_pool_lock.lock();
+	if (await_frame_pool.size() < AWAIT_FRAME_POOL_SIZE) {
+		await_frame_pool.push_back(r_frame);
+	}
+	await_frame_pool_lock.unlock();
+	r_frame.clear();
+}
+
+Ref<GDScriptFunctionState> GDScriptFunction::_create_await_state(GDScriptInstance *p_instance, Variant *p_stack, uint32_t p_alloca_size, int p_ip, int p_line, int p_defarg) {
+	Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
+	gdfs->function = this;
+
+	gdfs->state.stack = _take_await_frame(p_alloca_size);
+
+	// The function returns right after, so its frame is moved to the state instead of copied.
+	// Variants can be relocated by copying their bytes, after which the old slots are simply
+	// reset without being destroyed. First 3 stack addresses are special, so we skip them here.
+	Variant *frame = (Variant *)gdfs->state.stack.ptrw();
+	if (_stack_size > FIXED_ADDRESSES_MAX) {
+		memcpy((void *)&frame[FIXED_ADDRESSES_MAX], (const void *)&p_stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
+		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+			memnew_placement(&p_stack[i], Variant);
+		}
+	}
+	gdfs->state.stack_size = _stack_size;
+	gdfs->state.alloca_size = p_alloca_size;
+	gdfs->state.ip = p_ip;
+	gdfs->state.line = p_line;
+	gdfs->state.script = _script;
+	{
+		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+		_script->pending_func_states.add(&gdfs->scripts_list);
+		if (p_instance) {
+			gdfs->state.instance = p_instance;
+			p_instance->pending_func_states.add(&gdfs->instances_list);
+		} else {
+			gdfs->state.instance = nullptr;
+		}
+	}
+#ifdef DEBUG_ENABLED
+	gdfs->state.function_name = name;
+	gdfs->state.script_path = _script->get_script_path();
+#endif
+	gdfs->state.defarg = p_defarg;
+
+	return gdfs;
+}
+
 /////////////////////
 
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -247,8 +343,15 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		instances_list.remove_from_list();
 	}
 
+	// The call or the `completed` signal may free or reload the script, and its functions with it.
+	// The reference keeps it alive, and a reload bumps the inline cache epoch, so the function can
+	// only take the frame back if neither happened.
+	Ref<GDScript> script_ref = state.script;
+	const uint32_t epoch = GDScriptFunction::inline_cache_epoch.get();
+
 	state.result = p_arg;
 	Callable::CallError err;
+	GDScriptFunction *resumed_function = function;
 	Variant ret = function->call(nullptr, nullptr, 0, err, &state);
 
 	bool completed = true;
@@ -282,6 +385,12 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 #endif
 	}
 
+	// Everything in the frame was freed by now, either when the call returned or by clearing the stack above.
+	state.stack_size = 0;
+	if (script_ref.is_valid() && GDScriptFunction::inline_cache_epoch.get() == epoch) {
+		resumed_function->_recycle_await_frame(state.stack);
+	}
+
 	return ret;
 }
 
@@ -325,3 +434,63 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		instances_list.remove_from_list();
 	}
 }
+
+/////////////////////
+
+bool GDScriptFunctionStateCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+	// Only compared by reference, like the lambda callables.
+	return p_a == p_b;
+}
+
+bool GDScriptFunctionStateCallable::compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+	return p_a < p_b;
+}
+
+uint32_t GDScriptFunctionStateCallable::hash() const {
+	return h;
+}
+
+String GDScriptFunctionStateCallable::get_as_text() const {
+	return "GDScriptFunctionState::_signal_callback";
+}
+
+CallableCustom::CompareEqualFunc GDScriptFunctionStateCallable::get_compare_equal_func() const {
+	return compare_equal;
+}
+
+CallableCustom::CompareLessFunc GDScriptFunctionStateCallable::get_compare_less_func() const {
+	return compare_less;
+}
+
+ObjectID GDScriptFunctionStateCallable::get_object() const {
+	return state->get_instance_id();
+}
+
+void GDScriptFunctionStateCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+	r_call_error.error = Callable::CallError::CALL_OK;
+
+	// Signal connections are cleared when the instance or the script goes away, but timer
+	// callbacks can't be, so they are ignored instead.
+	if (!state->is_valid(true)) {
+		return;
+	}
+
+	// Same as `_signal_callback`, without the state bound as last argument.
+	Variant arg;
+	if (p_argcount == 1) {
+		arg = *p_arguments[0];
+	} else if (p_argcount > 1) {
+		Array extra_args;
+		for (int i = 0; i < p_argcount; i++) {
+			extra_args.push_back(*p_arguments[i]);
+		}
+		arg = extra_args;
+	}
+
+	r_return_value = state->resume(arg);
+}
+
+GDScriptFunctionStateCallable::GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state) {
+	state = p_state;
+	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
+}
@@ -31,18 +31,26 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_native_registry.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
+class GDScriptFunctionState;
 
 class GDScriptDataType {
 private:
@@ -223,6 +231,13 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -233,6 +248,28 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_STRING_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_SET_INDEXED_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_STRING_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_ARRAY_SIZE,
+		OPCODE_ARRAY_APPEND,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -264,6 +301,7 @@ public:
 		OPCODE_CALL_GDSCRIPT_UTILITY,
 		OPCODE_CALL_BUILTIN_TYPE_VALIDATED,
 		OPCODE_CALL_SELF_BASE,
+		OPCODE_CALL_SCRIPT_FUNCTION,
 		OPCODE_CALL_METHOD_BIND,
 		OPCODE_CALL_METHOD_BIND_RET,
 		OPCODE_CALL_BUILTIN_STATIC,
@@ -308,6 +346,7 @@ public:
 		OPCODE_CALL_PTRCALL_PACKED_VECTOR3_ARRAY,
 		OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY,
 		OPCODE_AWAIT,
+		OPCODE_AWAIT_TIMER,
 		OPCODE_AWAIT_RESUME,
 		OPCODE_CREATE_LAMBDA,
 		OPCODE_CREATE_SELF_LAMBDA,
@@ -316,6 +355,8 @@ public:
 		OPCODE_JUMP_IF_NOT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF, // Only emitted by the bytecode optimizer.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Only emitted by the bytecode optimizer.
 		OPCODE_RETURN,
 		OPCODE_RETURN_TYPED_BUILTIN,
 		OPCODE_RETURN_TYPED_ARRAY,
@@ -437,6 +478,7 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
 
 	StringName source;
 
@@ -473,6 +515,7 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	int _lambdas_count = 0;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	int _inline_cache_count = 0;
 	const int *_code_ptr = nullptr;
 	int _code_size = 0;
 	int _argument_count = 0;
@@ -526,11 +569,108 @@ private:
 
 	List<StackDebug> stack_debug;
 
+	// Inline caches for the named accesses and calls the compiler couldn't
+	// resolve statically (OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL*),
+	// and for the script functions called by OPCODE_CALL_SCRIPT_FUNCTION, one
+	// per site. Each remembers what the last few kinds of receivers it saw
+	// resolved to, so the next ones skip the lookups by name.
+	//
+	// States are immutable once published, since other threads may be running
+	// the same function. Replaced ones are kept until no call of the function
+	// is running anymore, as only those read them, and a site stops being
+	// updated after INLINE_CACHE_MAX_UPDATES in the same epoch.
+	enum {
+		INLINE_CACHE_SIZE = 4,
+		INLINE_CACHE_MAX_UPDATES = 8,
+	};
+
+	enum InlineCacheTarget {
+		INLINE_CACHE_UNCACHED, // Nothing that can be cached, use the regular path.
+		INLINE_CACHE_BUILTIN_MEMBER, // Validated getter or setter of a built-in type member.
+		INLINE_CACHE_SCRIPT_MEMBER, // Script member variable without getter or setter.
+		INLINE_CACHE_NATIVE_PROPERTY, // Bound getter or setter of a native property.
+		INLINE_CACHE_NATIVE_METHOD, // Bound native method.
+		INLINE_CACHE_SCRIPT_FUNCTION, // Script member function.
+	};
+
+	struct InlineCacheEntry {
+		// What the receiver must be for the target to apply. Objects are told
+		// apart by their class and their script, null if they have no script.
+		Variant::Type type = Variant::NIL;
+		StringName native;
+		const GDScript *script = nullptr;
+
+		InlineCacheTarget target = INLINE_CACHE_UNCACHED;
+		Variant::Type member_type = Variant::NIL;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+		int member_index = -1;
+		const GDScriptDataType *member_data_type = nullptr; // Only set for typed members.
+		MethodBind *method = nullptr;
+		GDScriptFunction *function = nullptr;
+	};
+
+	struct InlineCacheState {
+		uint32_t epoch = 0;
+		int count = 0;
+		InlineCacheEntry entries[INLINE_CACHE_SIZE];
+	};
+
+	struct InlineCache {
+		std::atomic<const InlineCacheState *> state = { nullptr };
+		SafeNumeric<uint64_t> updates; // Epoch in the high 32 bits, updates done in it in the low ones.
+	};
+
+	InlineCache *_inline_caches = nullptr;
+	LocalVector<const InlineCacheState *> retired_inline_cache_states;
+	SafeNumeric<uint32_t> inline_cache_calls; // Calls of this function currently running, on any thread.
+	SafeFlag has_retired_inline_cache_states;
+
+	// Bumped whenever script functions or members are freed or rebuilt, which
+	// makes every cached state stale, as it may point to them.
+	static SafeNumeric<uint32_t> inline_cache_epoch;
+	static Mutex inline_cache_mutex;
+
+	void _init_inline_caches(int p_count);
+	static _FORCE_INLINE_ GDScriptInstance *_get_inline_cache_instance(Object *p_object, bool &r_cacheable);
+	static GDScriptInstance *_get_inline_cache_guard(const Variant *p_base, InlineCacheEntry &r_entry, bool &r_cacheable);
+	static bool _is_inline_cache_native_class(const StringName &p_class);
+	_FORCE_INLINE_ const InlineCacheEntry *_find_inline_cache_entry(int p_cache, Variant::Type p_type, const StringName &p_native, const GDScript *p_script) const;
+	bool _is_inline_cache_full(int p_cache) const;
+	void _add_inline_cache_entry(int p_cache, const InlineCacheEntry &p_entry);
+	void _free_retired_inline_cache_states();
+	void _update_inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name);
+	void _update_inline_cache_set(int p_cache, const Variant *p_base, const StringName &p_name);
+	void _update_inline_cache_call(int p_cache, const Variant *p_base, const StringName &p_method);
+	_FORCE_INLINE_ GDScriptFunction *_get_inline_cache_script_function(int p_cache, GDScriptInstance *p_instance, const StringName &p_name);
+	_FORCE_INLINE_ bool _inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_ret);
+	_FORCE_INLINE_ bool _inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	_FORCE_INLINE_ bool _inline_cache_call(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
+	enum {
+		AWAIT_FRAME_POOL_SIZE = 32,
+	};
+
+	// Frames of await states that were resumed, reused by the next awaits
+	// instead of allocating new ones. They all have the size this function needs.
+	SpinLock await_frame_pool_lock;
+	LocalVector<Vector<uint8_t>> await_frame_pool;
+
+	Vector<uint8_t> _take_await_frame(uint32_t p_size);
+	void _recycle_await_frame(Vector<uint8_t> &r_frame);
+	Ref<GDScriptFunctionState> _create_await_state(GDScriptInstance *p_instance, Variant *p_stack, uint32_t p_alloca_size, int p_ip, int p_line, int p_defarg);
+
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	// Set by GDScript::reload() if the function was translated to C++, see GDScriptNativeRegistry.
+	GDScriptNativeRegistry::Call native_call = nullptr;
+
+	Variant _call_native(const Variant **p_args, int p_argcount, Callable::CallError &r_err);
+
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
 	friend class GDScriptLanguage;
+	friend class GDScriptFunctionState;
 
 	SelfList<GDScriptFunction> function_list{ this };
 #ifdef DEBUG_ENABLED
@@ -573,6 +713,8 @@ public:
 
 	_FORCE_INLINE_ bool is_static() const { return _static; }
 
+	static void invalidate_inline_caches() { inline_cache_epoch.increment(); }
+
 	const int *get_code() const; //used for debug
 	int get_code_size() const;
 	Variant get_constant(int p_idx) const;
@@ -645,4 +787,25 @@ public:
 	~GDScriptFunctionState();
 };
 
+// Resumes an await state when called, with the arguments of the awaited
+// signal. Lighter than binding the state to `_signal_callback`.
+class GDScriptFunctionStateCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+	uint32_t h;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
+
+public:
+	uint32_t hash() const override;
+	String get_as_text() const override;
+	CompareEqualFunc get_compare_equal_func() const override;
+	CompareLessFunc get_compare_less_func() const override;
+	ObjectID get_object() const override;
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
+
+	GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state);
+	virtual ~GDScriptFunctionStateCallable() = default;
+};
+
 #endif // GDSCRIPT_FUNCTION_H
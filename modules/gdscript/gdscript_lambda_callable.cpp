@@ -34,6 +34,44 @@
 
 #include "core/templates/hashfuncs.h"
 
+GDScriptLambdaCaptures::GDScriptLambdaCaptures(const Variant **p_values, int p_count) {
+	count = p_count;
+	if (count > INLINE_MAX) {
+		values = memnew_arr(Variant, count);
+	}
+	for (int i = 0; i < count; i++) {
+		values[i] = *p_values[i];
+	}
+}
+
+GDScriptLambdaCaptures::~GDScriptLambdaCaptures() {
+	if (values != inline_values) {
+		memdelete_arr(values);
+	}
+}
+
+// Captures are passed as the first arguments. Only pointers are gathered, on the stack, so
+// nothing is copied or allocated per call.
+static Variant _call_with_captures(GDScriptFunction *p_function, GDScriptInstance *p_instance, const GDScriptLambdaCaptures &p_captures, const Variant **p_arguments, int p_argcount, Callable::CallError &r_call_error) {
+	int captures_amount = p_captures.size();
+	if (captures_amount == 0) {
+		return p_function->call(p_instance, p_arguments, p_argcount, r_call_error);
+	}
+
+	const Variant **args = (const Variant **)alloca(sizeof(const Variant *) * (captures_amount + p_argcount));
+	const Variant *captures = p_captures.ptr();
+	for (int i = 0; i < captures_amount; i++) {
+		args[i] = &captures[i];
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		args[i + captures_amount] = p_arguments[i];
+	}
+
+	Variant ret = p_function->call(p_instance, args, captures_amount + p_argcount, r_call_error);
+	r_call_error.argument -= captures_amount;
+	return ret;
+}
+
 bool GDScriptLambdaCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
 	// Lambda callables are only compared by reference.
 	return p_a == p_b;
@@ -68,29 +106,13 @@ ObjectID GDScriptLambdaCallable::get_object() const {
 }
 
 void GDScriptLambdaCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
-	int captures_amount = captures.size();
-
-	if (captures_amount > 0) {
-		Vector<const Variant *> args;
-		args.resize(p_argcount + captures_amount);
-		for (int i = 0; i < captures_amount; i++) {
-			args.write[i] = &captures[i];
-		}
-		for (int i = 0; i < p_argcount; i++) {
-			args.write[i + captures_amount] = p_arguments[i];
-		}
-
-		r_return_value = function->call(nullptr, args.ptrw(), args.size(), r_call_error);
-		r_call_error.argument -= captures_amount;
-	} else {
-		r_return_value = function->call(nullptr, p_arguments, p_argcount, r_call_error);
-	}
+	r_return_value = _call_with_captures(function, nullptr, captures, p_arguments, p_argcount, r_call_error);
 }
 
-GDScriptLambdaCallable::GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Vector<Variant> &p_captures) {
+GDScriptLambdaCallable::GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count) :
+		captures(p_captures, p_capture_count) {
 	script = p_script;
 	function = p_function;
-	captures = p_captures;
 
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
@@ -137,38 +159,22 @@ void GDScriptLambdaSelfCallable::call(const Variant **p_arguments, int p_argcoun
 	}
 #endif
 
-	int captures_amount = captures.size();
-
-	if (captures_amount > 0) {
-		Vector<const Variant *> args;
-		args.resize(p_argcount + captures_amount);
-		for (int i = 0; i < captures_amount; i++) {
-			args.write[i] = &captures[i];
-		}
-		for (int i = 0; i < p_argcount; i++) {
-			args.write[i + captures_amount] = p_arguments[i];
-		}
-
-		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), args.ptrw(), args.size(), r_call_error);
-		r_call_error.argument -= captures_amount;
-	} else {
-		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), p_arguments, p_argcount, r_call_error);
-	}
+	r_return_value = _call_with_captures(function, static_cast<GDScriptInstance *>(object->get_script_instance()), captures, p_arguments, p_argcount, r_call_error);
 }
 
-GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures) {
+GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count) :
+		captures(p_captures, p_capture_count) {
 	reference = p_self;
 	object = p_self.ptr();
 	function = p_function;
-	captures = p_captures;
 
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
 
-GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures) {
+GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count) :
+		captures(p_captures, p_capture_count) {
 	object = p_self;
 	function = p_function;
-	captures = p_captures;
 
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
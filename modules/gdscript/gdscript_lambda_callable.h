@@ -32,7 +32,6 @@
 #define GDSCRIPT_LAMBDA_CALLABLE_H
 
 #include "core/object/ref_counted.h"
-#include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/variant.h"
 
@@ -40,12 +39,33 @@ class GDScript;
 class GDScriptFunction;
 class GDScriptInstance;
 
+// Values captured by a lambda. Most lambdas only capture a few, so those are stored inline and
+// creating the lambda doesn't need another allocation.
+class GDScriptLambdaCaptures {
+	enum {
+		INLINE_MAX = 4,
+	};
+
+	Variant inline_values[INLINE_MAX];
+	Variant *values = inline_values;
+	int count = 0;
+
+public:
+	_FORCE_INLINE_ int size() const { return count; }
+	_FORCE_INLINE_ const Variant *ptr() const { return values; }
+
+	GDScriptLambdaCaptures(const Variant **p_values, int p_count);
+	GDScriptLambdaCaptures(const GDScriptLambdaCaptures &) = delete;
+	GDScriptLambdaCaptures &operator=(const GDScriptLambdaCaptures &) = delete;
+	~GDScriptLambdaCaptures();
+};
+
 class GDScriptLambdaCallable : public CallableCustom {
 	GDScriptFunction *function = nullptr;
 	Ref<GDScript> script;
 	uint32_t h;
 
-	Vector<Variant> captures;
+	GDScriptLambdaCaptures captures;
 
 	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
@@ -58,7 +78,7 @@ public:
 	ObjectID get_object() const override;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
 
-	GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
+	GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count);
 	virtual ~GDScriptLambdaCallable() = default;
 };
 
@@ -69,7 +89,7 @@ class GDScriptLambdaSelfCallable : public CallableCustom {
 	Object *object = nullptr; // For non RefCounted objects, use a direct pointer.
 	uint32_t h;
 
-	Vector<Variant> captures;
+	GDScriptLambdaCaptures captures;
 
 	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
@@ -82,8 +102,8 @@ public:
 	ObjectID get_object() const override;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
 
-	GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
-	GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
+	GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count);
+	GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Variant **p_captures, int p_capture_count);
 	virtual ~GDScriptLambdaSelfCallable() = default;
 };
 
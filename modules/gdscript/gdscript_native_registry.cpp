@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  gdscript_native_registry.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_registry.h"
+
+#ifdef GDSCRIPT_NATIVE_ENABLED
+// Generated at export along with the translated scripts, see EditorExportGDScript.
+void gdscript_native_register_all();
+#endif
+
+Mutex GDScriptNativeRegistry::mutex;
+HashMap<String, GDScriptNativeRegistry::Function> GDScriptNativeRegistry::functions;
+
+String GDScriptNativeRegistry::_get_key(const String &p_script_path, const StringName &p_name) {
+	return p_script_path + "::" + String(p_name);
+}
+
+void GDScriptNativeRegistry::register_function(const String &p_script_path, const StringName &p_name, uint32_t p_source_hash, int p_argument_count, Call p_call) {
+	ERR_FAIL_NULL(p_call);
+	ERR_FAIL_COND(p_argument_count < 0 || p_argument_count > MAX_ARGUMENTS);
+
+	Function function;
+	function.source_hash = p_source_hash;
+	function.argument_count = p_argument_count;
+	function.call = p_call;
+
+	MutexLock lock(mutex);
+	functions[_get_key(p_script_path, p_name)] = function;
+}
+
+void GDScriptNativeRegistry::unregister_function(const String &p_script_path, const StringName &p_name) {
+	MutexLock lock(mutex);
+	functions.erase(_get_key(p_script_path, p_name));
+}
+
+GDScriptNativeRegistry::Call GDScriptNativeRegistry::get_function(const String &p_script_path, const StringName &p_name, uint32_t p_source_hash, int p_argument_count) {
+	MutexLock lock(mutex);
+	HashMap<String, Function>::ConstIterator E = functions.find(_get_key(p_script_path, p_name));
+	if (!E || E->value.source_hash != p_source_hash || E->value.argument_count != p_argument_count) {
+		return nullptr;
+	}
+	return E->value.call;
+}
+
+bool GDScriptNativeRegistry::is_empty() {
+	MutexLock lock(mutex);
+	return functions.is_empty();
+}
+
+void GDScriptNativeRegistry::initialize() {
+#ifdef GDSCRIPT_NATIVE_ENABLED
+	gdscript_native_register_all();
+#endif
+}
+
+void GDScriptNativeRegistry::finish() {
+	MutexLock lock(mutex);
+	functions.clear();
+}
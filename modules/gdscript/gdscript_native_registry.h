@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  gdscript_native_registry.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_REGISTRY_H
+#define GDSCRIPT_NATIVE_REGISTRY_H
+
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+// Functions translated to C++ from GDScript by GDScriptNativeTranslator and
+// compiled into the build. GDScript::reload() binds them to the functions of
+// the script they were translated from, as long as its source didn't change
+// since, and GDScriptFunction::call() then runs them instead of the bytecode.
+//
+// Builds made with the `gdscript_native_dir` option register the functions of
+// the files in that directory on initialization.
+class GDScriptNativeRegistry {
+public:
+	enum {
+		MAX_ARGUMENTS = 8,
+	};
+
+	// The arguments are already of the types of the parameters.
+	typedef void (*Call)(const Variant **p_args, Variant &r_ret);
+
+private:
+	struct Function {
+		uint32_t source_hash = 0;
+		int argument_count = 0;
+		Call call = nullptr;
+	};
+
+	static Mutex mutex;
+	static HashMap<String, Function> functions;
+
+	static String _get_key(const String &p_script_path, const StringName &p_name);
+
+public:
+	static void register_function(const String &p_script_path, const StringName &p_name, uint32_t p_source_hash, int p_argument_count, Call p_call);
+	static void unregister_function(const String &p_script_path, const StringName &p_name);
+	// Returns null if nothing was registered for that source.
+	static Call get_function(const String &p_script_path, const StringName &p_name, uint32_t p_source_hash, int p_argument_count);
+	static bool is_empty();
+
+	static void initialize();
+	static void finish();
+};
+
+#endif // GDSCRIPT_NATIVE_REGISTRY_H
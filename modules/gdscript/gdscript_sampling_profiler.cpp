@@ -0,0 +1,342 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+SafeFlag GDScriptSamplingProfiler::active;
+SafeFlag GDScriptSamplingProfiler::exit_thread;
+Thread GDScriptSamplingProfiler::sampler_thread;
+uint64_t GDScriptSamplingProfiler::interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+uint64_t GDScriptSamplingProfiler::last_debugger_send = 0;
+
+Mutex GDScriptSamplingProfiler::mutex;
+LocalVector<GDScriptSamplingProfiler::ThreadStack *> GDScriptSamplingProfiler::thread_stacks;
+HashMap<const GDScriptFunction *, String> GDScriptSamplingProfiler::function_names;
+bool GDScriptSamplingProfiler::local_session = false;
+bool GDScriptSamplingProfiler::debugger_session = false;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::samples;
+uint64_t GDScriptSamplingProfiler::sample_count = 0;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::debugger_samples;
+
+thread_local GDScriptSamplingProfiler::ThreadStackOwner GDScriptSamplingProfiler::thread_stack;
+
+GDScriptSamplingProfiler::ThreadStackOwner::~ThreadStackOwner() {
+	if (!stack) {
+		return;
+	}
+	MutexLock lock(mutex);
+	// Already freed if finish() was called before this thread exited.
+	int64_t index = thread_stacks.find(stack);
+	if (index >= 0) {
+		thread_stacks.remove_at_unordered(index);
+		memdelete(stack);
+	}
+	stack = nullptr;
+}
+
+GDScriptSamplingProfiler::ThreadStack *GDScriptSamplingProfiler::_register_thread() {
+	ThreadStack *stack = memnew(ThreadStack);
+	stack->thread_id = Thread::get_caller_id();
+
+	MutexLock lock(mutex);
+	thread_stacks.push_back(stack);
+	thread_stack.stack = stack;
+	return stack;
+}
+
+const String &GDScriptSamplingProfiler::_get_function_name(const GDScriptFunction *p_function) {
+	HashMap<const GDScriptFunction *, String>::Iterator E = function_names.find(p_function);
+	if (E) {
+		return E->value;
+	}
+
+	const GDScript *script = p_function->get_script();
+	String name = (script ? script->get_fully_qualified_name() : String("<unknown>")) + ":" + String(p_function->get_name());
+	// `;` separates frames in the output.
+	return function_names.insert(p_function, name.replace(";", "_"))->value;
+}
+
+void GDScriptSamplingProfiler::_take_samples() {
+	MutexLock lock(mutex);
+	if (!local_session && !debugger_session) {
+		return;
+	}
+
+	const GDScriptFunction *functions[MAX_FRAMES];
+	int lines[MAX_FRAMES];
+
+	for (const ThreadStack *stack : thread_stacks) {
+		// The thread keeps running while it's sampled. Its frames are copied
+		// first, and dropped if one was pushed meanwhile. Frames popped
+		// meanwhile were still running when the depth was read, and their
+		// functions can't be freed before the lock is released.
+		const uint32_t sequence = stack->sequence.load(std::memory_order_acquire);
+		if (sequence & 1) {
+			continue;
+		}
+		const uint32_t depth = MIN(stack->depth.load(std::memory_order_acquire), (uint32_t)MAX_FRAMES);
+		if (depth == 0) {
+			continue;
+		}
+		for (uint32_t i = 0; i < depth; i++) {
+			functions[i] = stack->frames[i].function.load(std::memory_order_relaxed);
+			lines[i] = stack->frames[i].line.load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (stack->sequence.load(std::memory_order_relaxed) != sequence) {
+			continue;
+		}
+
+		String key = stack->thread_id == Thread::get_main_id() ? String("main") : "thread_" + itos(stack->thread_id);
+		for (uint32_t i = 0; i < depth; i++) {
+			key += ";" + _get_function_name(functions[i]) + ":" + itos(lines[i]);
+		}
+
+		if (local_session) {
+			HashMap<String, uint64_t>::Iterator E = samples.find(key);
+			if (E) {
+				E->value++;
+			} else {
+				samples.insert(key, 1);
+			}
+			sample_count++;
+		}
+		if (debugger_session) {
+			HashMap<String, uint64_t>::Iterator E = debugger_samples.find(key);
+			if (E) {
+				E->value++;
+			} else {
+				debugger_samples.insert(key, 1);
+			}
+		}
+	}
+}
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampler");
+
+	while (!exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		_take_samples();
+	}
+}
+
+void GDScriptSamplingProfiler::function_freed(const GDScriptFunction *p_function) {
+	// Also waits for a sample in progress, which may be using the function.
+	MutexLock lock(mutex);
+	function_names.erase(p_function);
+}
+
+void GDScriptSamplingProfiler::_start_thread(uint64_t p_interval_usec) {
+	active.set();
+	if (p_interval_usec == 0 || sampler_thread.is_started()) {
+		return;
+	}
+
+	interval_usec = p_interval_usec;
+	exit_thread.clear();
+	sampler_thread.start(_sampler_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::_stop_thread_if_unused() {
+	{
+		MutexLock lock(mutex);
+		if (local_session || debugger_session) {
+			return;
+		}
+	}
+	if (!active.is_set()) {
+		return;
+	}
+
+	active.clear();
+	if (sampler_thread.is_started()) {
+		exit_thread.set();
+		sampler_thread.wait_to_finish();
+	}
+
+	// Names are only needed while sampling, stacks already sampled keep their copy.
+	MutexLock lock(mutex);
+	function_names.clear();
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	{
+		MutexLock lock(mutex);
+		if (local_session) {
+			return;
+		}
+		local_session = true;
+	}
+	_start_thread(p_interval_usec);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	{
+		MutexLock lock(mutex);
+		if (!local_session) {
+			return;
+		}
+		local_session = false;
+	}
+	_stop_thread_if_unused();
+}
+
+bool GDScriptSamplingProfiler::is_started() {
+	MutexLock lock(mutex);
+	return local_session;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	samples.clear();
+	sample_count = 0;
+}
+
+void GDScriptSamplingProfiler::sample_now() {
+	_take_samples();
+}
+
+void GDScriptSamplingProfiler::finish() {
+	{
+		MutexLock lock(mutex);
+		local_session = false;
+		debugger_session = false;
+	}
+	_stop_thread_if_unused();
+
+	MutexLock lock(mutex);
+	for (ThreadStack *stack : thread_stacks) {
+		memdelete(stack);
+	}
+	thread_stacks.clear();
+	thread_stack.stack = nullptr;
+	samples.clear();
+	sample_count = 0;
+	debugger_samples.clear();
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::_format_samples(const HashMap<String, uint64_t> &p_samples) {
+	String result;
+	for (const KeyValue<String, uint64_t> &E : p_samples) {
+		result += E.key + " " + itos(E.value) + "\n";
+	}
+	return result;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+	return _format_samples(samples);
+}
+
+Error GDScriptSamplingProfiler::save_collapsed_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot open file "%s" to save the GDScript samples.)", p_path));
+
+	f->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::_debugger_toggle(void *p_user, bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		uint64_t interval = p_opts.size() > 0 ? uint64_t(p_opts[0]) : uint64_t(DEFAULT_INTERVAL_USEC);
+		ERR_FAIL_COND_MSG(interval == 0, "The sampling interval must be greater than zero.");
+		{
+			MutexLock lock(mutex);
+			debugger_samples.clear();
+			debugger_session = true;
+		}
+		last_debugger_send = OS::get_singleton()->get_ticks_msec();
+		_start_thread(interval);
+	} else {
+		{
+			MutexLock lock(mutex);
+			if (!debugger_session) {
+				return;
+			}
+			debugger_session = false;
+		}
+		_stop_thread_if_unused();
+		_debugger_send();
+	}
+}
+
+void GDScriptSamplingProfiler::_debugger_tick(void *p_user, double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+	uint64_t ticks = OS::get_singleton()->get_ticks_msec();
+	if (ticks - last_debugger_send < DEBUGGER_SEND_INTERVAL_MSEC) {
+		return;
+	}
+	last_debugger_send = ticks;
+	_debugger_send();
+}
+
+void GDScriptSamplingProfiler::_debugger_send() {
+	if (!EngineDebugger::get_singleton()) {
+		return;
+	}
+
+	String stacks;
+	{
+		MutexLock lock(mutex);
+		if (debugger_samples.is_empty()) {
+			return;
+		}
+		stacks = _format_samples(debugger_samples);
+		debugger_samples.clear();
+	}
+
+	Array data;
+	data.push_back(stacks);
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:stacks", data);
+}
+
+void GDScriptSamplingProfiler::register_debugger_profiler() {
+	EngineDebugger::register_profiler("gdscript_sampler", EngineDebugger::Profiler(nullptr, _debugger_toggle, nullptr, _debugger_tick));
+}
+
+void GDScriptSamplingProfiler::unregister_debugger_profiler() {
+	if (EngineDebugger::has_profiler("gdscript_sampler")) {
+		EngineDebugger::unregister_profiler("gdscript_sampler");
+	}
+}
@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+class GDScriptFunction;
+
+// Statistical profiler for GDScript, cheap enough to stay on in release builds.
+// While active, every thread running GDScript keeps a small stack of the
+// functions it's in, and a separate thread periodically records a copy of
+// each of those stacks (function and current line for each frame). Nothing is
+// timed on the calling side, so small hot functions aren't distorted.
+//
+// Samples are aggregated in the "collapsed stacks" text format used by most
+// flame graph tools: one line per distinct stack, frames separated by `;`,
+// followed by the number of times it was sampled.
+//
+// The sampler can be started locally (by the project settings or start()) and
+// by the debugger at the same time. Each keeps its own samples, so the
+// debugger taking its samples or stopping doesn't affect the local ones.
+class GDScriptSamplingProfiler {
+public:
+	enum {
+		MAX_FRAMES = 128, // Deeper frames are still tracked, but left out of the samples.
+		DEFAULT_INTERVAL_USEC = 1000,
+		DEBUGGER_SEND_INTERVAL_MSEC = 1000,
+	};
+
+private:
+	// The VM updates the line of its frame directly, see enter_function().
+	struct Frame {
+		std::atomic<const GDScriptFunction *> function = { nullptr };
+		std::atomic<int> line = { 0 };
+	};
+
+	// Only written by its own thread, and read by the sampler while it runs.
+	// `sequence` is odd while a frame is being pushed, a sample that saw it
+	// change while copying the frames is dropped. Frames past `depth` can be
+	// stale.
+	struct ThreadStack {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		Frame frames[MAX_FRAMES];
+		std::atomic<int> overflow_line = { 0 }; // Line of the frames past MAX_FRAMES, not sampled.
+		std::atomic<uint32_t> sequence = { 0 };
+		std::atomic<uint32_t> depth = { 0 };
+	};
+
+	// Unregisters the stack of a thread when it exits.
+	struct ThreadStackOwner {
+		ThreadStack *stack = nullptr;
+		~ThreadStackOwner();
+	};
+
+	// Set while the sampler thread runs, for either session.
+	static SafeFlag active;
+	static SafeFlag exit_thread;
+	static Thread sampler_thread;
+	static uint64_t interval_usec;
+	static uint64_t last_debugger_send;
+
+	// Guards everything below. Also held while sampling, so functions and
+	// thread stacks referenced by a sample stay alive until it's recorded.
+	static Mutex mutex;
+	static LocalVector<ThreadStack *> thread_stacks;
+	static HashMap<const GDScriptFunction *, String> function_names;
+	static bool local_session;
+	static bool debugger_session;
+	static HashMap<String, uint64_t> samples;
+	static uint64_t sample_count;
+	static HashMap<String, uint64_t> debugger_samples;
+
+	static thread_local ThreadStackOwner thread_stack;
+
+	static ThreadStack *_register_thread();
+	static const String &_get_function_name(const GDScriptFunction *p_function);
+	static void _take_samples();
+	static String _format_samples(const HashMap<String, uint64_t> &p_samples);
+	static void _sampler_thread_func(void *p_userdata);
+	static void _start_thread(uint64_t p_interval_usec);
+	static void _stop_thread_if_unused();
+
+	static void _debugger_toggle(void *p_user, bool p_enable, const Array &p_opts);
+	static void _debugger_tick(void *p_user, double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time);
+	static void _debugger_send();
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	// Called by the VM when entering a function while active. Every call must
+	// be matched by exit_function() on the same thread, even if stopped since.
+	// Returns where the VM stores the current line of the function.
+	_FORCE_INLINE_ static std::atomic<int> *enter_function(const GDScriptFunction *p_function, int p_line) {
+		ThreadStack *stack = thread_stack.stack;
+		if (unlikely(!stack)) {
+			stack = _register_thread();
+		}
+		const uint32_t depth = stack->depth.load(std::memory_order_relaxed);
+		std::atomic<int> *line = &stack->overflow_line;
+		if (likely(depth < MAX_FRAMES)) {
+			const uint32_t sequence = stack->sequence.load(std::memory_order_relaxed);
+			stack->sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			stack->frames[depth].function.store(p_function, std::memory_order_relaxed);
+			line = &stack->frames[depth].line;
+			line->store(p_line, std::memory_order_relaxed);
+			stack->sequence.store(sequence + 2, std::memory_order_release);
+		}
+		stack->depth.store(depth + 1, std::memory_order_release);
+		return line;
+	}
+
+	_FORCE_INLINE_ static void exit_function() {
+		ThreadStack *stack = thread_stack.stack;
+		stack->depth.store(stack->depth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+	}
+
+	// Must be called before a function that may have been sampled is freed.
+	static void function_freed(const GDScriptFunction *p_function);
+
+	// Starts and stops the local session. If the debugger session is already
+	// sampling, its interval is kept. With an interval of 0, stacks are only
+	// sampled by sample_now().
+	static void start(uint64_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static void stop();
+	static bool is_started();
+	static void clear();
+	// Samples every thread right away, for the sessions that are started.
+	static void sample_now();
+	// Stops sampling and frees the thread stacks. No GDScript may run after this.
+	static void finish();
+
+	// Samples of the local session.
+	static uint64_t get_sample_count();
+	static String get_collapsed_stacks();
+	static Error save_collapsed_stacks(const String &p_path);
+
+	// Exposes the profiler to the debugger as "gdscript_sampler". When enabled
+	// there, the stacks sampled since the last send are sent every second with
+	// the "gdscript_sampler:stacks" message.
+	static void register_debugger_profiler();
+	static void unregister_debugger_profiler();
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -31,9 +31,12 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/core_string_names.h"
+#include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
+#include "scene/main/scene_tree.h"
 
 #ifdef DEBUG_ENABLED
 static String _get_element_type(Variant::Type builtin_type, const StringName &native_type, const Ref<Script> &script_type) {
@@ -111,6 +114,40 @@ Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataT
 	return Variant();
 }
 
+Variant GDScriptFunction::_call_native(const Variant **p_args, int p_argcount, Callable::CallError &r_err) {
+	// Translated functions have no default arguments.
+	if (p_argcount != _argument_count) {
+		r_err.error = p_argcount > _argument_count ? Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS : Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_err.argument = _argument_count;
+		return _get_default_variant_for_data_type(return_type);
+	}
+
+	// Same conversions as when running the bytecode, the generated code reads
+	// the arguments as the types of the parameters without checking.
+	const Variant *args[GDScriptNativeRegistry::MAX_ARGUMENTS];
+	Variant converted[GDScriptNativeRegistry::MAX_ARGUMENTS];
+	for (int i = 0; i < p_argcount; i++) {
+		const GDScriptDataType &type = argument_types[i];
+		if (p_args[i]->get_type() == type.builtin_type) {
+			args[i] = p_args[i];
+			continue;
+		}
+		if (!type.is_type(*p_args[i], true)) {
+			r_err.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+			r_err.argument = i;
+			r_err.expected = type.builtin_type;
+			return _get_default_variant_for_data_type(return_type);
+		}
+		Variant::construct(type.builtin_type, converted[i], &p_args[i], 1, r_err);
+		args[i] = &converted[i];
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+	Variant ret;
+	native_call(args, ret);
+	return ret;
+}
+
 String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 	String err_text;
 
@@ -144,6 +181,466 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+GDScriptInstance *GDScriptFunction::_get_inline_cache_instance(Object *p_object, bool &r_cacheable) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance) {
+		r_cacheable = true;
+		return nullptr;
+	}
+	// Other script languages resolve names their own way, so only objects with
+	// no script or a GDScript one are cached.
+	r_cacheable = script_instance->get_language() == GDScriptLanguage::get_singleton() && !script_instance->is_placeholder();
+	return r_cacheable ? static_cast<GDScriptInstance *>(script_instance) : nullptr;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_find_inline_cache_entry(int p_cache, Variant::Type p_type, const StringName &p_native, const GDScript *p_script) const {
+	const InlineCacheState *state = _inline_caches[p_cache].state.load(std::memory_order_acquire);
+	if (!state || state->epoch != inline_cache_epoch.get()) {
+		return nullptr;
+	}
+	for (int i = 0; i < state->count; i++) {
+		const InlineCacheEntry &entry = state->entries[i];
+		if (entry.type == p_type && entry.native == p_native && entry.script == p_script) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+bool GDScriptFunction::_is_inline_cache_full(int p_cache) const {
+	const uint64_t updates = _inline_caches[p_cache].updates.get();
+	return (updates >> 32) == inline_cache_epoch.get() && uint32_t(updates) >= INLINE_CACHE_MAX_UPDATES;
+}
+
+void GDScriptFunction::_add_inline_cache_entry(int p_cache, const InlineCacheEntry &p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	InlineCache &cache = _inline_caches[p_cache];
+	if (_is_inline_cache_full(p_cache)) {
+		return;
+	}
+
+	const InlineCacheState *old_state = cache.state.load(std::memory_order_acquire);
+	InlineCacheState *state = memnew(InlineCacheState);
+	state->epoch = inline_cache_epoch.get();
+	state->entries[0] = p_entry;
+	state->count = 1;
+	if (old_state && old_state->epoch == state->epoch) {
+		// Most recent first, dropping the oldest entry if full.
+		for (int i = 0; i < old_state->count && state->count < INLINE_CACHE_SIZE; i++) {
+			const InlineCacheEntry &entry = old_state->entries[i];
+			if (entry.type != p_entry.type || entry.native != p_entry.native || entry.script != p_entry.script) {
+				state->entries[state->count++] = entry;
+			}
+		}
+	}
+
+	cache.state.store(state, std::memory_order_release);
+	// Updates are counted per epoch, so invalidations alone don't use up the site.
+	const uint64_t updates = cache.updates.get();
+	if ((updates >> 32) == state->epoch) {
+		cache.updates.set(updates + 1);
+	} else {
+		cache.updates.set((uint64_t(state->epoch) << 32) | 1);
+	}
+	if (old_state) {
+		retired_inline_cache_states.push_back(old_state);
+		has_retired_inline_cache_states.set();
+	}
+}
+
+void GDScriptFunction::_free_retired_inline_cache_states() {
+	MutexLock lock(inline_cache_mutex);
+
+	// A call may have started since, but it can only have loaded the published states.
+	if (inline_cache_calls.get() != 0) {
+		return;
+	}
+	for (const InlineCacheState *state : retired_inline_cache_states) {
+		memdelete(const_cast<InlineCacheState *>(state));
+	}
+	retired_inline_cache_states.clear();
+	has_retired_inline_cache_states.clear();
+}
+
+GDScriptInstance *GDScriptFunction::_get_inline_cache_guard(const Variant *p_base, InlineCacheEntry &r_entry, bool &r_cacheable) {
+	r_entry.type = p_base->get_type();
+	if (r_entry.type != Variant::OBJECT) {
+		r_cacheable = true;
+		return nullptr;
+	}
+
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		r_cacheable = false;
+		return nullptr;
+	}
+	GDScriptInstance *instance = _get_inline_cache_instance(obj, r_cacheable);
+	if (!r_cacheable) {
+		return nullptr;
+	}
+	r_entry.native = obj->get_class_name();
+	r_entry.script = instance ? instance->script.ptr() : nullptr;
+	return instance;
+}
+
+bool GDScriptFunction::_is_inline_cache_native_class(const StringName &p_class) {
+	// Extension classes have their own get and set callbacks, and their method binds can be unloaded.
+	ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+}
+
+void GDScriptFunction::_update_inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name) {
+	if (_is_inline_cache_full(p_cache)) {
+		return;
+	}
+
+	InlineCacheEntry entry;
+	bool cacheable = false;
+	GDScriptInstance *instance = _get_inline_cache_guard(p_base, entry, cacheable);
+	if (!cacheable) {
+		return;
+	}
+	// Receivers the name can't be resolved for are cached too, so they go straight to the regular path.
+	entry.target = INLINE_CACHE_UNCACHED;
+
+	if (entry.type != Variant::OBJECT) {
+		entry.getter = Variant::get_member_validated_getter(entry.type, p_name);
+		if (entry.getter) {
+			entry.target = INLINE_CACHE_BUILTIN_MEMBER;
+			entry.member_type = Variant::get_member_type(entry.type, p_name);
+		}
+		_add_inline_cache_entry(p_cache, entry);
+		return;
+	}
+
+	if (instance) {
+		// Same lookup order as GDScriptInstance::get().
+		const GDScript::MemberInfo *member = entry.script->member_indices.getptr(p_name);
+		if (member) {
+			if (!member->getter) {
+				entry.target = INLINE_CACHE_SCRIPT_MEMBER;
+				entry.member_index = member->index;
+			}
+			_add_inline_cache_entry(p_cache, entry);
+			return;
+		}
+
+		const StringName &get_name = GDScriptLanguage::get_singleton()->strings._get;
+		for (const GDScript *sptr = entry.script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) ||
+					sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(get_name)) {
+				_add_inline_cache_entry(p_cache, entry);
+				return;
+			}
+		}
+	}
+
+	if (_is_inline_cache_native_class(entry.native)) {
+		int index = -1;
+		MethodBind *getter = ClassDB::get_property_getter_bind(entry.native, p_name, &index);
+		if (getter && index < 0) {
+			entry.target = INLINE_CACHE_NATIVE_PROPERTY;
+			entry.method = getter;
+		}
+	}
+	_add_inline_cache_entry(p_cache, entry);
+}
+
+void GDScriptFunction::_update_inline_cache_set(int p_cache, const Variant *p_base, const StringName &p_name) {
+	if (_is_inline_cache_full(p_cache)) {
+		return;
+	}
+
+	InlineCacheEntry entry;
+	bool cacheable = false;
+	GDScriptInstance *instance = _get_inline_cache_guard(p_base, entry, cacheable);
+	if (!cacheable) {
+		return;
+	}
+	entry.target = INLINE_CACHE_UNCACHED;
+
+	if (entry.type != Variant::OBJECT) {
+		entry.setter = Variant::get_member_validated_setter(entry.type, p_name);
+		if (entry.setter) {
+			entry.target = INLINE_CACHE_BUILTIN_MEMBER;
+			entry.member_type = Variant::get_member_type(entry.type, p_name);
+		}
+		_add_inline_cache_entry(p_cache, entry);
+		return;
+	}
+
+	if (instance) {
+		// Same lookup order as GDScriptInstance::set().
+		const GDScript::MemberInfo *member = entry.script->member_indices.getptr(p_name);
+		if (member) {
+			if (!member->setter) {
+				entry.target = INLINE_CACHE_SCRIPT_MEMBER;
+				entry.member_index = member->index;
+				if (member->data_type.has_type) {
+					entry.member_data_type = &member->data_type;
+				}
+			}
+			_add_inline_cache_entry(p_cache, entry);
+			return;
+		}
+
+		const StringName &set_name = GDScriptLanguage::get_singleton()->strings._set;
+		for (const GDScript *sptr = entry.script; sptr; sptr = sptr->_base) {
+			if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(set_name)) {
+				_add_inline_cache_entry(p_cache, entry);
+				return;
+			}
+		}
+	}
+
+	if (_is_inline_cache_native_class(entry.native)) {
+		int index = -1;
+		MethodBind *setter = ClassDB::get_property_setter_bind(entry.native, p_name, &index);
+		if (setter && index < 0) {
+			entry.target = INLINE_CACHE_NATIVE_PROPERTY;
+			entry.method = setter;
+		}
+	}
+	_add_inline_cache_entry(p_cache, entry);
+}
+
+void GDScriptFunction::_update_inline_cache_call(int p_cache, const Variant *p_base, const StringName &p_method) {
+	if (_is_inline_cache_full(p_cache)) {
+		return;
+	}
+	// Built-in types are left to Variant::callp(), which finds their methods without hashing the name.
+	// `free()` is handled by Object::callp() before anything else.
+	if (p_base->get_type() != Variant::OBJECT || p_method == CoreStringNames::get_singleton()->_free) {
+		return;
+	}
+
+	InlineCacheEntry entry;
+	bool cacheable = false;
+	GDScriptInstance *instance = _get_inline_cache_guard(p_base, entry, cacheable);
+	if (!cacheable) {
+		return;
+	}
+	entry.target = INLINE_CACHE_UNCACHED;
+
+	if (instance) {
+		// Same lookup order as GDScriptInstance::callp(). `_ready` also runs the implicit ready functions first.
+		if (p_method == SNAME("_ready")) {
+			_add_inline_cache_entry(p_cache, entry);
+			return;
+		}
+		for (const GDScript *sptr = entry.script; sptr; sptr = sptr->_base) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_method);
+			if (E) {
+#ifndef DEBUG_ENABLED
+				// Debug builds go through Object::callp(), which locks the object during the call so it
+				// can't be freed while one of its functions runs.
+				entry.target = INLINE_CACHE_SCRIPT_FUNCTION;
+				entry.function = E->value;
+#endif
+				_add_inline_cache_entry(p_cache, entry);
+				return;
+			}
+		}
+	}
+
+#ifndef DEBUG_ENABLED
+	// Same as for script functions, debug builds need Object::callp() to lock the object.
+	MethodBind *method = _is_inline_cache_native_class(entry.native) ? ClassDB::get_method(entry.native, p_method) : nullptr;
+	if (method) {
+		entry.target = INLINE_CACHE_NATIVE_METHOD;
+		entry.method = method;
+	}
+#endif
+	_add_inline_cache_entry(p_cache, entry);
+}
+
+GDScriptFunction *GDScriptFunction::_get_inline_cache_script_function(int p_cache, GDScriptInstance *p_instance, const StringName &p_name) {
+	const GDScript *script = p_instance->script.ptr();
+	const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, Variant::OBJECT, StringName(), script);
+	if (likely(entry)) {
+		return entry->function;
+	}
+
+	// Same lookup as GDScriptInstance::callp(), the compiler doesn't emit direct calls to `_ready`.
+	GDScriptFunction *function = nullptr;
+	for (const GDScript *sptr = script; sptr && !function; sptr = sptr->_base) {
+		HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+		if (E) {
+			function = E->value;
+		}
+	}
+
+	if (!_is_inline_cache_full(p_cache)) {
+		InlineCacheEntry new_entry;
+		new_entry.type = Variant::OBJECT;
+		new_entry.script = script;
+		new_entry.target = function ? INLINE_CACHE_SCRIPT_FUNCTION : INLINE_CACHE_UNCACHED;
+		new_entry.function = function;
+		_add_inline_cache_entry(p_cache, new_entry);
+	}
+	return function;
+}
+
+bool GDScriptFunction::_inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_ret) {
+	Variant::Type type = p_base->get_type();
+
+	if (type == Variant::OBJECT) {
+		// Same as Variant::get_named().
+		Object *obj = p_base->get_validated_object();
+		if (!obj) {
+			return false;
+		}
+		bool cacheable = false;
+		GDScriptInstance *instance = _get_inline_cache_instance(obj, cacheable);
+		if (!cacheable) {
+			return false;
+		}
+		const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, type, obj->get_class_name(), instance ? instance->script.ptr() : nullptr);
+		if (!entry) {
+			_update_inline_cache_get(p_cache, p_base, p_name);
+			return false;
+		}
+		if (entry->target == INLINE_CACHE_UNCACHED) {
+			return false;
+		}
+
+		if (entry->target == INLINE_CACHE_SCRIPT_MEMBER) {
+			// Copy first, `r_ret` may be the only reference to `obj`.
+			Variant value = instance->members[entry->member_index];
+			*r_ret = value;
+		} else {
+			Callable::CallError ce;
+			*r_ret = entry->method->call(obj, nullptr, 0, ce);
+		}
+		return true;
+	}
+
+	const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, type, StringName(), nullptr);
+	if (!entry) {
+		_update_inline_cache_get(p_cache, p_base, p_name);
+		return false;
+	}
+	if (entry->target == INLINE_CACHE_UNCACHED) {
+		return false;
+	}
+
+	// Validated getters expect the result to already have the right type.
+	if (r_ret != p_base) {
+		VariantInternal::initialize(r_ret, entry->member_type);
+		entry->getter(p_base, r_ret);
+	} else {
+		Variant value;
+		VariantInternal::initialize(&value, entry->member_type);
+		entry->getter(p_base, &value);
+		*r_ret = value;
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	Variant::Type type = p_base->get_type();
+
+	if (type == Variant::OBJECT) {
+		Object *obj = p_base->get_validated_object();
+		if (!obj) {
+			return false;
+		}
+#ifdef TOOLS_ENABLED
+		// Object::set() flags the object as edited, leave that to it.
+		if (!obj->is_edited()) {
+			return false;
+		}
+#endif
+		bool cacheable = false;
+		GDScriptInstance *instance = _get_inline_cache_instance(obj, cacheable);
+		if (!cacheable) {
+			return false;
+		}
+		const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, type, obj->get_class_name(), instance ? instance->script.ptr() : nullptr);
+		if (!entry) {
+			_update_inline_cache_set(p_cache, p_base, p_name);
+			return false;
+		}
+		if (entry->target == INLINE_CACHE_UNCACHED) {
+			return false;
+		}
+
+		if (entry->target == INLINE_CACHE_SCRIPT_MEMBER) {
+			// Values needing a conversion take the regular path.
+			if (entry->member_data_type && !entry->member_data_type->is_type(*p_value)) {
+				return false;
+			}
+			instance->members.write[entry->member_index] = *p_value;
+			r_valid = true;
+		} else {
+			const Variant *args[1] = { p_value };
+			Callable::CallError ce;
+			entry->method->call(obj, args, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		}
+		return true;
+	}
+
+	const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, type, StringName(), nullptr);
+	if (!entry) {
+		_update_inline_cache_set(p_cache, p_base, p_name);
+		return false;
+	}
+	if (entry->target == INLINE_CACHE_UNCACHED) {
+		return false;
+	}
+	// Validated setters expect a value of the member type.
+	if (p_value->get_type() != entry->member_type) {
+		return false;
+	}
+	entry->setter(p_base, p_value);
+	r_valid = true;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_call(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+
+	// Same as Variant::callp().
+	Object *obj = *VariantInternal::get_object(p_base);
+	if (!obj) {
+		return false;
+	}
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_active()) {
+		ObjectID id = VariantInternal::get_object_id(p_base);
+		if (!id.is_ref_counted() && ObjectDB::get_instance(id) == nullptr) {
+			return false;
+		}
+	}
+#endif
+
+	bool cacheable = false;
+	GDScriptInstance *instance = _get_inline_cache_instance(obj, cacheable);
+	if (!cacheable) {
+		return false;
+	}
+	const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, Variant::OBJECT, obj->get_class_name(), instance ? instance->script.ptr() : nullptr);
+	if (!entry) {
+		_update_inline_cache_call(p_cache, p_base, p_method);
+		return false;
+	}
+	if (entry->target == INLINE_CACHE_UNCACHED) {
+		return false;
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+	if (entry->target == INLINE_CACHE_SCRIPT_FUNCTION) {
+		r_ret = entry->function->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = entry->method->call(obj, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -190,6 +687,13 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_ADD_INT,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,              \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,              \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                 \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,            \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,            \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,              \
 		&&OPCODE_TYPE_TEST_BUILTIN,                  \
 		&&OPCODE_TYPE_TEST_ARRAY,                    \
 		&&OPCODE_TYPE_TEST_NATIVE,                   \
@@ -200,6 +704,28 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                          \
 		&&OPCODE_GET_KEYED_VALIDATED,                \
 		&&OPCODE_GET_INDEXED_VALIDATED,              \
+		&&OPCODE_GET_INDEXED_ARRAY,                  \
+		&&OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,      \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,     \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,     \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,   \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,   \
+		&&OPCODE_GET_INDEXED_PACKED_STRING_ARRAY,    \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,   \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,   \
+		&&OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,     \
+		&&OPCODE_SET_INDEXED_ARRAY,                  \
+		&&OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,      \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,     \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,     \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,   \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,   \
+		&&OPCODE_SET_INDEXED_PACKED_STRING_ARRAY,    \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,   \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,   \
+		&&OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,     \
+		&&OPCODE_ARRAY_SIZE,                         \
+		&&OPCODE_ARRAY_APPEND,                       \
 		&&OPCODE_SET_NAMED,                          \
 		&&OPCODE_SET_NAMED_VALIDATED,                \
 		&&OPCODE_GET_NAMED,                          \
@@ -231,6 +757,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_CALL_GDSCRIPT_UTILITY,              \
 		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,        \
 		&&OPCODE_CALL_SELF_BASE,                     \
+		&&OPCODE_CALL_SCRIPT_FUNCTION,               \
 		&&OPCODE_CALL_METHOD_BIND,                   \
 		&&OPCODE_CALL_METHOD_BIND_RET,               \
 		&&OPCODE_CALL_BUILTIN_STATIC,                \
@@ -274,6 +801,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_CALL_PTRCALL_PACKED_VECTOR3_ARRAY,  \
 		&&OPCODE_CALL_PTRCALL_PACKED_COLOR_ARRAY,    \
 		&&OPCODE_AWAIT,                              \
+		&&OPCODE_AWAIT_TIMER,                        \
 		&&OPCODE_AWAIT_RESUME,                       \
 		&&OPCODE_CREATE_LAMBDA,                      \
 		&&OPCODE_CREATE_SELF_LAMBDA,                 \
@@ -282,6 +810,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP_IF_NOT,                        \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,               \
 		&&OPCODE_JUMP_IF_SHARED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,         \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,     \
 		&&OPCODE_RETURN,                             \
 		&&OPCODE_RETURN_TYPED_BUILTIN,               \
 		&&OPCODE_RETURN_TYPED_ARRAY,                 \
@@ -450,6 +980,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	// The translated function calls the others of its script directly, which is only
+	// equivalent to the bytecode if they can't be overridden by the instance's script.
+	if (native_call && !p_state && (!p_instance || p_instance->script.ptr() == _script)) {
+#ifdef DEBUG_ENABLED
+		// Debugging needs the bytecode, for breakpoints and errors.
+		if (!EngineDebugger::is_active()) {
+			return _call_native(p_args, p_argcount, r_err);
+		}
+#else
+		return _call_native(p_args, p_argcount, r_err);
+#endif
+	}
+
 	r_err.error = Callable::CallError::CALL_OK;
 
 	static thread_local int call_depth = 0;
@@ -590,6 +1133,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	std::atomic<int> *sampled_line = nullptr;
+	if (unlikely(GDScriptSamplingProfiler::is_active())) {
+		sampled_line = GDScriptSamplingProfiler::enter_function(this, line);
+	}
+
+	if (_inline_caches) {
+		inline_cache_calls.increment();
+	}
+
 #ifdef DEBUG_ENABLED
 
 	if (EngineDebugger::is_active()) {
@@ -736,6 +1288,26 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+// Same as a validated operator, but computed in place instead of through the evaluator.
+#define OPCODE_OPERATOR_INLINE(m_op, m_type, m_get_func, m_operator)                                                     \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_type) {                                                                          \
+		CHECK_SPACE(3);                                                                                                  \
+		GET_VARIANT_PTR(a, 0);                                                                                           \
+		GET_VARIANT_PTR(b, 1);                                                                                           \
+		GET_VARIANT_PTR(dst, 2);                                                                                         \
+		*VariantInternal::m_get_func(dst) = *VariantInternal::m_get_func(a) m_operator(*VariantInternal::m_get_func(b)); \
+		ip += 4;                                                                                                         \
+	}                                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_INLINE(ADD, INT, get_int, +);
+			OPCODE_OPERATOR_INLINE(SUBTRACT, INT, get_int, -);
+			OPCODE_OPERATOR_INLINE(MULTIPLY, INT, get_int, *);
+			OPCODE_OPERATOR_INLINE(ADD, FLOAT, get_float, +);
+			OPCODE_OPERATOR_INLINE(SUBTRACT, FLOAT, get_float, -);
+			OPCODE_OPERATOR_INLINE(MULTIPLY, FLOAT, get_float, *);
+			OPCODE_OPERATOR_INLINE(DIVIDE, FLOAT, get_float, /);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1026,9 +1598,244 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
-			OPCODE(OPCODE_SET_NAMED) {
+#ifdef DEBUG_ENABLED
+#define OPCODE_INDEXED_ARRAY_OOB(m_base, m_index, m_action)                                                           \
+	err_text = "Out of bounds " m_action " index '" + itos(m_index) + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define OPCODE_INDEXED_ARRAY_OOB(m_base, m_index, m_action) \
+	ip += 4;                                                \
+	DISPATCH_OPCODE
+#endif
+
+			OPCODE(OPCODE_GET_INDEXED_ARRAY) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const Array *array = VariantInternal::get_array(src);
+				int64_t int_index = *VariantInternal::get_int(index);
+				if (int_index < 0) {
+					int_index += array->size();
+				}
+				if (int_index < 0 || int_index >= array->size()) {
+					OPCODE_INDEXED_ARRAY_OOB(src, *VariantInternal::get_int(index), "get");
+				}
+				// Copy first, `dst` may be the array itself.
+				Variant value = (*array)[int_index];
+				*dst = value;
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_var_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                                 \
+		CHECK_SPACE(3);                                                                                      \
+		GET_VARIANT_PTR(src, 0);                                                                             \
+		GET_VARIANT_PTR(index, 1);                                                                           \
+		GET_VARIANT_PTR(dst, 2);                                                                             \
+		const Vector<m_elem_type> *array = VariantInternal::m_get_func((const Variant *)src);                \
+		int64_t int_index = *VariantInternal::get_int(index);                                                \
+		if (int_index < 0) {                                                                                 \
+			int_index += array->size();                                                                      \
+		}                                                                                                    \
+		if (int_index < 0 || int_index >= array->size()) {                                                   \
+			OPCODE_INDEXED_ARRAY_OOB(src, *VariantInternal::get_int(index), "get");                          \
+		}                                                                                                    \
+		m_elem_type value = array->ptr()[int_index];                                                         \
+		if (dst->get_type() != Variant::m_var_ret_type) {                                                    \
+			VariantInternal::initialize(dst, Variant::m_var_ret_type);                                       \
+		}                                                                                                    \
+		*VariantInternal::m_ret_get_func(dst) = value;                                                       \
+		ip += 4;                                                                                             \
+	}                                                                                                        \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, INT, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, INT, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, INT, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, FLOAT, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, FLOAT, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(STRING, String, get_string_array, STRING, get_string);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, VECTOR2, get_vector2);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, VECTOR3, get_vector3);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, COLOR, get_color);
+
+			OPCODE(OPCODE_SET_INDEXED_ARRAY) {
 				CHECK_SPACE(3);
 
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				Array *array = VariantInternal::get_array(dst);
+#ifdef DEBUG_ENABLED
+				if (array->is_read_only()) {
+					err_text = "Cannot set an element of a read-only array.";
+					OPCODE_BREAK;
+				}
+#endif
+				int64_t int_index = *VariantInternal::get_int(index);
+				if (int_index < 0) {
+					int_index += array->size();
+				}
+				if (int_index < 0 || int_index >= array->size()) {
+					OPCODE_INDEXED_ARRAY_OOB(dst, *VariantInternal::get_int(index), "set");
+				}
+				// Goes through Array::set() so typed arrays still validate the value.
+				array->set(int_index, *value);
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_SET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_value_get_func) \
+	OPCODE(OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                   \
+		CHECK_SPACE(3);                                                                        \
+		GET_VARIANT_PTR(dst, 0);                                                               \
+		GET_VARIANT_PTR(index, 1);                                                             \
+		GET_VARIANT_PTR(value, 2);                                                             \
+		Vector<m_elem_type> *array = VariantInternal::m_get_func(dst);                         \
+		int64_t int_index = *VariantInternal::get_int(index);                                  \
+		if (int_index < 0) {                                                                   \
+			int_index += array->size();                                                        \
+		}                                                                                      \
+		if (int_index < 0 || int_index >= array->size()) {                                     \
+			OPCODE_INDEXED_ARRAY_OOB(dst, *VariantInternal::get_int(index), "set");            \
+		}                                                                                      \
+		array->write[int_index] = (m_elem_type)*VariantInternal::m_value_get_func(value);      \
+		ip += 4;                                                                               \
+	}                                                                                          \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(STRING, String, get_string_array, get_string);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, get_vector2);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, get_vector3);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, get_color);
+
+#undef OPCODE_INDEXED_ARRAY_OOB
+
+			OPCODE(OPCODE_ARRAY_SIZE) {
+				CHECK_SPACE(2);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				int64_t size = 0;
+				switch (src->get_type()) {
+					case Variant::ARRAY:
+						size = VariantInternal::get_array(src)->size();
+						break;
+					case Variant::PACKED_BYTE_ARRAY:
+						size = VariantInternal::get_byte_array(src)->size();
+						break;
+					case Variant::PACKED_INT32_ARRAY:
+						size = VariantInternal::get_int32_array(src)->size();
+						break;
+					case Variant::PACKED_INT64_ARRAY:
+						size = VariantInternal::get_int64_array(src)->size();
+						break;
+					case Variant::PACKED_FLOAT32_ARRAY:
+						size = VariantInternal::get_float32_array(src)->size();
+						break;
+					case Variant::PACKED_FLOAT64_ARRAY:
+						size = VariantInternal::get_float64_array(src)->size();
+						break;
+					case Variant::PACKED_STRING_ARRAY:
+						size = VariantInternal::get_string_array(src)->size();
+						break;
+					case Variant::PACKED_VECTOR2_ARRAY:
+						size = VariantInternal::get_vector2_array(src)->size();
+						break;
+					case Variant::PACKED_VECTOR3_ARRAY:
+						size = VariantInternal::get_vector3_array(src)->size();
+						break;
+					case Variant::PACKED_COLOR_ARRAY:
+						size = VariantInternal::get_color_array(src)->size();
+						break;
+					default: {
+#ifdef DEBUG_ENABLED
+						err_text = "Invalid base type '" + _get_var_type(src) + "' for array size.";
+#endif
+						OPCODE_BREAK;
+					}
+				}
+
+				if (dst->get_type() != Variant::INT) {
+					VariantInternal::initialize(dst, Variant::INT);
+				}
+				*VariantInternal::get_int(dst) = size;
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ARRAY_APPEND) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(base, 0);
+				GET_VARIANT_PTR(value, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				bool failed = false;
+				switch (base->get_type()) {
+					case Variant::ARRAY: {
+						// Goes through Array::push_back() so typed and read-only arrays are still checked.
+						VariantInternal::get_array(base)->push_back(*value);
+					} break;
+					case Variant::PACKED_BYTE_ARRAY:
+						failed = VariantInternal::get_byte_array(base)->push_back(*VariantInternal::get_int(value));
+						break;
+					case Variant::PACKED_INT32_ARRAY:
+						failed = VariantInternal::get_int32_array(base)->push_back(*VariantInternal::get_int(value));
+						break;
+					case Variant::PACKED_INT64_ARRAY:
+						failed = VariantInternal::get_int64_array(base)->push_back(*VariantInternal::get_int(value));
+						break;
+					case Variant::PACKED_FLOAT32_ARRAY:
+						failed = VariantInternal::get_float32_array(base)->push_back(*VariantInternal::get_float(value));
+						break;
+					case Variant::PACKED_FLOAT64_ARRAY:
+						failed = VariantInternal::get_float64_array(base)->push_back(*VariantInternal::get_float(value));
+						break;
+					case Variant::PACKED_STRING_ARRAY:
+						failed = VariantInternal::get_string_array(base)->push_back(*VariantInternal::get_string(value));
+						break;
+					case Variant::PACKED_VECTOR2_ARRAY:
+						failed = VariantInternal::get_vector2_array(base)->push_back(*VariantInternal::get_vector2(value));
+						break;
+					case Variant::PACKED_VECTOR3_ARRAY:
+						failed = VariantInternal::get_vector3_array(base)->push_back(*VariantInternal::get_vector3(value));
+						break;
+					case Variant::PACKED_COLOR_ARRAY:
+						failed = VariantInternal::get_color_array(base)->push_back(*VariantInternal::get_color(value));
+						break;
+					default: {
+#ifdef DEBUG_ENABLED
+						err_text = "Invalid base type '" + _get_var_type(base) + "' for array append.";
+#endif
+						OPCODE_BREAK;
+					}
+				}
+
+				if (base->get_type() != Variant::ARRAY) {
+					if (dst->get_type() != Variant::BOOL) {
+						VariantInternal::initialize(dst, Variant::BOOL);
+					}
+					*VariantInternal::get_bool(dst) = failed;
+				}
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_SET_NAMED) {
+				CHECK_SPACE(4);
+
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
 
@@ -1037,8 +1844,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set(inline_cache, dst, *index, value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1055,7 +1867,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1075,7 +1887,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1085,22 +1897,27 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
+				if (!_inline_cache_get(inline_cache, src, *index, dst)) {
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+					*dst = src->get_named(*index, valid);
 #endif
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
-					OPCODE_BREAK;
-				}
-				*dst = ret;
+					if (!valid) {
+						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1626,7 +2443,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1637,6 +2454,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1656,7 +2476,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Object *base_obj = base->get_validated_object();
 					StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
 #endif
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1686,7 +2508,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1731,7 +2555,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2313,6 +3137,87 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_SCRIPT_FUNCTION) {
+				LOAD_INSTRUCTION_ARGS
+				CHECK_SPACE(4 + instr_arg_count);
+
+				ip += instr_arg_count;
+
+				int argc = _code_ptr[ip + 1];
+				GD_ERR_BREAK(argc < 0);
+
+				int methodname_idx = _code_ptr[ip + 2];
+				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
+				const StringName *methodname = &_global_names_ptr[methodname_idx];
+
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_cache_count);
+
+				GET_INSTRUCTION_ARG(base, argc);
+				GET_INSTRUCTION_ARG(ret, argc + 1);
+				Variant **argptrs = instruction_args;
+
+				// The compiler only emits this when the function is known to be a script one, so
+				// skip Object::callp() and GDScriptInstance::callp() and call it directly.
+				GDScriptInstance *instance = nullptr;
+				if (base == &stack[ADDR_STACK_SELF]) {
+					instance = p_instance;
+				}
+#ifndef DEBUG_ENABLED
+				// Debug builds call other objects through Object::callp(), which locks them during the call.
+				else if (base->get_type() == Variant::OBJECT) {
+					Object *base_obj = *VariantInternal::get_object(base);
+					if (base_obj) {
+						bool cacheable = false;
+						instance = _get_inline_cache_instance(base_obj, cacheable);
+					}
+				}
+#endif
+				GDScriptFunction *function = instance ? _get_inline_cache_script_function(inline_cache, instance, *methodname) : nullptr;
+
+#ifdef DEBUG_ENABLED
+				uint64_t call_time = 0;
+
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					call_time = OS::get_singleton()->get_ticks_usec();
+				}
+#endif
+
+				Callable::CallError err;
+				if (function) {
+					*ret = function->call(instance, (const Variant **)argptrs, argc, err);
+				} else {
+					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+				}
+
+#ifdef DEBUG_ENABLED
+				if (GDScriptLanguage::get_singleton()->profiling) {
+					function_call_time += OS::get_singleton()->get_ticks_usec() - call_time;
+				}
+
+				if (err.error != Callable::CallError::CALL_OK) {
+					String methodstr = *methodname;
+					String basestr = _get_var_type(base);
+					err_text = _get_call_error(err, "function '" + methodstr + "' in base '" + basestr + "'", (const Variant **)argptrs);
+					OPCODE_BREAK;
+				}
+
+				if (ret->get_type() == Variant::OBJECT) {
+					// Check if getting a function state without await.
+					bool was_freed = false;
+					Object *obj = ret->get_validated_object_with_check(was_freed);
+
+					if (obj && obj->is_class_ptr(GDScriptFunctionState::get_class_ptr_static())) {
+						err_text = R"(Trying to call an async function without "await".)";
+						OPCODE_BREAK;
+					}
+				}
+#endif
+
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_AWAIT) {
 				CHECK_SPACE(2);
 
@@ -2354,40 +3259,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 				if (is_signal) {
-					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
-					gdfs->function = this;
-
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-					}
-					gdfs->state.stack_size = _stack_size;
-					gdfs->state.alloca_size = alloca_size;
-					gdfs->state.ip = ip + 2;
-					gdfs->state.line = line;
-					gdfs->state.script = _script;
-					{
-						MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
-						_script->pending_func_states.add(&gdfs->scripts_list);
-						if (p_instance) {
-							gdfs->state.instance = p_instance;
-							p_instance->pending_func_states.add(&gdfs->instances_list);
-						} else {
-							gdfs->state.instance = nullptr;
-						}
-					}
-#ifdef DEBUG_ENABLED
-					gdfs->state.function_name = name;
-					gdfs->state.script_path = _script->get_script_path();
-#endif
-					gdfs->state.defarg = defarg;
-					gdfs->function = this;
-
+					Ref<GDScriptFunctionState> gdfs = _create_await_state(p_instance, stack, alloca_size, ip + 2, line, defarg);
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = sig.connect(Callable(memnew(GDScriptFunctionStateCallable(gdfs))), Object::CONNECT_ONE_SHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -2402,6 +3277,45 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE; // Needed for synchronous calls (when result is immediately available).
 
+			OPCODE(OPCODE_AWAIT_TIMER) {
+				CHECK_SPACE(6);
+
+				// Same as awaiting the timeout of `create_timer()`, with the arguments already checked by the compiler.
+				GET_VARIANT_PTR(base, 0);
+				GET_VARIANT_PTR(delay, 1);
+				GET_VARIANT_PTR(process_always, 2);
+				GET_VARIANT_PTR(process_in_physics, 3);
+				GET_VARIANT_PTR(ignore_time_scale, 4);
+
+				bool was_freed = false;
+				SceneTree *tree = Object::cast_to<SceneTree>(base->get_validated_object_with_check(was_freed));
+				if (!tree) {
+					if (was_freed) {
+						err_text = "Cannot call method 'create_timer' on a previously freed instance.";
+					} else {
+						err_text = "Cannot call method 'create_timer' on a null value.";
+					}
+					OPCODE_BREAK;
+				}
+
+				// Read before creating the state, which moves the stack away.
+				const double delay_sec = *delay;
+				const bool always = *process_always;
+				const bool in_physics = *process_in_physics;
+				const bool ignore_scale = *ignore_time_scale;
+
+				Ref<GDScriptFunctionState> gdfs = _create_await_state(p_instance, stack, alloca_size, ip + 6, line, defarg);
+				retvalue = gdfs;
+
+				tree->add_timer_callback(delay_sec, Callable(memnew(GDScriptFunctionStateCallable(gdfs))), always, in_physics, ignore_scale);
+
+#ifdef DEBUG_ENABLED
+				exit_ok = true;
+				awaited = true;
+#endif
+				OPCODE_BREAK;
+			}
+
 			OPCODE(OPCODE_AWAIT_RESUME) {
 				CHECK_SPACE(2);
 #ifdef DEBUG_ENABLED
@@ -2429,14 +3343,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
-				Vector<Variant> captures;
-				captures.resize(captures_count);
-				for (int i = 0; i < captures_count; i++) {
-					GET_INSTRUCTION_ARG(arg, i);
-					captures.write[i] = *arg;
-				}
-
-				GDScriptLambdaCallable *callable = memnew(GDScriptLambdaCallable(Ref<GDScript>(script), lambda, captures));
+				GDScriptLambdaCallable *callable = memnew(GDScriptLambdaCallable(Ref<GDScript>(script), lambda, (const Variant **)instruction_args, captures_count));
 
 				GET_INSTRUCTION_ARG(result, captures_count);
 				*result = Callable(callable);
@@ -2460,18 +3367,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
-				Vector<Variant> captures;
-				captures.resize(captures_count);
-				for (int i = 0; i < captures_count; i++) {
-					GET_INSTRUCTION_ARG(arg, i);
-					captures.write[i] = *arg;
-				}
-
 				GDScriptLambdaSelfCallable *callable;
 				if (Object::cast_to<RefCounted>(p_instance->owner)) {
-					callable = memnew(GDScriptLambdaSelfCallable(Ref<RefCounted>(Object::cast_to<RefCounted>(p_instance->owner)), lambda, captures));
+					callable = memnew(GDScriptLambdaSelfCallable(Ref<RefCounted>(Object::cast_to<RefCounted>(p_instance->owner)), lambda, (const Variant **)instruction_args, captures_count));
 				} else {
-					callable = memnew(GDScriptLambdaSelfCallable(p_instance->owner, lambda, captures));
+					callable = memnew(GDScriptLambdaSelfCallable(p_instance->owner, lambda, (const Variant **)instruction_args, captures_count));
 				}
 
 				GET_INSTRUCTION_ARG(result, captures_count);
@@ -2545,6 +3445,52 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_RETURN) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 0);
@@ -3546,6 +4492,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				if (unlikely(sampled_line)) {
+					sampled_line->store(line, std::memory_order_relaxed);
+				}
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3659,6 +4609,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+	if (unlikely(sampled_line)) {
+		GDScriptSamplingProfiler::exit_function();
+	}
+
+	// Last call out, nothing can be reading the replaced inline cache states anymore.
+	if (_inline_caches && inline_cache_calls.decrement() == 0 && unlikely(has_retired_inline_cache_states.is_set())) {
+		_free_retired_inline_cache_states();
+	}
+
 	call_depth--;
 
 	return retvalue;
@@ -32,12 +32,15 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_registry.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/gdscript_highlighter.h"
+#include "editor/gdscript_native_translator.h"
 #include "editor/gdscript_translation_parser_plugin.h"
 
 #ifndef GDSCRIPT_NO_LSP
@@ -81,7 +84,70 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	// Where the scripts are translated to C++ for builds made with the `gdscript_native_dir` option, empty if they aren't.
+	String native_dir;
+	Vector<String> native_register_functions;
+
+	void _save_native_register_all() {
+		const String file = native_dir.path_join("gdscript_native_register.gen.cpp");
+		Ref<FileAccess> f = FileAccess::open(file, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), "Cannot write '" + file + "'.");
+		f->store_string(GDScriptNativeTranslator::make_register_all(native_register_functions));
+	}
+
+	void _translate_script(const String &p_path) {
+		// Same source as loaded at runtime, the functions are only used if its hash matches.
+		const String source = GDScriptCache::get_source_code(p_path);
+		GDScriptParser parser;
+		if (parser.parse(source, p_path, false) != OK) {
+			return;
+		}
+		GDScriptAnalyzer analyzer(&parser);
+		if (analyzer.analyze() != OK) {
+			return;
+		}
+
+		GDScriptNativeTranslator::Result result;
+		if (GDScriptNativeTranslator::translate(&parser, p_path, source, result) != OK) {
+			return;
+		}
+		const String file = native_dir.path_join(result.register_function.trim_prefix("gdscript_native_register_") + ".gen.cpp");
+		Ref<FileAccess> f = FileAccess::open(file, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), "Cannot write '" + file + "'.");
+		f->store_string(result.code);
+
+		native_register_functions.push_back(result.register_function);
+		_save_native_register_all();
+		print_verbose(vformat("GDScript: Translated %d functions of \"%s\" to C++.", result.functions.size(), p_path));
+	}
+
 public:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_translation_dir", PROPERTY_HINT_GLOBAL_DIR), ""));
+	}
+
+	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
+		native_dir = get_option("gdscript/native_translation_dir");
+		native_register_functions.clear();
+		if (native_dir.is_empty()) {
+			return;
+		}
+
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		if (da->make_dir_recursive(native_dir) != OK || da->change_dir(native_dir) != OK) {
+			ERR_PRINT("Cannot create the GDScript translation directory '" + native_dir + "'.");
+			native_dir = String();
+			return;
+		}
+		// Translations left from a previous export could be of scripts that were removed since.
+		for (const String &file : da->get_files()) {
+			if (file.ends_with(".gen.cpp")) {
+				da->remove(file);
+			}
+		}
+		_save_native_register_all();
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		String script_key;
 
@@ -95,6 +161,10 @@ public:
 			return;
 		}
 
+		if (!native_dir.is_empty()) {
+			_translate_script(p_path);
+		}
+
 		return;
 	}
 
@@ -138,6 +208,7 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+		GDScriptNativeRegistry::initialize();
 	}
 
 #ifdef TOOLS_ENABLED
@@ -158,6 +229,8 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 			memdelete(gdscript_cache);
 		}
 
+		GDScriptBytecodeCache::finish();
+
 		if (script_language_gd) {
 			memdelete(script_language_gd);
 		}
@@ -169,6 +242,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 		resource_saver_gd.unref();
 
 		GDScriptParser::cleanup();
+		GDScriptNativeRegistry::finish();
 		GDScriptUtilityFunctions::unregister_functions();
 	}
 
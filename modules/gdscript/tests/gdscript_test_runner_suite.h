@@ -33,7 +33,25 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_bytecode_optimizer.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_native_registry.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampling_profiler.h"
+
+#ifdef TOOLS_ENABLED
+#include "../editor/gdscript_native_translator.h"
+#include "../gdscript_analyzer.h"
+#endif
+
+#include "core/io/dir_access.h"
+#include "core/variant/variant_internal.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
 #include "tests/test_macros.h"
+#include "tests/test_tools.h"
 
 namespace GDScriptTests {
 
@@ -48,6 +66,16 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime with bytecode optimizer") {
+		// The expected output is the one of the unoptimized code, so this checks the optimizer doesn't change behavior.
+		GDScriptBytecodeOptimizer::set_verification_mode(true);
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true);
+		int fail_count = runner.run_tests();
+		GDScriptBytecodeOptimizer::set_verification_mode(false);
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass with the bytecode optimizer.");
+	}
 }
 
 TEST_CASE("[Modules][GDScript] Load source code dynamically and run it") {
@@ -71,6 +99,602 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[SceneTree][Modules][GDScript] Await timers") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends Node
+
+var resumed := []
+
+func wait(delay: float, label: String) -> void:
+	var local_delay := delay
+	await get_tree().create_timer(local_delay).timeout
+	resumed.append(label)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	SUBCASE("Delay held in a variable") {
+		Node *node = memnew(Node);
+		node->set_script(gdscript);
+		SceneTree::get_singleton()->get_root()->add_child(node);
+
+		node->call("wait", 0.5, "late");
+		node->call("wait", 0.1, "early");
+		SceneTree::get_singleton()->process(0.25);
+		Array resumed = node->get("resumed");
+		REQUIRE_MESSAGE(resumed.size() == 1, "Only the timer with the shorter delay should have fired.");
+		CHECK(String(resumed[0]) == "early");
+
+		SceneTree::get_singleton()->process(0.5);
+		resumed = node->get("resumed");
+		REQUIRE(resumed.size() == 2);
+		CHECK(String(resumed[1]) == "late");
+
+		memdelete(node);
+	}
+
+	SUBCASE("Instance freed before the timer fires") {
+		Node *node = memnew(Node);
+		node->set_script(gdscript);
+		SceneTree::get_singleton()->get_root()->add_child(node);
+
+		node->call("wait", 0.1, "freed");
+		memdelete(node);
+
+		ErrorDetector ed;
+		SceneTree::get_singleton()->process(0.25);
+		CHECK_FALSE_MESSAGE(ed.has_error, "The pending await should be dropped silently once its instance is gone.");
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Script freed when an await completes") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+signal go
+
+func wait() -> int:
+	var value := 1
+	await go
+	return value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	const ObjectID script_id = gdscript->get_instance_id();
+	gdscript.unref();
+
+	Ref<GDScriptFunctionState> state = object->call("wait");
+	REQUIRE(state.is_valid());
+	// Clearing the script frees its instance, which holds the last reference to the script and so its functions.
+	state->connect(SNAME("completed"), Callable(object.ptr(), "set_script").bind(Variant()).unbind(1));
+
+	object->emit_signal(SNAME("go"));
+	CHECK_MESSAGE(ObjectDB::get_instance(script_id) == nullptr, "The script should be freed once the resumed function is done with it.");
+	CHECK_FALSE(state->is_valid());
+}
+
+TEST_CASE("[SceneTree][Modules][GDScript] Pooled scene instances reset their scripts") {
+	const String source = R"(
+extends Node
+
+@export var health := 10
+var hits := 0
+var resets := 0
+
+func _pool_reset():
+	hits = 0
+	resets += 1
+)";
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<GDScript> gdscript_without_reset = memnew(GDScript);
+	gdscript_without_reset->set_source_code(source.replace("func _pool_reset():", "func _other():"));
+	ERR_PRINT_OFF;
+	error = gdscript_without_reset->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	for (const Ref<GDScript> &E : { gdscript, gdscript_without_reset }) {
+		Node *root = memnew(Node);
+		root->set_script(E);
+		root->set("health", 20);
+
+		Ref<PackedScene> packed_scene;
+		packed_scene.instantiate();
+		REQUIRE(packed_scene->pack(root) == OK);
+		memdelete(root);
+		packed_scene->set_pool_capacity(1);
+
+		Node *instance = packed_scene->instantiate();
+		REQUIRE(instance != nullptr);
+		SceneTree::get_singleton()->get_root()->add_child(instance);
+		instance->set("health", 5);
+		instance->set("hits", 3);
+		instance->queue_free();
+		SceneTree::get_singleton()->process(0);
+
+		if (E == gdscript_without_reset) {
+			CHECK_MESSAGE(packed_scene->get_pooled_instance_count() == 0, "Scripts that can't reset their variables should not be pooled.");
+			continue;
+		}
+
+		REQUIRE(packed_scene->get_pooled_instance_count() == 1);
+		Node *reused = packed_scene->instantiate();
+		CHECK(reused == instance);
+		CHECK_MESSAGE(int(reused->get("health")) == 20, "Exported variables should be restored from the scene.");
+		CHECK_MESSAGE(int(reused->get("hits")) == 0, "Other variables should be reset by the script.");
+		CHECK_MESSAGE(int(reused->get("resets")) == 1, "The script should be asked to reset once.");
+		memdelete(reused);
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache round trip") {
+	const String source = R"(
+extends RefCounted
+
+const VALUES: Array[int] = [1, 2, 3]
+
+class Inner:
+	var factor := 2
+
+	func scale(value: int) -> int:
+		return value * factor
+
+var offset := Vector2(1.5, 2.0)
+
+func run() -> String:
+	var inner := Inner.new()
+	var total := 0
+	for value in VALUES:
+		total += inner.scale(value)
+	var add := func(a: int, b: int) -> int: return a + b
+	total = add.call(total, int(offset.length()))
+	set_meta("total", total)
+	return "%d:%s" % [total, str(offset.x)] + str(is_instance_valid(self)) + str(Node.NOTIFICATION_READY)
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Vector<uint8_t> buffer;
+	error = GDScriptBytecodeCache::serialize(gdscript.ptr(), Vector<GDScriptBytecodeCache::Dependency>(), buffer);
+	REQUIRE_MESSAGE(error == OK, "The compiled script should be serialized successfully.");
+
+	Ref<GDScript> cached = memnew(GDScript);
+	cached->set_source_code(source);
+	ERR_PRINT_OFF;
+	error = GDScriptBytecodeCache::deserialize_class_tree(cached.ptr(), buffer);
+	if (error == OK) {
+		error = GDScriptBytecodeCache::deserialize(cached.ptr(), buffer);
+	}
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The serialized script should be loaded successfully.");
+	CHECK(cached->is_valid());
+
+	Ref<RefCounted> original_object = memnew(RefCounted);
+	original_object->set_script(gdscript);
+	Ref<RefCounted> cached_object = memnew(RefCounted);
+	cached_object->set_script(cached);
+	CHECK_MESSAGE(String(cached_object->call("run")) == "14:1.5true13", "The loaded script should run like the compiled one.");
+	CHECK(String(cached_object->call("run")) == String(original_object->call("run")));
+	CHECK(int(cached_object->get_meta("total")) == 14);
+
+	Ref<GDScript> truncated = memnew(GDScript);
+	truncated->set_source_code(source);
+	ERR_PRINT_OFF;
+	error = GDScriptBytecodeCache::deserialize(truncated.ptr(), buffer.slice(0, buffer.size() / 2));
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(error != OK, "A truncated buffer should be rejected.");
+	CHECK_FALSE(truncated->is_valid());
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache invalidation") {
+	const String dependency_path = OS::get_singleton()->get_cache_path().path_join("bytecode_cache_dependency.gd");
+	{
+		Ref<FileAccess> f = FileAccess::open(dependency_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("extends RefCounted\n");
+	}
+
+	const String source = R"(
+extends RefCounted
+
+func run() -> int:
+	return 42
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	GDScriptCache::remove_script(dependency_path);
+	Vector<GDScriptBytecodeCache::Dependency> dependencies;
+	GDScriptBytecodeCache::Dependency dependency;
+	dependency.path = dependency_path;
+	dependency.source_hash = GDScriptCache::get_source_hash(dependency_path);
+	dependencies.push_back(dependency);
+
+	Vector<uint8_t> buffer;
+	error = GDScriptBytecodeCache::serialize(gdscript.ptr(), dependencies, buffer);
+	REQUIRE_MESSAGE(error == OK, "The compiled script should be serialized successfully.");
+	CHECK_MESSAGE(GDScriptBytecodeCache::check_buffer(gdscript.ptr(), buffer) == OK, "The cache should be used while nothing changed.");
+
+	Vector<uint8_t> corrupt = buffer;
+	corrupt.write[corrupt.size() - 1] ^= 0xFF;
+	CHECK_MESSAGE(GDScriptBytecodeCache::check_buffer(gdscript.ptr(), corrupt) == ERR_FILE_CORRUPT, "A damaged cache should fail its checksum.");
+
+	{
+		Ref<FileAccess> f = FileAccess::open(dependency_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("extends RefCounted\n\nvar changed := true\n");
+	}
+	GDScriptCache::remove_script(dependency_path);
+	CHECK_MESSAGE(GDScriptBytecodeCache::check_buffer(gdscript.ptr(), buffer) == ERR_FILE_MISSING_DEPENDENCIES, "The cache should be invalidated once a dependency changed.");
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(dependency_path);
+}
+
+TEST_CASE("[Modules][GDScript] Loading a script parses it once") {
+	const String script_path = OS::get_singleton()->get_cache_path().path_join("parse_once.gd");
+	{
+		Ref<FileAccess> f = FileAccess::open(script_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("extends RefCounted\n\nfunc run() -> int:\n\treturn 42\n");
+	}
+	GDScriptCache::remove_script(script_path);
+
+	const uint64_t parse_count = GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE);
+	Error error = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(script_path, error);
+	REQUIRE_MESSAGE(error == OK, "The script should load successfully.");
+	CHECK(gdscript->is_valid());
+	CHECK_MESSAGE(GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE) - parse_count == 1, "Compiling the script should reuse the tree parsed when it was first loaded.");
+
+	gdscript.unref();
+	GDScriptCache::remove_script(script_path);
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(script_path);
+}
+
+static void write_script(const String &p_path, const String &p_source) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_source);
+}
+
+static String get_parsed_icon_path(const String &p_path) {
+	Error error = OK;
+	Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(p_path, GDScriptParserRef::INHERITANCE_SOLVED, error);
+	REQUIRE(error == OK);
+	return parser_ref->get_parser()->get_tree()->icon_path;
+}
+
+TEST_CASE("[Modules][GDScript] Reloading a script updates its annotations") {
+	const String script_path = OS::get_singleton()->get_cache_path().path_join("reload_annotations.gd");
+	write_script(script_path, "@tool\n@icon(\"res://first.svg\")\nextends RefCounted\n\nfunc run() -> int:\n\treturn 1\n");
+	GDScriptCache::remove_script(script_path);
+
+	// Compiled from the tree parsed by the cache, whose analysis applies the annotations of the script.
+	Error error = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(script_path, error);
+	REQUIRE_MESSAGE(error == OK, "The script should load successfully.");
+	CHECK(gdscript->is_tool());
+	CHECK(get_parsed_icon_path(script_path) == "res://first.svg");
+
+	write_script(script_path, "@icon(\"res://second.svg\")\nextends RefCounted\n\nfunc run() -> int:\n\treturn 2\n");
+
+	SUBCASE("Reloaded from disk") {
+		gdscript = GDScriptCache::get_full_script(script_path, error, String(), true);
+		REQUIRE_MESSAGE(error == OK, "The script should reload successfully.");
+		CHECK_FALSE_MESSAGE(gdscript->is_tool(), "Removing `@tool` should be picked up by the reload.");
+	}
+
+	SUBCASE("Loaded again") {
+		GDScriptCache::remove_script(script_path);
+		const uint64_t parse_count = GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE);
+		gdscript = GDScriptCache::get_full_script(script_path, error);
+		REQUIRE_MESSAGE(error == OK, "The script should load successfully.");
+		CHECK(GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE) - parse_count == 1);
+		CHECK_FALSE_MESSAGE(gdscript->is_tool(), "Removing `@tool` should be picked up when loading the script again.");
+	}
+
+	CHECK(get_parsed_icon_path(script_path) == "res://second.svg");
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	CHECK(int(object->call("run")) == 2);
+
+	object.unref();
+	gdscript.unref();
+	GDScriptCache::remove_script(script_path);
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(script_path);
+}
+
+TEST_CASE("[Modules][GDScript] Reloading a dependency of cached scripts") {
+	const String dependency_path = OS::get_singleton()->get_cache_path().path_join("reload_dependency.gd");
+	const String script_path = OS::get_singleton()->get_cache_path().path_join("reload_dependent.gd");
+	write_script(dependency_path, "extends RefCounted\n\nstatic func value() -> int:\n\treturn 1\n");
+	write_script(script_path, vformat("extends RefCounted\n\nconst Dependency = preload(\"%s\")\n\nfunc run() -> int:\n\treturn Dependency.value()\n", dependency_path));
+	GDScriptCache::remove_script(dependency_path);
+	GDScriptCache::remove_script(script_path);
+
+	Error error = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(script_path, error);
+	REQUIRE_MESSAGE(error == OK, "The script should load successfully.");
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	CHECK(int(object->call("run")) == 1);
+
+	// A parser of the previous source, as a dependent being analyzed would hold, must not be compiled from.
+	Ref<GDScriptParserRef> stale_parser = GDScriptCache::get_parser(dependency_path, GDScriptParserRef::PARSED, error);
+	REQUIRE(error == OK);
+	write_script(dependency_path, "extends RefCounted\n\nstatic func value() -> int:\n\treturn 2\n");
+
+	const uint64_t parse_count = GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE);
+	Ref<GDScript> dependency = GDScriptCache::get_full_script(dependency_path, error, String(), true);
+	REQUIRE_MESSAGE(error == OK, "The dependency should reload successfully.");
+	CHECK_MESSAGE(GDScriptCache::get_load_phase_count(GDScriptCache::LOAD_PHASE_PARSE) - parse_count == 1, "The changed dependency should have been parsed again.");
+	CHECK_MESSAGE(int(object->call("run")) == 2, "The dependent script should call the reloaded dependency.");
+	CHECK(gdscript->is_valid());
+
+	stale_parser.unref();
+	object.unref();
+	dependency.unref();
+	gdscript.unref();
+	GDScriptCache::remove_script(script_path);
+	GDScriptCache::remove_script(dependency_path);
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(script_path);
+	da->remove(dependency_path);
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Translating typed functions to C++") {
+	const String source = R"(
+extends RefCounted
+
+func add(a: int, b: float) -> float:
+	return a + b
+
+func sum_even(n: int) -> int:
+	var total := 0
+	for i in range(n):
+		if i % 2 == 0:
+			total += i
+	return total
+
+func twice_sum(n: int) -> int:
+	return sum_even(n) * 2
+
+func untyped(a):
+	return a
+
+func factorial(n: int) -> int:
+	if n <= 1:
+		return 1
+	return n * factorial(n - 1)
+
+func uses_factorial(n: int) -> int:
+	return factorial(n) + 1
+
+func divide(a: int, b: int) -> int:
+	return a / b
+)";
+	const String script_path = "res://translated.gd";
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse(source, script_path, false) == OK);
+	GDScriptAnalyzer analyzer(&parser);
+	REQUIRE(analyzer.analyze() == OK);
+
+	GDScriptNativeTranslator::Result result;
+	REQUIRE(GDScriptNativeTranslator::translate(&parser, script_path, source, result) == OK);
+
+	Vector<StringName> expected_functions;
+	expected_functions.push_back("add");
+	expected_functions.push_back("sum_even");
+	expected_functions.push_back("twice_sum");
+	CHECK_MESSAGE(result.functions == expected_functions, "Only the typed functions without recursion or runtime errors should be translated.");
+
+	CHECK(result.code.contains("double f_add(int64_t p_a, double p_b) {\n\treturn (double(p_a) + p_b);\n}\n"));
+	CHECK(result.code.contains("\t[[maybe_unused]] int64_t l_total = int64_t(0);\n"));
+	CHECK(result.code.contains("\t\tconst int64_t to_0 = p_n;\n\t\tfor (int64_t it_0 = int64_t(0); it_0 < to_0; it_0 += 1) {\n\t\t\t[[maybe_unused]] int64_t l_i = it_0;\n"));
+	CHECK(result.code.contains("if (((l_i % int64_t(2)) == int64_t(0))) {\n\t\t\t\tl_total = (l_total + l_i);\n"));
+	CHECK(result.code.contains("return (f_sum_even(p_n) * int64_t(2));"));
+	CHECK(result.code.contains("r_ret = f_add(*VariantInternal::get_int(p_args[0]), *VariantInternal::get_float(p_args[1]));"));
+	CHECK(result.code.contains(vformat("register_function(String::utf8(\"res://translated.gd\"), String::utf8(\"add\"), %du, 2, &call_add);", source.hash())));
+	CHECK(result.code.contains("void " + result.register_function + "() {"));
+	CHECK_FALSE(result.code.contains("f_untyped"));
+	CHECK_FALSE(result.code.contains("f_factorial"));
+	CHECK_FALSE(result.code.contains("f_uses_factorial"));
+	CHECK_FALSE(result.code.contains("f_divide"));
+
+	Vector<String> register_functions;
+	register_functions.push_back(result.register_function);
+	CHECK(GDScriptNativeTranslator::make_register_all(register_functions).contains("void gdscript_native_register_all() {\n\t" + result.register_function + "();\n}\n"));
+}
+#endif // TOOLS_ENABLED
+
+// Stands in for a translated `add()`, with a result the bytecode doesn't give.
+static void native_add(const Variant **p_args, Variant &r_ret) {
+	r_ret = *VariantInternal::get_int(p_args[0]) + *VariantInternal::get_int(p_args[1]) + 1000;
+}
+
+TEST_CASE("[Modules][GDScript] Calling registered native functions") {
+	const String script_path = OS::get_singleton()->get_cache_path().path_join("native_base.gd");
+	const String subclass_path = OS::get_singleton()->get_cache_path().path_join("native_subclass.gd");
+	const String source = "extends RefCounted\n\nfunc add(a: int, b: int) -> int:\n\treturn a + b\n\nfunc add_twice(a: int) -> int:\n\treturn add(a, a)\n";
+	write_script(script_path, source);
+	write_script(subclass_path, vformat("extends \"%s\"\n", script_path));
+	GDScriptCache::remove_script(script_path);
+	GDScriptCache::remove_script(subclass_path);
+
+	// Results of `add(1, 2)` and `add_twice(1)`.
+	int expected = 0;
+	int expected_twice = 0;
+	String path = script_path;
+
+	SUBCASE("Registered for the source") {
+		GDScriptNativeRegistry::register_function(script_path, "add", source.hash(), 2, &native_add);
+		expected = 1003;
+		expected_twice = 1002;
+	}
+
+	SUBCASE("Registered for another source") {
+		GDScriptNativeRegistry::register_function(script_path, "add", source.hash() + 1, 2, &native_add);
+		expected = 3;
+		expected_twice = 2;
+	}
+
+	SUBCASE("Called on an instance of a subclass") {
+		// Could be overridden there, the bytecode looks it up.
+		GDScriptNativeRegistry::register_function(script_path, "add", source.hash(), 2, &native_add);
+		path = subclass_path;
+		expected = 3;
+		expected_twice = 2;
+	}
+
+	Error error = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(path, error);
+	REQUIRE_MESSAGE(error == OK, "The script should load successfully.");
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	CHECK(int(object->call("add", 1, 2)) == expected);
+	CHECK_MESSAGE(int(object->call("add_twice", 1)) == expected_twice, "Calls from the bytecode should also run the native implementation.");
+
+	Callable::CallError call_error;
+	const Variant argument = 1;
+	const Variant *arguments[] = { &argument };
+	object->callp("add", arguments, 1, call_error);
+	CHECK_MESSAGE(call_error.error == Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS, "Missing arguments should be reported either way.");
+
+	GDScriptNativeRegistry::unregister_function(script_path, "add");
+	object.unref();
+	gdscript.unref();
+	GDScriptCache::remove_script(subclass_path);
+	GDScriptCache::remove_script(script_path);
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(subclass_path);
+	da->remove(script_path);
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records script stacks") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func run(sample: Callable) -> void:
+	busy(sample)
+
+func busy(sample: Callable) -> void:
+	sample.call()
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+
+	// Without an interval, stacks are only sampled when asked to, here from within `busy()`.
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(0);
+	object->call("run", callable_mp_static(&GDScriptSamplingProfiler::sample_now));
+	GDScriptSamplingProfiler::sample_now();
+	GDScriptSamplingProfiler::stop();
+
+	const uint64_t sample_count = GDScriptSamplingProfiler::get_sample_count();
+	const String stacks = GDScriptSamplingProfiler::get_collapsed_stacks();
+	GDScriptSamplingProfiler::clear();
+	CHECK_MESSAGE(sample_count == 1, "Only the sample taken while the script ran should have been recorded.");
+
+	// `busy()` was on line 8, called from line 5 of `run()`.
+	const Vector<String> lines = stacks.split("\n", false);
+	REQUIRE_MESSAGE(lines.size() == 1, "There should be a single stack, got:\n", stacks);
+	CHECK(lines[0].get_slice(" ", 1) == "1");
+	const Vector<String> frames = lines[0].get_slice(" ", 0).split(";");
+	REQUIRE_MESSAGE(frames.size() == 3, "The stack should have the thread and both functions, got: ", lines[0]);
+	CHECK(frames[0] == "main");
+	CHECK(frames[1].ends_with(":run:5"));
+	CHECK(frames[2].ends_with(":busy:8"));
+}
+
+TEST_CASE("[Modules][GDScript] Benchmark script function calls" * doctest::skip()) {
+	// Skipped by default as it only measures. Run with `--no-skip` to compare
+	// the direct calls to self and typed instances with untyped calls.
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+class Target:
+	func step(value: int) -> int:
+		return value + 1
+
+func _step(value: int) -> int:
+	return value + 1
+
+func call_self(count: int) -> int:
+	var value := 0
+	for i in count:
+		value = _step(value)
+	return value
+
+func call_typed(count: int) -> int:
+	var target := Target.new()
+	var value := 0
+	for i in count:
+		value = target.step(value)
+	return value
+
+func call_untyped(count: int) -> int:
+	var target = Target.new()
+	var value = 0
+	for i in count:
+		value = target.step(value)
+	return value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+
+	const int count = 1000000;
+	const StringName functions[] = { "call_self", "call_typed", "call_untyped" };
+	for (const StringName &function : functions) {
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		const int result = object->call(function, count);
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		CHECK(result == count);
+		MESSAGE(function, ": ", int64_t(count * 1000000.0 / elapsed), " calls per second.");
+	}
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,5 @@
+func test():
+	var bytes := PackedByteArray([1])
+	var index: int = -2
+	bytes[index] = 5
+	print(bytes)
@@ -0,0 +1,7 @@
+const CONSTANT_ARRAY: Array = [1, 2]
+
+func test():
+	var array: Array = CONSTANT_ARRAY
+	var index: int = 0
+	array[index] = 3
+	print(array)
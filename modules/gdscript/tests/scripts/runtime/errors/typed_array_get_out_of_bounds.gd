@@ -0,0 +1,4 @@
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	var index: int = 3
+	print(ints[index])
@@ -0,0 +1,23 @@
+signal no_arguments()
+signal one_argument(value)
+signal two_arguments(first, second)
+
+
+func test():
+	waiter()
+	print("waiting")
+	no_arguments.emit()
+	one_argument.emit(1)
+	two_arguments.emit(2, "two")
+	# Each await is one shot, emitting again does not resume anything.
+	two_arguments.emit(3, "three")
+	print("done")
+
+
+func waiter() -> void:
+	var a = await no_arguments
+	print(a)
+	var b = await one_argument
+	print(b)
+	var c = await two_arguments
+	print(c)
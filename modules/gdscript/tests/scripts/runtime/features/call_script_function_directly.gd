@@ -0,0 +1,38 @@
+# Calls to script functions the compiler can resolve statically skip the
+# generic call path, but must still dispatch to the overrides.
+
+class Base:
+	var calls = 0
+
+	func label() -> String:
+		return "Base"
+
+	func describe() -> String:
+		calls += 1
+		return label() + " " + str(calls)
+
+	func add(a: int, b: int) -> int:
+		return a + b
+
+
+class Derived extends Base:
+	func label() -> String:
+		return "Derived"
+
+	func add(a: int, b: int) -> int:
+		return super(a, b) * 10
+
+
+func twice(value: int) -> int:
+	return value * 2
+
+
+func test():
+	var objects: Array[Base] = [Base.new(), Derived.new()]
+	for i in 2:
+		for j in objects.size():
+			var object: Base = objects[j]
+			print(object.describe())
+			print(object.add(i, 2))
+	print(twice(21))
+	print(twice(twice(3)))
@@ -0,0 +1,54 @@
+# Typed conditions and nested control flow are rewritten by the bytecode
+# optimizer, which must keep the same results.
+
+func classify(value: int) -> String:
+	if value < 0:
+		return "negative"
+	elif value == 0:
+		return "zero"
+	else:
+		if value > 100:
+			return "large"
+		else:
+			return "small"
+
+
+func count_down(from: int) -> int:
+	var steps := 0
+	while from > 0:
+		from -= 1
+		if from % 2 == 0:
+			continue
+		steps += 1
+	return steps
+
+
+func first_above(values: Array[int], limit: int = 10) -> int:
+	for value in values:
+		if value <= limit:
+			continue
+		return value
+	return -1
+
+
+func test():
+	print(classify(-5), " ", classify(0), " ", classify(7), " ", classify(500))
+	print(count_down(10))
+	print(first_above([1, 20, 3]), " ", first_above([1, 2, 3]), " ", first_above([5, 6], 5))
+
+	var total := 0.0
+	for i in 10:
+		if i < 3 or i > 7:
+			total += i
+		elif i != 5 and i >= 4:
+			total -= 0.5
+	print(total)
+
+	var x := 3
+	var y := 4
+	print("less" if x < y else "not less")
+	while true:
+		x += 1
+		if x >= y * 2:
+			break
+	print(x)
@@ -0,0 +1,32 @@
+# Captured values are passed before the call arguments, however many there are.
+
+signal changed(value)
+
+var member := 100
+
+@warning_ignore("return_value_discarded")
+func test():
+	var a := 1
+	var b := "two"
+	var few := func(x):
+		print(a, b, x)
+	few.call(3)
+
+	var c := 3.5
+	var d := Vector2(4, 5)
+	var e := [6]
+	var f := {7: 8}
+	var many := func(x, y):
+		print([a, b, c, d, e, f, x, y])
+	many.call("x", "y")
+
+	var with_self := func(x):
+		return member + a + x
+	print(with_self.call(10))
+
+	changed.connect(few)
+	changed.connect(func(value):
+		print("many ", a, c, value))
+	changed.emit("emitted")
+	changed.disconnect(few)
+	changed.emit("again")
@@ -0,0 +1,37 @@
+# Arithmetic between typed ints or floats is computed inline by the VM.
+
+var position: float = 1.0
+
+func test():
+	var a: int = 7
+	var b: int = -3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	a += 10
+	a -= 2
+	a *= 2
+	print(a)
+
+	var x: float = 1.5
+	var y: float = 0.25
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x / 0.0)
+
+	var velocity: float = 2.0
+	for _i in 4:
+		position += velocity * 0.5
+		velocity -= 0.5
+	print(position)
+
+	var total: int = 0
+	for i in 10:
+		total = total + i * i
+	print(total)
+
+	# Mixed types still go through the regular operators.
+	var mixed := a * 1.5
+	print(mixed)
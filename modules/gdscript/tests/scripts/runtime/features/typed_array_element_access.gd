@@ -0,0 +1,53 @@
+# Element access and common methods on arrays of a known type use specialized opcodes.
+
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	ints[0] = 10
+	ints[-1] = ints[-2] + 10
+	ints.append(4)
+	ints.push_back(5)
+	print(ints)
+	print(ints.size())
+
+	var untyped: Array = ["a", 2]
+	untyped[1] = Vector2(1, 2)
+	untyped.append(null)
+	var first = untyped[0]
+	print(first)
+	print(untyped)
+	print(untyped.size())
+
+	var bytes := PackedByteArray([1, 2, 3])
+	bytes[1] = 258
+	var byte: int = bytes[1]
+	print(byte)
+	print(bytes.append(7))
+	print(bytes)
+
+	var floats := PackedFloat32Array([0.5, 1.5])
+	floats[-1] = 2.25
+	print(floats.push_back(3.0))
+	var sum := 0.0
+	for i in floats.size():
+		sum += floats[i]
+	print(sum)
+
+	var strings := PackedStringArray(["x", "y"])
+	strings[0] = "z"
+	print(strings.append("w"))
+	print(strings[0] + strings[-1])
+	print(strings.size())
+
+	var vectors := PackedVector2Array([Vector2(1, 1)])
+	vectors[0] = vectors[0] * 2.0
+	print(vectors.append(Vector2(3, 4)))
+	print(vectors)
+
+	var colors := PackedColorArray()
+	print(colors.append(Color.RED))
+	print(colors[0])
+
+	# Reading an element back into the variable holding the array.
+	var nested: Array = [[1, 2], 3]
+	nested = nested[0]
+	print(nested)
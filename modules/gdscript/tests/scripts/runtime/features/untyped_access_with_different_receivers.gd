@@ -0,0 +1,101 @@
+# Untyped accesses and calls cache what names resolve to for the receivers
+# seen at each site. Different receivers at the same site must still get
+# their own results, including after the site stopped caching.
+
+class A:
+	var value = 1
+
+	func describe():
+		return "A %s" % value
+
+
+class B:
+	var padding = 0
+	var value = 2
+
+	func describe():
+		return "B %s" % value
+
+
+class C extends A:
+	func describe():
+		return "C " + super()
+
+
+class Typed:
+	var value: float = 0.0
+
+	func describe():
+		return "Typed %s" % (typeof(value) == TYPE_FLOAT)
+
+
+class WithGetSet:
+	var stored = 4
+
+	func _get(property):
+		if property == &"value":
+			return stored
+		return null
+
+	func _set(property, v):
+		if property == &"value":
+			stored = v * 10
+			return true
+		return false
+
+	func describe():
+		return "WithGetSet %s" % stored
+
+
+class NamedResource extends Resource:
+	pass
+
+
+func read(receiver):
+	return receiver.value
+
+
+func write(receiver, v):
+	receiver.value = v
+
+
+func describe(receiver):
+	return receiver.describe()
+
+
+func read_name(receiver):
+	return receiver.resource_name
+
+
+func write_name(receiver, v):
+	receiver.resource_name = v
+
+
+func set_x(receiver, v):
+	receiver.x = v
+	return receiver
+
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), Typed.new(), WithGetSet.new(), { value = 6 }]
+	for pass_index in 2:
+		for receiver in receivers:
+			print(read(receiver))
+		for receiver in receivers:
+			write(receiver, pass_index + 7)
+		for receiver in receivers:
+			if typeof(receiver) == TYPE_DICTIONARY:
+				print(receiver.value)
+			else:
+				print(describe(receiver))
+
+	var resources = [Resource.new(), NamedResource.new()]
+	for pass_index in 2:
+		for resource in resources:
+			write_name(resource, "%s %d" % [resource.get_class(), pass_index])
+			print(read_name(resource))
+
+	for pass_index in 2:
+		print(set_x(Vector2(1, 2), 5.5))
+		print(set_x(Vector3i(1, 2, 3), 5))
+		print(set_x(Vector2(1, 2), pass_index))
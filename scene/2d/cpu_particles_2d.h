@@ -108,7 +108,8 @@ private:
 	RID multimesh;
 
 	Vector<Particle> particles;
-	Vector<float> particle_data;
+	Vector<float> particle_data; // Read by the render thread, only access it with update_mutex locked.
+	LocalVector<float> particle_data_staging; // Written while processing, then copied to particle_data.
 	Vector<int> particle_order;
 
 	struct SortLifetime {
@@ -176,9 +177,30 @@ private:
 
 	Vector2 gravity = Vector2(0, 980);
 
+	// Particles are processed on the WorkerThreadPool in chunks of at least this size.
+	static constexpr int PARTICLES_PER_THREAD = 1024;
+
+	struct ParticleProcessStep {
+		Particle *particles = nullptr;
+		int particle_count = 0;
+		uint32_t chunk_count = 1;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		uint32_t restart_seed = 0;
+		float *particle_data = nullptr; // If set, instance data is written directly after processing each particle.
+	};
+
 	void _update_internal();
-	void _particles_process(double p_delta);
+	void _particles_process(double p_delta, bool p_write_particle_data);
+	void _particles_process_threaded(uint32_t p_chunk, ParticleProcessStep *p_step);
+	void _particles_process_range(const ParticleProcessStep &p_step, int p_from, int p_to);
+	void _particle_process(const ParticleProcessStep &p_step, int p_index);
+	void _write_particle_data(float *r_ptr, const Particle &p_particle) const;
 	void _update_particle_data_buffer();
+	void _publish_particle_data();
 
 	Mutex update_mutex;
 
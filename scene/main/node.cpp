@@ -197,6 +197,10 @@ void Node::_notification(int p_notification) {
 				return;
 			}
 
+			if (data.pool_state.is_valid()) {
+				SceneState::forget_pooled_instance(this);
+			}
+
 			if (data.owner) {
 				_clean_up_owner();
 			}
@@ -3496,6 +3500,7 @@ void Node::_bind_methods() {
 	GDVIRTUAL_BIND(_exit_tree);
 	GDVIRTUAL_BIND(_ready);
 	GDVIRTUAL_BIND(_get_configuration_warnings);
+	GDVIRTUAL_BIND(_pool_reset);
 	GDVIRTUAL_BIND(_input, "event");
 	GDVIRTUAL_BIND(_shortcut_input, "event");
 	GDVIRTUAL_BIND(_unhandled_input, "event");
@@ -147,6 +147,7 @@ private:
 		String scene_file_path;
 		Ref<SceneState> instance_state;
 		Ref<SceneState> inherited_state;
+		ObjectID pool_state; // SceneState whose instance pool this node can return to, see SceneState::set_pool_capacity().
 
 		Node *parent = nullptr;
 		Node *owner = nullptr;
@@ -321,6 +322,7 @@ protected:
 	GDVIRTUAL0(_exit_tree)
 	GDVIRTUAL0(_ready)
 	GDVIRTUAL0RC(Vector<String>, _get_configuration_warnings)
+	GDVIRTUAL0(_pool_reset)
 
 	GDVIRTUAL1(_input, Ref<InputEvent>)
 	GDVIRTUAL1(_shortcut_input, Ref<InputEvent>)
@@ -585,6 +587,11 @@ public:
 	void set_scene_instance_load_placeholder(bool p_enable);
 	bool get_scene_instance_load_placeholder() const;
 
+	_FORCE_INLINE_ void _set_scene_pool_state(ObjectID p_state) { data.pool_state = p_state; }
+	_FORCE_INLINE_ ObjectID _get_scene_pool_state() const { return data.pool_state; }
+	_FORCE_INLINE_ bool _has_pool_reset_hook() const { return GDVIRTUAL_IS_OVERRIDDEN(_pool_reset); }
+	_FORCE_INLINE_ void _call_pool_reset_hook() { GDVIRTUAL_CALL(_pool_reset); }
+
 	template <typename... VarArgs>
 	Vector<Variant> make_binds(VarArgs... p_args) {
 		Vector<Variant> binds = { p_args... };
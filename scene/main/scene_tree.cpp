@@ -576,7 +576,23 @@ void SceneTree::process_timers(double p_delta, bool p_physics_frame) {
 		E->get()->set_time_left(time_left);
 
 		if (time_left <= 0) {
-			E->get()->emit_signal(SNAME("timeout"));
+			Ref<SceneTreeTimer> timer = E->get();
+			if (timer->timeout_callback.is_valid()) {
+				// Never exposed, so nothing else can be connected or hold it.
+				Callable callback = timer->timeout_callback;
+				timer->timeout_callback = Callable();
+				Variant ret;
+				Callable::CallError ce;
+				callback.callp(nullptr, 0, ret, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					ERR_PRINT("Error calling timer callback: " + Variant::get_callable_error_text(callback, nullptr, 0, ce) + ".");
+				}
+				if (callback_timer_pool.size() < CALLBACK_TIMER_POOL_SIZE) {
+					callback_timer_pool.push_back(timer);
+				}
+			} else {
+				timer->emit_signal(SNAME("timeout"));
+			}
 			timers.erase(E);
 		}
 		if (E == L) {
@@ -635,9 +651,11 @@ void SceneTree::finalize() {
 
 	// Cleanup timers.
 	for (Ref<SceneTreeTimer> &timer : timers) {
+		timer->timeout_callback = Callable();
 		timer->release_connections();
 	}
 	timers.clear();
+	callback_timer_pool.clear();
 
 	// Cleanup tweens.
 	for (Ref<Tween> &tween : tweens) {
@@ -1337,7 +1355,11 @@ void SceneTree::_flush_delete_queue() {
 	while (delete_queue.size()) {
 		Object *obj = ObjectDB::get_instance(delete_queue.front()->get());
 		if (obj) {
-			memdelete(obj);
+			// Pooled scene instances are reset and kept for reuse instead of being freed.
+			Node *node = Object::cast_to<Node>(obj);
+			if (!node || !SceneState::recycle_pooled_instance(node)) {
+				memdelete(obj);
+			}
 		}
 		delete_queue.pop_front();
 	}
@@ -1454,6 +1476,24 @@ Ref<SceneTreeTimer> SceneTree::create_timer(double p_delay_sec, bool p_process_a
 	return stt;
 }
 
+void SceneTree::add_timer_callback(double p_delay_sec, const Callable &p_callback, bool p_process_always, bool p_process_in_physics, bool p_ignore_time_scale) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_COND(!p_callback.is_valid());
+	Ref<SceneTreeTimer> stt;
+	if (callback_timer_pool.is_empty()) {
+		stt.instantiate();
+	} else {
+		stt = callback_timer_pool[callback_timer_pool.size() - 1];
+		callback_timer_pool.resize(callback_timer_pool.size() - 1);
+	}
+	stt->set_process_always(p_process_always);
+	stt->set_time_left(p_delay_sec);
+	stt->set_process_in_physics(p_process_in_physics);
+	stt->set_ignore_time_scale(p_ignore_time_scale);
+	stt->timeout_callback = p_callback;
+	timers.push_back(stt);
+}
+
 Ref<Tween> SceneTree::create_tween() {
 	_THREAD_SAFE_METHOD_
 	Ref<Tween> tween = memnew(Tween(true));
@@ -33,6 +33,7 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
@@ -57,6 +58,9 @@ class SceneTreeTimer : public RefCounted {
 	bool process_in_physics = false;
 	bool ignore_time_scale = false;
 
+	friend class SceneTree;
+	Callable timeout_callback; // Called instead of emitting `timeout` by timers from SceneTree::add_timer_callback().
+
 protected:
 	static void _bind_methods();
 
@@ -191,7 +195,12 @@ private:
 
 	void _change_scene(Node *p_to);
 
+	enum {
+		CALLBACK_TIMER_POOL_SIZE = 256
+	};
+
 	List<Ref<SceneTreeTimer>> timers;
+	LocalVector<Ref<SceneTreeTimer>> callback_timer_pool; // Timers from add_timer_callback() that timed out, for reuse.
 	List<Ref<Tween>> tweens;
 
 	///network///
@@ -399,6 +408,8 @@ public:
 	void unload_current_scene();
 
 	Ref<SceneTreeTimer> create_timer(double p_delay_sec, bool p_process_always = true, bool p_process_in_physics = false, bool p_ignore_time_scale = false);
+	// Same as connecting `p_callback` to the `timeout` signal of a timer from create_timer(), without creating a timer nor a connection each time.
+	void add_timer_callback(double p_delay_sec, const Callable &p_callback, bool p_process_always = true, bool p_process_in_physics = false, bool p_ignore_time_scale = false);
 	Ref<Tween> create_tween();
 	TypedArray<Tween> get_processed_tweens();
 
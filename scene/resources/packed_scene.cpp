@@ -49,6 +49,11 @@
 SceneState::InstantiationWarningNotify SceneState::instantiation_warn_notify = nullptr;
 #endif
 
+SafeNumeric<uint64_t> SceneState::pool_hits;
+SafeNumeric<uint64_t> SceneState::pool_misses;
+SafeNumeric<uint64_t> SceneState::pooled_nodes;
+SafeNumeric<uint64_t> SceneState::pooled_memory;
+
 bool SceneState::can_instantiate() const {
 	return nodes.size() > 0;
 }
@@ -75,6 +80,16 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 }
 
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	const bool pooling = p_edit_state == GEN_EDIT_STATE_DISABLED && pool_capacity.get() > 0;
+	uint64_t pool_memory_start = 0;
+	if (pooling) {
+		Node *pooled = _pool_take();
+		if (pooled) {
+			return pooled;
+		}
+		pool_memory_start = Memory::get_mem_usage();
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -91,6 +106,10 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	int nc = nodes.size();
 	ERR_FAIL_COND_V(nc == 0, nullptr);
 
+	if (!compiled.is_set()) {
+		_compile();
+	}
+
 	const StringName *snames = nullptr;
 	int sname_count = names.size();
 	if (sname_count) {
@@ -233,6 +252,15 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
 
+				// Nodes created from a built-in class can skip Object::set() for properties with a resolved setter.
+				const CompiledNode *compiled_node = nullptr;
+				if (p_edit_state == GEN_EDIT_STATE_DISABLED && i < (int)compiled_nodes.size() && !node->_get_extension()) {
+					const CompiledNode &cn = compiled_nodes[i];
+					if (cn.properties.size() == (uint32_t)nprop_count && cn.type != StringName() && node->get_class_name() == cn.type) {
+						compiled_node = &cn;
+					}
+				}
+
 				Dictionary missing_resource_properties;
 
 				for (int j = 0; j < nprop_count; j++) {
@@ -339,7 +367,21 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+							const CompiledProperty *cp = compiled_node ? &compiled_node->properties[j] : nullptr;
+							if (cp && cp->setter && !node->get_script_instance()) {
+								Variant index = cp->index;
+								const Variant *args[2] = { &index, &value };
+								const Variant **argptrs = cp->index >= 0 ? args : args + 1;
+								if (cp->validated_type != Variant::NIL && value.get_type() == cp->validated_type) {
+									Variant ret;
+									cp->setter->validated_call(node, argptrs, &ret);
+								} else {
+									Callable::CallError ce;
+									cp->setter->call(node, argptrs, cp->index >= 0 ? 2 : 1, ce);
+								}
+							} else {
+								node->set(snames[nprops[j].name], value, &valid);
+							}
 						}
 					}
 				}
@@ -519,9 +561,349 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
+	if (pooling) {
+		_pool_register(ret_nodes[0], pool_memory_start);
+	}
+
 	return ret_nodes[0];
 }
 
+static void _pool_collect_nodes(Node *p_node, LocalVector<Node *> &r_nodes) {
+	r_nodes.push_back(p_node);
+	for (int i = 0; i < p_node->get_child_count(true); i++) {
+		_pool_collect_nodes(p_node->get_child(i, true), r_nodes);
+	}
+}
+
+static uint32_t _pool_get_process_flags(const Node *p_node) {
+	return (p_node->is_processing() ? 1 << 0 : 0) |
+			(p_node->is_physics_processing() ? 1 << 1 : 0) |
+			(p_node->is_processing_input() ? 1 << 2 : 0) |
+			(p_node->is_processing_shortcut_input() ? 1 << 3 : 0) |
+			(p_node->is_processing_unhandled_input() ? 1 << 4 : 0) |
+			(p_node->is_processing_unhandled_key_input() ? 1 << 5 : 0);
+}
+
+static Vector<StringName> _pool_get_property_names(Node *p_node) {
+	Vector<StringName> names;
+	List<PropertyInfo> properties;
+	p_node->get_property_list(&properties);
+	for (const PropertyInfo &E : properties) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			names.push_back(E.name);
+		}
+	}
+	return names;
+}
+
+static int _pool_get_meta_count(const Node *p_node) {
+	List<StringName> meta;
+	p_node->get_meta_list(&meta);
+	return meta.size();
+}
+
+bool SceneState::_pool_capture_node(Node *p_node, const Vector<StringName> &p_property_names, PooledNode &r_node) {
+	// Script variables that aren't stored can only be brought back by the script itself.
+	Object *script = p_node->get_script();
+	if (script && !p_node->_has_pool_reset_hook()) {
+		return false;
+	}
+
+	r_node.id = p_node->get_instance_id();
+	r_node.script = script ? script->get_instance_id() : ObjectID();
+	r_node.name = p_node->get_name();
+	r_node.process_flags = _pool_get_process_flags(p_node);
+	r_node.meta_count = _pool_get_meta_count(p_node);
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	r_node.group_count = groups.size();
+
+	List<Connection> connections;
+	p_node->get_all_signal_connections(&connections);
+	p_node->get_signals_connected_to_this(&connections);
+	r_node.connection_count = connections.size();
+
+	r_node.property_values.resize(p_property_names.size());
+	for (int i = 0; i < p_property_names.size(); i++) {
+		Variant value = p_node->get(p_property_names[i]);
+		if (value.get_type() == Variant::OBJECT) {
+			// The copy made for the instance can't be brought back.
+			Ref<Resource> res = value;
+			if (res.is_valid() && res->is_local_to_scene()) {
+				return false;
+			}
+		}
+		r_node.property_values[i] = value;
+	}
+
+	return true;
+}
+
+Node *SceneState::_pool_take() const {
+	MutexLock lock(pool_mutex);
+
+	if (pool.is_empty()) {
+		pool_misses.increment();
+		return nullptr;
+	}
+
+	Node *root = pool[pool.size() - 1];
+	pool.resize(pool.size() - 1);
+
+	PooledInstance **instance = pool_instances.getptr(root->get_instance_id());
+	if (instance) {
+		pooled_nodes.sub((*instance)->nodes.size());
+		pooled_memory.sub((*instance)->memory);
+	}
+	pool_hits.increment();
+
+	return root;
+}
+
+void SceneState::_pool_register(Node *p_root, uint64_t p_memory_start) const {
+	LocalVector<Node *> tree_nodes;
+	_pool_collect_nodes(p_root, tree_nodes);
+
+	Vector<Vector<StringName>> property_names;
+	{
+		MutexLock lock(pool_mutex);
+		property_names = pool_property_names;
+	}
+	if (property_names.is_empty()) {
+		// Listing the properties costs about as much as setting them, so it's only done for the first instance.
+		property_names.resize(tree_nodes.size());
+		for (uint32_t i = 0; i < tree_nodes.size(); i++) {
+			property_names.write[i] = _pool_get_property_names(tree_nodes[i]);
+		}
+
+		MutexLock lock(pool_mutex);
+		if (pool_property_names.is_empty()) {
+			pool_property_names = property_names;
+		}
+	}
+	if (property_names.size() != (int)tree_nodes.size()) {
+		return; // Freed as usual.
+	}
+
+	PooledInstance *instance = memnew(PooledInstance);
+	instance->nodes.resize(tree_nodes.size());
+	instance->property_names = property_names;
+	for (uint32_t i = 0; i < tree_nodes.size(); i++) {
+		if (!_pool_capture_node(tree_nodes[i], property_names[i], instance->nodes[i])) {
+			memdelete(instance);
+			return; // Freed as usual.
+		}
+	}
+
+	// Only an estimate, other threads may allocate at the same time.
+	uint64_t memory_end = Memory::get_mem_usage();
+	instance->memory = memory_end > p_memory_start ? memory_end - p_memory_start : 0;
+
+	p_root->_set_scene_pool_state(get_instance_id());
+
+	MutexLock lock(pool_mutex);
+	pool_instances.insert(p_root->get_instance_id(), instance);
+}
+
+bool SceneState::_pool_reset(Node *p_root, const PooledInstance &p_instance) const {
+	LocalVector<Node *> tree_nodes;
+	_pool_collect_nodes(p_root, tree_nodes);
+
+	// Instances whose nodes were freed, added, moved or changed in ways properties don't cover can't be brought back to their initial state.
+	if (tree_nodes.size() != p_instance.nodes.size()) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < tree_nodes.size(); i++) {
+		Node *node = tree_nodes[i];
+		const PooledNode &pooled = p_instance.nodes[i];
+		Object *script = node->get_script();
+		if (node->get_instance_id() != pooled.id || (node != p_root && node->is_queued_for_deletion()) || (script ? script->get_instance_id() : ObjectID()) != pooled.script || node->get_name() != pooled.name || _pool_get_process_flags(node) != pooled.process_flags) {
+			return false;
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		List<Connection> connections;
+		node->get_all_signal_connections(&connections);
+		node->get_signals_connected_to_this(&connections);
+		if (groups.size() != pooled.group_count || connections.size() != pooled.connection_count || _pool_get_meta_count(node) != pooled.meta_count) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < tree_nodes.size(); i++) {
+		Node *node = tree_nodes[i];
+		const PooledNode &pooled = p_instance.nodes[i];
+		const Vector<StringName> &names = p_instance.property_names[i];
+		for (int j = 0; j < names.size(); j++) {
+			// Setters can be costly (transforms are propagated, for instance), so only the properties changed since are set.
+			const Variant &value = pooled.property_values[j];
+			if (node->get(names[j]) != value) {
+				node->set(names[j], value);
+			}
+		}
+	}
+
+	for (Node *node : tree_nodes) {
+		// Once the whole instance is back to its stored state, scripts reset what isn't stored.
+		if (node->_has_pool_reset_hook()) {
+			node->_call_pool_reset_hook();
+		}
+
+		// Nodes initialize some of their state in _ready(), so run it again when the instance re-enters the tree.
+		node->request_ready();
+	}
+
+	return true;
+}
+
+bool SceneState::_pool_recycle(Node *p_root) {
+	{
+		MutexLock lock(pool_mutex);
+		if (pool.find(p_root) >= 0) {
+			p_root->_is_queued_for_deletion = false; // Already pooled.
+			return true;
+		}
+		if (pool.size() >= (uint32_t)pool_capacity.get() || !pool_instances.has(p_root->get_instance_id())) {
+			return false;
+		}
+	}
+
+	if (p_root->get_parent()) {
+		p_root->get_parent()->remove_child(p_root);
+	}
+
+	// Taken out while it's reset, so the nodes are set without holding the lock.
+	PooledInstance *instance = nullptr;
+	uint32_t generation = 0;
+	{
+		MutexLock lock(pool_mutex);
+		HashMap<ObjectID, PooledInstance *>::Iterator E = pool_instances.find(p_root->get_instance_id());
+		if (!E) {
+			return false;
+		}
+		instance = E->value;
+		generation = pool_generation;
+		pool_instances.remove(E);
+	}
+
+	bool reset = _pool_reset(p_root, *instance);
+
+	MutexLock lock(pool_mutex);
+	if (!reset || generation != pool_generation || pool.size() >= (uint32_t)pool_capacity.get()) {
+		memdelete(instance);
+		return false; // Freed as usual.
+	}
+
+	pool_instances.insert(p_root->get_instance_id(), instance);
+	p_root->_is_queued_for_deletion = false;
+	pool.push_back(p_root);
+	pooled_nodes.add(instance->nodes.size());
+	pooled_memory.add(instance->memory);
+
+	return true;
+}
+
+void SceneState::_pool_forget(Node *p_root) {
+	MutexLock lock(pool_mutex);
+
+	HashMap<ObjectID, PooledInstance *>::Iterator E = pool_instances.find(p_root->get_instance_id());
+	if (!E) {
+		return;
+	}
+
+	int64_t idx = pool.find(p_root);
+	if (idx >= 0) {
+		pool.remove_at_unordered(idx);
+		pooled_nodes.sub(E->value->nodes.size());
+		pooled_memory.sub(E->value->memory);
+	}
+	memdelete(E->value);
+	pool_instances.remove(E);
+}
+
+void SceneState::_pool_trim(uint32_t p_size) {
+	LocalVector<Node *> to_free;
+
+	{
+		MutexLock lock(pool_mutex);
+		while (pool.size() > p_size) {
+			Node *root = pool[pool.size() - 1];
+			pool.resize(pool.size() - 1);
+
+			HashMap<ObjectID, PooledInstance *>::Iterator E = pool_instances.find(root->get_instance_id());
+			if (E) {
+				pooled_nodes.sub(E->value->nodes.size());
+				pooled_memory.sub(E->value->memory);
+				memdelete(E->value);
+				pool_instances.remove(E);
+			}
+			root->_set_scene_pool_state(ObjectID());
+			to_free.push_back(root);
+		}
+	}
+
+	for (Node *root : to_free) {
+		memdelete(root);
+	}
+}
+
+void SceneState::_pool_invalidate() {
+	_pool_trim(0);
+
+	// Instances still in use were built from the previous state, so they can't be reset anymore.
+	MutexLock lock(pool_mutex);
+	for (KeyValue<ObjectID, PooledInstance *> &E : pool_instances) {
+		memdelete(E.value);
+	}
+	pool_instances.clear();
+	pool_property_names.clear();
+	pool_generation++;
+}
+
+void SceneState::set_pool_capacity(int p_capacity) {
+	ERR_FAIL_COND(p_capacity < 0);
+	pool_capacity.set(p_capacity);
+	_pool_trim(p_capacity);
+}
+
+int SceneState::get_pool_capacity() const {
+	return pool_capacity.get();
+}
+
+int SceneState::get_pooled_instance_count() const {
+	MutexLock lock(pool_mutex);
+	return pool.size();
+}
+
+void SceneState::clear_pool() {
+	_pool_trim(0);
+}
+
+bool SceneState::recycle_pooled_instance(Node *p_node) {
+	ObjectID state_id = p_node->_get_scene_pool_state();
+	if (state_id.is_null()) {
+		return false;
+	}
+
+	SceneState *state = Object::cast_to<SceneState>(ObjectDB::get_instance(state_id));
+	if (!state) {
+		return false;
+	}
+
+	return state->_pool_recycle(p_node);
+}
+
+void SceneState::forget_pooled_instance(Node *p_node) {
+	SceneState *state = Object::cast_to<SceneState>(ObjectDB::get_instance(p_node->_get_scene_pool_state()));
+	p_node->_set_scene_pool_state(ObjectID());
+	if (state) {
+		state->_pool_forget(p_node);
+	}
+}
+
 static int _nm_get_string(const String &p_string, HashMap<StringName, int> &name_map) {
 	if (name_map.has(p_string)) {
 		return name_map[p_string];
@@ -1075,7 +1457,68 @@ String SceneState::get_path() const {
 	return path;
 }
 
+void SceneState::_compile() const {
+	MutexLock lock(compile_mutex);
+	if (compiled.is_set()) {
+		return;
+	}
+
+	compiled_nodes.clear();
+	compiled_nodes.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		if (n.type == TYPE_INSTANTIATED || n.instance >= 0 || (i == 0 && base_scene_idx >= 0)) {
+			continue; // Not created from a class, or created by another scene.
+		}
+		if (n.type < 0 || n.type >= names.size()) {
+			continue;
+		}
+
+		CompiledNode &cn = compiled_nodes[i];
+		cn.type = names[n.type];
+		cn.properties.resize(n.properties.size());
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= names.size()) {
+				continue;
+			}
+
+			int index = -1;
+			MethodBind *setter = ClassDB::get_property_setter_bind(cn.type, names[prop.name], &index);
+			if (!setter) {
+				continue;
+			}
+
+			CompiledProperty &cp = cn.properties[j];
+			cp.setter = setter;
+			cp.index = index;
+
+			// Validated calls skip argument conversion, so only use them when the stored value
+			// already has the exact argument type. Objects and arrays may need casts or retyping.
+			int arg_count = index >= 0 ? 2 : 1;
+			if (!setter->is_vararg() && setter->get_argument_count() == arg_count && (index < 0 || setter->get_argument_type(0) == Variant::INT)) {
+				Variant::Type arg_type = setter->get_argument_type(arg_count - 1);
+				if (arg_type != Variant::NIL && arg_type != Variant::OBJECT && arg_type != Variant::ARRAY) {
+					cp.validated_type = arg_type;
+				}
+			}
+		}
+	}
+
+	compiled.set();
+}
+
+void SceneState::_invalidate_compiled() {
+	MutexLock lock(compile_mutex);
+	compiled.clear();
+	compiled_nodes.clear();
+}
+
 void SceneState::clear() {
+	_invalidate_compiled();
+	_pool_invalidate();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1291,6 +1734,9 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_invalidate_compiled();
+	_pool_invalidate();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1754,6 +2200,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_invalidate_compiled();
 
 	return nodes.size() - 1;
 }
@@ -1770,6 +2217,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_compiled();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -1850,6 +2298,10 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 }
 
+SceneState::~SceneState() {
+	_pool_invalidate();
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
@@ -1918,6 +2370,7 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 }
 
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	p_by->set_pool_capacity(state->get_pool_capacity());
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1926,13 +2379,31 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	int capacity = state->get_pool_capacity();
 	state = Ref<SceneState>(memnew(SceneState));
+	state->set_pool_capacity(capacity);
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
 	state->set_last_modified_time(get_last_modified_time());
 #endif
 }
 
+void PackedScene::set_pool_capacity(int p_capacity) {
+	state->set_pool_capacity(p_capacity);
+}
+
+int PackedScene::get_pool_capacity() const {
+	return state->get_pool_capacity();
+}
+
+int PackedScene::get_pooled_instance_count() const {
+	return state->get_pooled_instance_count();
+}
+
+void PackedScene::clear_pool() {
+	state->clear_pool();
+}
+
 Ref<SceneState> PackedScene::get_state() const {
 	return state;
 }
@@ -1952,6 +2423,10 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
+	ClassDB::bind_method(D_METHOD("set_pool_capacity", "capacity"), &PackedScene::set_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pool_capacity"), &PackedScene::get_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &PackedScene::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &PackedScene::clear_pool);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled"), "_set_bundled_scene", "_get_bundled_scene");
 
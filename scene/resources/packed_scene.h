@@ -32,6 +32,9 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +92,64 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Built-in property setters resolved once per state, so instantiating the same scene
+	// repeatedly doesn't look up every property of every node in ClassDB again.
+	struct CompiledProperty {
+		MethodBind *setter = nullptr; // nullptr when the property must go through Object::set().
+		int index = -1;
+		Variant::Type validated_type = Variant::NIL; // Value type that can be passed to validated_call() as-is.
+	};
+
+	struct CompiledNode {
+		StringName type;
+		LocalVector<CompiledProperty> properties;
+	};
+
+	mutable LocalVector<CompiledNode> compiled_nodes;
+	mutable SafeFlag compiled;
+	mutable Mutex compile_mutex;
+
+	void _compile() const;
+	void _invalidate_compiled();
+
+	// Instances handed out while pooling is enabled, so they can be reset and reused once queued for deletion.
+	struct PooledNode {
+		ObjectID id;
+		ObjectID script;
+		StringName name;
+		uint32_t process_flags = 0;
+		int group_count = 0;
+		int connection_count = 0;
+		int meta_count = 0;
+		LocalVector<Variant> property_values; // Every stored property, as right after instantiation.
+	};
+	struct PooledInstance {
+		LocalVector<PooledNode> nodes; // The whole tree of the instance, in depth-first order.
+		Vector<Vector<StringName>> property_names; // Shared with pool_property_names.
+		uint64_t memory = 0;
+	};
+
+	SafeNumeric<int> pool_capacity;
+	mutable Mutex pool_mutex;
+	mutable HashMap<ObjectID, PooledInstance *> pool_instances; // Keyed by root node, includes instances in use.
+	mutable LocalVector<Node *> pool;
+	mutable Vector<Vector<StringName>> pool_property_names; // Stored properties of each node, the same for every instance so only listed once.
+	uint32_t pool_generation = 0; // Changed when pool_instances is invalidated.
+
+	static SafeNumeric<uint64_t> pool_hits;
+	static SafeNumeric<uint64_t> pool_misses;
+	static SafeNumeric<uint64_t> pooled_nodes;
+	static SafeNumeric<uint64_t> pooled_memory;
+
+	static bool _pool_capture_node(Node *p_node, const Vector<StringName> &p_property_names, PooledNode &r_node);
+	Node *_pool_take() const;
+	void _pool_register(Node *p_root, uint64_t p_memory_start) const;
+	bool _pool_reset(Node *p_root, const PooledInstance &p_instance) const;
+	bool _pool_recycle(Node *p_root);
+	void _pool_forget(Node *p_root);
+	void _pool_trim(uint32_t p_size);
+	void _pool_invalidate();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -209,11 +270,26 @@ public:
 	// Used when saving pointers (saves a path property instead).
 	static String get_meta_pointer_property(const String &p_property);
 
+	void set_pool_capacity(int p_capacity);
+	int get_pool_capacity() const;
+	int get_pooled_instance_count() const;
+	void clear_pool();
+
+	// Called by SceneTree when a queued node is flushed, returns true if the node was kept for reuse.
+	static bool recycle_pooled_instance(Node *p_node);
+	static void forget_pooled_instance(Node *p_node);
+
+	static uint64_t get_pool_hit_count() { return pool_hits.get(); }
+	static uint64_t get_pool_miss_count() { return pool_misses.get(); }
+	static uint64_t get_pooled_node_count() { return pooled_nodes.get(); }
+	static uint64_t get_pooled_memory() { return pooled_memory.get(); }
+
 #ifdef TOOLS_ENABLED
 	static void set_instantiation_warning_notify_func(InstantiationWarningNotify p_warn_notify) { instantiation_warn_notify = p_warn_notify; }
 #endif
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
@@ -250,6 +326,11 @@ public:
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
+	void set_pool_capacity(int p_capacity);
+	int get_pool_capacity() const;
+	int get_pooled_instance_count() const;
+	void clear_pool();
+
 	virtual void reload_from_file() override;
 
 	virtual void set_path(const String &p_path, bool p_take_over = false) override;
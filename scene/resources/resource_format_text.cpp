@@ -274,7 +274,7 @@ Ref<PackedScene> ResourceLoaderText::_parse_node_tag(VariantParser::ResourcePars
 				String assign;
 				Variant value;
 
-				error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &parser);
+				error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &parser);
 
 				if (error) {
 					if (error == ERR_FILE_MISSING_DEPENDENCIES) {
@@ -357,7 +357,7 @@ Ref<PackedScene> ResourceLoaderText::_parse_node_tag(VariantParser::ResourcePars
 					unbinds,
 					bind_ints);
 
-			error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &parser);
+			error = VariantParser::parse_tag(stream, lines, error_text, next_tag, &parser);
 
 			if (error) {
 				if (error != ERR_FILE_EOF) {
@@ -380,7 +380,7 @@ Ref<PackedScene> ResourceLoaderText::_parse_node_tag(VariantParser::ResourcePars
 
 			packed_scene->get_state()->add_editable_instance(path.simplified());
 
-			error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &parser);
+			error = VariantParser::parse_tag(stream, lines, error_text, next_tag, &parser);
 
 			if (error) {
 				if (error != ERR_FILE_EOF) {
@@ -475,7 +475,7 @@ Error ResourceLoaderText::load() {
 			}
 		}
 
-		error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+		error = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp);
 
 		if (error) {
 			_printerr();
@@ -518,20 +518,17 @@ Error ResourceLoaderText::load() {
 		Ref<Resource> res;
 		bool do_assign = false;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		Ref<Resource> cache = ResourceCache::get_ref(path);
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && cache.is_valid() && cache->get_class() == type) {
 			//reuse existing
-			Ref<Resource> cache = ResourceCache::get_ref(path);
-			if (cache.is_valid() && cache->get_class() == type) {
-				res = cache;
-				res->reset_state();
-				do_assign = true;
-			}
+			res = cache;
+			res->reset_state();
+			do_assign = true;
 		}
 
 		MissingResource *missing_resource = nullptr;
 
 		if (res.is_null()) { //not reuse
-			Ref<Resource> cache = ResourceCache::get_ref(path);
 			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && cache.is_valid()) { //only if it doesn't exist
 				//cached, do not assign
 				res = cache;
@@ -586,7 +583,7 @@ Error ResourceLoaderText::load() {
 			String assign;
 			Variant value;
 
-			error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &rp);
+			error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &rp);
 
 			if (error) {
 				_printerr();
@@ -699,7 +696,7 @@ Error ResourceLoaderText::load() {
 			String assign;
 			Variant value;
 
-			error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &rp);
+			error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &rp);
 
 			if (error) {
 				if (error != ERR_FILE_EOF) {
@@ -827,10 +824,10 @@ void ResourceLoaderText::set_translation_remapped(bool p_remapped) {
 }
 
 ResourceLoaderText::ResourceLoaderText() :
-		stream(false) {}
+		stream_file(false) {}
 
 void ResourceLoaderText::get_dependencies(Ref<FileAccess> p_f, List<String> *p_dependencies, bool p_add_types) {
-	open(p_f);
+	open(p_f, false, true);
 	ignore_resource_parsing = true;
 	ERR_FAIL_COND(error != OK);
 
@@ -882,7 +879,7 @@ void ResourceLoaderText::get_dependencies(Ref<FileAccess> p_f, List<String> *p_d
 
 		p_dependencies->push_back(path);
 
-		Error err = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+		Error err = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp);
 
 		if (err) {
 			print_line(error_text + " - " + itos(lines));
@@ -907,7 +904,7 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 	uint64_t tag_end = f->get_position();
 
 	while (true) {
-		Error err = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+		Error err = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp);
 
 		if (err != OK) {
 			error = ERR_FILE_CORRUPT;
@@ -1025,19 +1022,35 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 	return OK;
 }
 
-void ResourceLoaderText::open(Ref<FileAccess> p_f, bool p_skip_first_tag) {
+void ResourceLoaderText::open(Ref<FileAccess> p_f, bool p_skip_first_tag, bool p_header_only) {
 	error = OK;
 
 	lines = 1;
 	f = p_f;
 
-	stream.f = f;
+	if (p_skip_first_tag || p_header_only) {
+		// Either the rest of the file is copied from the file position after the first tags, so it can't be read ahead,
+		// or only the first tags are needed, so reading the whole file is wasted.
+		stream_file.f = f;
+		stream = &stream_file;
+	} else {
+		uint64_t size = f->get_length() - f->get_position();
+		const uint8_t *data = f->get_buffer_view(size);
+		if (!data) {
+			file_data.resize(size);
+			size = f->get_buffer(file_data.ptrw(), size);
+			data = file_data.ptr();
+		}
+		stream_buffer.set_buffer(data, size);
+		stream = &stream_buffer;
+	}
+
 	is_scene = false;
 	ignore_resource_parsing = false;
 	resource_current = 0;
 
 	VariantParser::Tag tag;
-	Error err = VariantParser::parse_tag(&stream, lines, error_text, tag);
+	Error err = VariantParser::parse_tag(stream, lines, error_text, tag);
 
 	if (err) {
 		error = err;
@@ -1092,7 +1105,7 @@ void ResourceLoaderText::open(Ref<FileAccess> p_f, bool p_skip_first_tag) {
 	}
 
 	if (!p_skip_first_tag) {
-		err = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+		err = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp);
 
 		if (err) {
 			error_text = "Unexpected end of file";
@@ -1203,7 +1216,7 @@ Error ResourceLoaderText::save_as_binary(const String &p_path) {
 		dummy_read.external_resources[dr] = lindex;
 		dummy_read.rev_external_resources[id] = dr;
 
-		error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp_new);
+		error = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp_new);
 
 		if (error) {
 			_printerr();
@@ -1286,7 +1299,7 @@ Error ResourceLoaderText::save_as_binary(const String &p_path) {
 				String assign;
 				Variant value;
 
-				error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &rp_new);
+				error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &rp_new);
 
 				if (error) {
 					if (main_res && error == ERR_FILE_EOF) {
@@ -1411,7 +1424,7 @@ Error ResourceLoaderText::get_classes_used(HashSet<StringName> *r_classes) {
 	rp_new.userdata = &dummy_read;
 
 	while (next_tag.name == "ext_resource") {
-		error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp_new);
+		error = VariantParser::parse_tag(stream, lines, error_text, next_tag, &rp_new);
 
 		if (error) {
 			_printerr();
@@ -1438,7 +1451,7 @@ Error ResourceLoaderText::get_classes_used(HashSet<StringName> *r_classes) {
 			String assign;
 			Variant value;
 
-			error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &rp_new);
+			error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &rp_new);
 
 			if (error) {
 				if (error == ERR_FILE_EOF) {
@@ -1486,7 +1499,7 @@ Error ResourceLoaderText::get_classes_used(HashSet<StringName> *r_classes) {
 			String assign;
 			Variant value;
 
-			error = VariantParser::parse_tag_assign_eof(&stream, lines, error_text, next_tag, assign, value, &rp_new);
+			error = VariantParser::parse_tag_assign_eof(stream, lines, error_text, next_tag, assign, value, &rp_new);
 
 			if (error) {
 				if (error == ERR_FILE_MISSING_DEPENDENCIES) {
@@ -1522,12 +1535,14 @@ String ResourceLoaderText::recognize_script_class(Ref<FileAccess> p_f) {
 	lines = 1;
 	f = p_f;
 
-	stream.f = f;
+	// Only the first tag is needed, don't read the whole file.
+	stream_file.f = f;
+	stream = &stream_file;
 
 	ignore_resource_parsing = true;
 
 	VariantParser::Tag tag;
-	Error err = VariantParser::parse_tag(&stream, lines, error_text, tag);
+	Error err = VariantParser::parse_tag(stream, lines, error_text, tag);
 
 	if (err) {
 		_printerr();
@@ -1560,12 +1575,13 @@ String ResourceLoaderText::recognize(Ref<FileAccess> p_f) {
 	lines = 1;
 	f = p_f;
 
-	stream.f = f;
+	stream_file.f = f;
+	stream = &stream_file;
 
 	ignore_resource_parsing = true;
 
 	VariantParser::Tag tag;
-	Error err = VariantParser::parse_tag(&stream, lines, error_text, tag);
+	Error err = VariantParser::parse_tag(stream, lines, error_text, tag);
 
 	if (err) {
 		_printerr();
@@ -1604,12 +1620,13 @@ ResourceUID::ID ResourceLoaderText::get_uid(Ref<FileAccess> p_f) {
 	lines = 1;
 	f = p_f;
 
-	stream.f = f;
+	stream_file.f = f;
+	stream = &stream_file;
 
 	ignore_resource_parsing = true;
 
 	VariantParser::Tag tag;
-	Error err = VariantParser::parse_tag(&stream, lines, error_text, tag);
+	Error err = VariantParser::parse_tag(stream, lines, error_text, tag);
 
 	if (err) {
 		_printerr();
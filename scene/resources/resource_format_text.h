@@ -45,7 +45,11 @@ class ResourceLoaderText {
 
 	Ref<FileAccess> f;
 
-	VariantParser::StreamFile stream;
+	// Resources are parsed from memory, the file is only streamed when rewriting it in place.
+	Vector<uint8_t> file_data;
+	VariantParser::StreamBuffer stream_buffer;
+	VariantParser::StreamFile stream_file;
+	VariantParser::Stream *stream = &stream_buffer;
 
 	struct ExtResource {
 		Ref<ResourceLoader::LoadToken> load_token;
@@ -123,7 +127,7 @@ public:
 	int get_stage_count() const;
 	void set_translation_remapped(bool p_remapped);
 
-	void open(Ref<FileAccess> p_f, bool p_skip_first_tag = false);
+	void open(Ref<FileAccess> p_f, bool p_skip_first_tag = false, bool p_header_only = false);
 	String recognize(Ref<FileAccess> p_f);
 	String recognize_script_class(Ref<FileAccess> p_f);
 	ResourceUID::ID get_uid(Ref<FileAccess> p_f);
@@ -1367,6 +1367,12 @@ int GodotPhysicsServer2D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_COMMAND_QUEUE_COMMANDS_IN_STEP:
+		case INFO_COMMAND_QUEUE_BYTES_IN_STEP:
+		case INFO_COMMAND_QUEUE_STALLS_IN_STEP: {
+			// Only queued when physics runs on its own thread, see PhysicsServer2DWrapMT.
+			return 0;
+		} break;
 	}
 
 	return 0;
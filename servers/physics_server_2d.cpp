@@ -876,6 +876,9 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_COMMAND_QUEUE_COMMANDS_IN_STEP);
+	BIND_ENUM_CONSTANT(INFO_COMMAND_QUEUE_BYTES_IN_STEP);
+	BIND_ENUM_CONSTANT(INFO_COMMAND_QUEUE_STALLS_IN_STEP);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
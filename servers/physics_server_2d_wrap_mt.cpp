@@ -68,6 +68,7 @@ void PhysicsServer2DWrapMT::thread_loop() {
 
 void PhysicsServer2DWrapMT::step(real_t p_step) {
 	if (create_thread) {
+		command_queue_step_stats = command_queue.get_and_reset_stats();
 		command_queue.push(this, &PhysicsServer2DWrapMT::thread_step, p_step);
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
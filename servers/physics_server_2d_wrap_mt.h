@@ -47,6 +47,7 @@ class PhysicsServer2DWrapMT : public PhysicsServer2D {
 	mutable PhysicsServer2D *physics_server_2d;
 
 	mutable CommandQueueMT command_queue;
+	CommandQueueMT::Stats command_queue_step_stats;
 
 	static void _thread_callback(void *_instance);
 	void thread_loop();
@@ -319,7 +320,16 @@ public:
 	}
 
 	int get_process_info(ProcessInfo p_info) override {
-		return physics_server_2d->get_process_info(p_info);
+		switch (p_info) {
+			case INFO_COMMAND_QUEUE_COMMANDS_IN_STEP:
+				return command_queue_step_stats.commands;
+			case INFO_COMMAND_QUEUE_BYTES_IN_STEP:
+				return command_queue_step_stats.bytes;
+			case INFO_COMMAND_QUEUE_STALLS_IN_STEP:
+				return command_queue_step_stats.stalls;
+			default:
+				return physics_server_2d->get_process_info(p_info);
+		}
 	}
 
 	PhysicsServer2DWrapMT(PhysicsServer2D *p_contained, bool p_create_thread);
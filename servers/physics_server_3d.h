@@ -805,7 +805,10 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_COMMAND_QUEUE_COMMANDS_IN_STEP,
+		INFO_COMMAND_QUEUE_BYTES_IN_STEP,
+		INFO_COMMAND_QUEUE_STALLS_IN_STEP,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
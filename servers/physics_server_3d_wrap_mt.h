@@ -46,6 +46,7 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	mutable PhysicsServer3D *physics_server_3d;
 
 	mutable CommandQueueMT command_queue;
+	CommandQueueMT::Stats command_queue_step_stats;
 
 	static void _thread_callback(void *_instance);
 	void thread_loop();
@@ -395,7 +396,16 @@ public:
 	}
 
 	int get_process_info(ProcessInfo p_info) override {
-		return physics_server_3d->get_process_info(p_info);
+		switch (p_info) {
+			case INFO_COMMAND_QUEUE_COMMANDS_IN_STEP:
+				return command_queue_step_stats.commands;
+			case INFO_COMMAND_QUEUE_BYTES_IN_STEP:
+				return command_queue_step_stats.bytes;
+			case INFO_COMMAND_QUEUE_STALLS_IN_STEP:
+				return command_queue_step_stats.stalls;
+			default:
+				return physics_server_3d->get_process_info(p_info);
+		}
 	}
 
 	PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread);
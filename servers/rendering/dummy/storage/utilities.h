@@ -52,6 +52,8 @@ public:
 	virtual RS::InstanceType get_base_type(RID p_rid) const override {
 		if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_rid)) {
 			return RS::INSTANCE_MESH;
+		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
+			return RS::INSTANCE_MULTIMESH;
 		}
 		return RS::INSTANCE_NONE;
 	}
@@ -63,6 +65,9 @@ public:
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_rid)) {
 			RendererDummy::MeshStorage::get_singleton()->mesh_free(p_rid);
 			return true;
+		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
+			RendererDummy::MeshStorage::get_singleton()->multimesh_free(p_rid);
+			return true;
 		}
 		return false;
 	}
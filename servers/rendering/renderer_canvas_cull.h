@@ -56,6 +56,13 @@ public:
 		int ysort_parent_abs_z_index; // Absolute Z index of parent. Only populated and used when y-sorting.
 		uint32_t visibility_layer = 0xffffffff;
 
+		// Bounds of this item and its visible descendants, in local space (xform not applied).
+		// Cached between frames so that off-screen subtrees can be skipped without visiting them.
+		Rect2 bounds_rect;
+		bool bounds_empty = true;
+		bool bounds_dirty = true;
+		bool bounds_cullable = false; // False if something in the subtree must be processed even when off-screen.
+
 		Vector<Item *> child_items;
 
 		struct VisibilityNotifierData {
@@ -181,6 +188,9 @@ public:
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
+	void _mark_bounds_dirty(Item *p_item);
+	void _mark_parent_bounds_dirty(Item *p_item);
+	void _update_canvas_item_bounds(Item *p_item);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort, uint32_t canvas_cull_mask);
 
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
@@ -1649,6 +1649,7 @@ void MaterialStorage::global_shader_parameter_add(const StringName &p_name, RS::
 	}
 
 	global_shader_uniforms.variables[p_name] = gv;
+	ShaderCompiler::global_uniforms_changed();
 }
 
 void MaterialStorage::global_shader_parameter_remove(const StringName &p_name) {
@@ -1665,6 +1666,7 @@ void MaterialStorage::global_shader_parameter_remove(const StringName &p_name) {
 	}
 
 	global_shader_uniforms.variables.erase(p_name);
+	ShaderCompiler::global_uniforms_changed();
 }
 
 Vector<StringName> MaterialStorage::global_shader_parameter_get_list() const {
@@ -1843,6 +1845,7 @@ void MaterialStorage::global_shader_parameters_load_settings(bool p_load_texture
 
 void MaterialStorage::global_shader_parameters_clear() {
 	global_shader_uniforms.variables.clear(); //not right but for now enough
+	ShaderCompiler::global_uniforms_changed();
 }
 
 RID MaterialStorage::global_shader_uniforms_get_storage_buffer() const {
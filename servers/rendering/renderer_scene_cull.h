@@ -817,7 +817,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -1014,7 +1013,26 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	struct ShadowCullPass {
+		InstanceLightData *light = nullptr;
+		uint32_t shadow_index = 0; // Index in render_shadow_data.
+		Vector<Plane> planes;
+		LocalVector<RID> mesh_instances;
+		bool animated_material_found = false;
+	};
+
+	struct ShadowCullData {
+		Scenario *scenario = nullptr;
+		uint32_t visible_layers = 0;
+		uint32_t pass_count = 0;
+	};
+
+	// Passes are set up serially, then culled independently so lights don't wait on each other.
+	LocalVector<ShadowCullPass> shadow_cull_passes;
+
+	_FORCE_INLINE_ void _shadow_cull_pass_add(ShadowCullData &r_cull_data, InstanceLightData *p_light, const Vector<Plane> &p_planes, uint32_t p_pass);
+	_FORCE_INLINE_ bool _light_instance_setup_shadow(Instance *p_instance, ShadowCullData &r_cull_data);
+	void _shadow_cull_pass(uint32_t p_pass, ShadowCullData *p_cull_data);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 
@@ -254,6 +254,12 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_primitives_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_COMMAND_QUEUE_COMMANDS_IN_FRAME) {
+		return command_queue_frame_stats.commands;
+	} else if (p_info == RENDERING_INFO_COMMAND_QUEUE_BYTES_IN_FRAME) {
+		return command_queue_frame_stats.bytes;
+	} else if (p_info == RENDERING_INFO_COMMAND_QUEUE_STALLS_IN_FRAME) {
+		return command_queue_frame_stats.stalls;
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -380,6 +386,7 @@ void RenderingServerDefault::sync() {
 
 void RenderingServerDefault::draw(bool p_swap_buffers, double frame_step) {
 	if (create_thread) {
+		command_queue_frame_stats = command_queue.get_and_reset_stats();
 		command_queue.push(this, &RenderingServerDefault::_thread_draw, p_swap_buffers, frame_step);
 	} else {
 		_draw(p_swap_buffers, frame_step);
@@ -74,6 +74,7 @@ class RenderingServerDefault : public RenderingServer {
 	uint32_t print_frame_profile_frame_count = 0;
 
 	mutable CommandQueueMT command_queue;
+	CommandQueueMT::Stats command_queue_frame_stats;
 
 	static void _thread_callback(void *_instance);
 	void _thread_loop();
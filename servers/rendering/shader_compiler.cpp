@@ -445,14 +445,6 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					used_rmode_defines.insert(pnode->render_modes[i]);
 				}
 
-				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
-					*p_actions.render_mode_flags[pnode->render_modes[i]] = true;
-				}
-
-				if (p_actions.render_mode_values.has(pnode->render_modes[i])) {
-					Pair<int *, int> &p = p_actions.render_mode_values[pnode->render_modes[i]];
-					*p.first = p.second;
-				}
 			}
 
 			// structs
@@ -536,7 +528,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 				if (uniform.scope == SL::ShaderNode::Uniform::SCOPE_INSTANCE) {
 					//insert, but don't generate any code.
-					p_actions.uniforms->insert(uniform_name, uniform);
+					used_uniforms.insert(uniform_name, uniform);
 					continue; // Instances are indexed directly, don't need index uniforms.
 				}
 
@@ -616,7 +608,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					}
 				}
 
-				p_actions.uniforms->insert(uniform_name, uniform);
+				used_uniforms.insert(uniform_name, uniform);
 			}
 
 			for (int i = 0; i < max_uniforms; i++) {
@@ -885,7 +877,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (p_assigning && p_actions.write_flag_pointers.has(vnode->name)) {
-				*p_actions.write_flag_pointers[vnode->name] = true;
+				used_write_flags.insert(vnode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
@@ -898,7 +890,6 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
-				*p_actions.usage_flag_pointers[vnode->name] = true;
 				used_flag_pointers.insert(vnode->name);
 			}
 
@@ -1002,7 +993,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (p_assigning && p_actions.write_flag_pointers.has(anode->name)) {
-				*p_actions.write_flag_pointers[anode->name] = true;
+				used_write_flags.insert(anode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
@@ -1015,7 +1006,6 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (p_actions.usage_flag_pointers.has(anode->name) && !used_flag_pointers.has(anode->name)) {
-				*p_actions.usage_flag_pointers[anode->name] = true;
 				used_flag_pointers.insert(anode->name);
 			}
 
@@ -1155,7 +1145,6 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 						code += String(vnode->name);
 					} else {
 						if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
-							*p_actions.usage_flag_pointers[vnode->name] = true;
 							used_flag_pointers.insert(vnode->name);
 						}
 
@@ -1216,7 +1205,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							}
 
 							if (found && p_actions.write_flag_pointers.has(name)) {
-								*p_actions.write_flag_pointers[name] = true;
+								used_write_flags.insert(name);
 							}
 						}
 
@@ -1401,7 +1390,6 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				}
 			} else if (cfnode->flow_op == SL::FLOW_OP_DISCARD) {
 				if (p_actions.usage_flag_pointers.has("DISCARD") && !used_flag_pointers.has("DISCARD")) {
-					*p_actions.usage_flag_pointers["DISCARD"] = true;
 					used_flag_pointers.insert("DISCARD");
 				}
 
@@ -1438,7 +1426,54 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+SafeNumeric<uint32_t> ShaderCompiler::global_uniforms_version;
+
+void ShaderCompiler::_apply_identifier_actions(const CacheEntry &p_entry, IdentifierActions *p_actions) {
+	for (const StringName &E : p_entry.render_modes) {
+		if (p_actions->render_mode_flags.has(E)) {
+			*p_actions->render_mode_flags[E] = true;
+		}
+
+		if (p_actions->render_mode_values.has(E)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[E];
+			*p.first = p.second;
+		}
+	}
+
+	for (const StringName &E : p_entry.usage_flags) {
+		bool **flag = p_actions->usage_flag_pointers.getptr(E);
+		if (flag) {
+			**flag = true;
+		}
+	}
+
+	for (const StringName &E : p_entry.write_flags) {
+		bool **flag = p_actions->write_flag_pointers.getptr(E);
+		if (flag) {
+			**flag = true;
+		}
+	}
+
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	uint32_t uniforms_version = global_uniforms_version.get();
+	if (cache_global_uniforms_version != uniforms_version) {
+		// Parsed with global uniforms that changed since.
+		cache.clear();
+		cache_global_uniforms_version = uniforms_version;
+	}
+
+	const CacheEntry *cached = cache.getptr(p_code);
+	if (cached && cached->mode == p_mode) {
+		r_gen_code = cached->gen_code;
+		_apply_identifier_actions(*cached, p_actions);
+		return OK;
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1537,17 +1572,40 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	used_name_defines.clear();
 	used_rmode_defines.clear();
 	used_flag_pointers.clear();
+	used_write_flags.clear();
+	used_uniforms.clear();
 	fragment_varyings.clear();
 
 	shader = parser.get_shader();
 	function = nullptr;
 	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
 
+	if (cache.size() >= MAX_CACHE_ENTRIES) {
+		cache.clear();
+	}
+
+	CacheEntry &entry = cache[p_code];
+	entry.mode = p_mode;
+	entry.gen_code = r_gen_code;
+	entry.render_modes = shader->render_modes;
+	entry.usage_flags.clear();
+	for (const StringName &E : used_flag_pointers) {
+		entry.usage_flags.push_back(E);
+	}
+	entry.write_flags.clear();
+	for (const StringName &E : used_write_flags) {
+		entry.write_flags.push_back(E);
+	}
+	entry.uniforms = used_uniforms;
+
+	_apply_identifier_actions(entry, p_actions);
+
 	return OK;
 }
 
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	cache.clear(); // Generated with the previous actions.
 
 	time_name = "TIME";
 
@@ -32,6 +32,7 @@
 #define SHADER_COMPILER_H
 
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
 
@@ -121,16 +122,43 @@ private:
 	HashSet<StringName> used_name_defines;
 	HashSet<StringName> used_flag_pointers;
 	HashSet<StringName> used_rmode_defines;
+	HashSet<StringName> used_write_flags;
 	HashSet<StringName> internal_functions;
 	HashSet<StringName> fragment_varyings;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> used_uniforms;
 
 	DefaultIdentifierActions actions;
 
+	// Results of previous compilations, keyed by the preprocessed code. Identical shaders
+	// (such as the ones generated from the same visual shader graph) are only parsed once.
+	struct CacheEntry {
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		LocalVector<StringName> usage_flags;
+		LocalVector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	enum {
+		MAX_CACHE_ENTRIES = 4096
+	};
+
+	HashMap<String, CacheEntry> cache;
+	uint32_t cache_global_uniforms_version = 0; // Global uniforms the entries were parsed with.
+	static SafeNumeric<uint32_t> global_uniforms_version;
+
+	void _apply_identifier_actions(const CacheEntry &p_entry, IdentifierActions *p_actions);
+
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	// Must be called when global shader uniforms are added or removed, as their types affect the generated code.
+	static void global_uniforms_changed() { global_uniforms_version.increment(); }
+	int get_cached_shader_count() const { return cache.size(); }
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
 };
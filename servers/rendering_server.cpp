@@ -2797,6 +2797,9 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_COMMAND_QUEUE_COMMANDS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_COMMAND_QUEUE_BYTES_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_COMMAND_QUEUE_STALLS_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
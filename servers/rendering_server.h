@@ -1533,6 +1533,9 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_COMMAND_QUEUE_COMMANDS_IN_FRAME,
+		RENDERING_INFO_COMMAND_QUEUE_BYTES_IN_FRAME,
+		RENDERING_INFO_COMMAND_QUEUE_STALLS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
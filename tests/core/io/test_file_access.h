@@ -32,6 +32,8 @@
 #define TEST_FILE_ACCESS_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +109,96 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Buffer views of mapped files") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	const uint8_t *mapped = f->map_read_only();
+	if (!mapped) {
+		CHECK_MESSAGE(f->get_buffer_view(4) == nullptr, "Files that are not mapped should not provide buffer views.");
+		return;
+	}
+
+	uint64_t mapped_size = 0;
+	CHECK_MESSAGE(f->map_read_only(&mapped_size) == mapped, "Mapping the file again should return the same memory.");
+	CHECK_MESSAGE(mapped_size == f->get_length(), "The mapping should cover the whole file.");
+	CHECK(memcmp(mapped, "Hello darkness", 14) == 0);
+
+	f->seek(6);
+	const uint8_t *view = f->get_buffer_view(8);
+	REQUIRE(view != nullptr);
+	CHECK(memcmp(view, "darkness", 8) == 0);
+	CHECK_MESSAGE(f->get_position() == 14, "Buffer views should advance the position.");
+	CHECK(f->get_8() == '\n');
+
+	CHECK_MESSAGE(f->get_buffer_view(f->get_length()) == nullptr, "Buffer views past the end of the file should fail.");
+	CHECK_MESSAGE(f->get_position() == 15, "Failed buffer views should not move the position.");
+}
+
+TEST_CASE("[FileAccess] Buffer views fall back to reading") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	Vector<uint8_t> storage;
+	f->seek(6);
+	const uint8_t *data = f->get_buffer_view_or_read(8, storage);
+	REQUIRE(data != nullptr);
+	CHECK(memcmp(data, "darkness", 8) == 0);
+	CHECK(f->get_position() == 14);
+	CHECK_MESSAGE((storage.is_empty() || storage.ptr() == data), "The bytes should be read into the storage when the file provides no views.");
+
+	Vector<uint8_t> memory_data;
+	memory_data.resize(4);
+	memcpy(memory_data.ptrw(), "GDPC", 4);
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	REQUIRE(fm->open_custom(memory_data.ptr(), memory_data.size()) == OK);
+	Vector<uint8_t> memory_storage;
+	CHECK_MESSAGE(fm->get_buffer_view_or_read(4, memory_storage) == memory_data.ptr(), "Memory backed files should not be copied.");
+	CHECK(memory_storage.is_empty());
+
+	f->seek(f->get_length() - 2);
+	CHECK_MESSAGE(f->get_buffer_view_or_read(8, storage) == nullptr, "Reading past the end of the file should fail.");
+}
+
+TEST_CASE("[FileAccess] Compressed buffers read back") {
+	Vector<uint8_t> data;
+	data.resize(1000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 7) % 251;
+	}
+
+	// Small blocks, so reads span many whole blocks.
+	Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(data.ptr(), data.size(), "GCPF", Compression::MODE_ZSTD, 16);
+	REQUIRE(compressed.size() > 0);
+	CHECK(memcmp(compressed.ptr(), "GCPF", 4) == 0);
+	CHECK(memcmp(compressed.ptr() + compressed.size() - 4, "GCPF", 4) == 0);
+
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	REQUIRE(fm->open_custom(compressed.ptr(), compressed.size()) == OK);
+	fm->seek(4);
+
+	Ref<FileAccessCompressed> fc;
+	fc.instantiate();
+	fc->configure("GCPF");
+	REQUIRE(fc->open_after_magic(fm) == OK);
+	CHECK(fc->get_length() == 1000);
+
+	Vector<uint8_t> read;
+	read.resize(1000);
+	CHECK(fc->get_buffer(read.ptrw(), 5) == 5);
+	CHECK(fc->get_buffer(read.ptrw() + 5, 900) == 900);
+	CHECK(fc->get_position() == 905);
+	CHECK_FALSE(fc->eof_reached());
+	CHECK_MESSAGE(fc->get_buffer(read.ptrw() + 905, 200) == 95, "Reads past the end should stop at the end of the file.");
+	CHECK(fc->eof_reached());
+	CHECK(memcmp(read.ptr(), data.ptr(), 1000) == 0);
+
+	fc->seek(500);
+	CHECK(fc->get_8() == data[500]);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -208,6 +208,60 @@ TEST_CASE("[Image] Resizing") {
 			"get_size() should return the correct size after resize_to_po2().");
 }
 
+TEST_CASE("[Image] Processing large images") {
+	// Large enough to be split in row bands over the WorkerThreadPool.
+	const Color color = Color::hex(0x4080c0ff);
+	Ref<Image> image = memnew(Image(600, 600, false, Image::FORMAT_RGBA8));
+	image->fill(color);
+
+	auto is_filled_with = [](const Ref<Image> &p_image, const uint8_t *p_pixel, int p_pixel_size) {
+		const Vector<uint8_t> data = p_image->get_data();
+		for (int i = 0; i < data.size(); i++) {
+			if (data[i] != p_pixel[i % p_pixel_size]) {
+				return false;
+			}
+		}
+		return true;
+	};
+	const uint8_t rgba[4] = { 64, 128, 192, 255 };
+
+	for (int i = 0; i < 5; i++) {
+		Ref<Image> image_resized = image->duplicate();
+		image_resized->resize(1000, 700, static_cast<Image::Interpolation>(i));
+		CHECK_MESSAGE(
+				is_filled_with(image_resized, rgba, 4),
+				"Resizing a uniform image should keep every row uniform.");
+	}
+
+	Ref<Image> image_nearest = memnew(Image(600, 600, false, Image::FORMAT_R8));
+	for (int x = 0; x < 600; x++) {
+		image_nearest->set_pixel(x, 0, Color((x % 256) / 255.0, 0, 0));
+	}
+	image_nearest->resize(1200, 600, Image::INTERPOLATE_NEAREST);
+	CHECK_MESSAGE(
+			image_nearest->get_pixel(1199, 0).is_equal_approx(Color((599 % 256) / 255.0, 0, 0)),
+			"Nearest resizing should sample the expected source column.");
+
+	Ref<Image> image_mipmaps = image->duplicate();
+	image_mipmaps->resize(1024, 1024);
+	image_mipmaps->generate_mipmaps();
+	CHECK_MESSAGE(
+			is_filled_with(image_mipmaps, rgba, 4),
+			"Every mipmap of a uniform image should be uniform.");
+
+	Ref<Image> image_rgb = image->duplicate();
+	image_rgb->convert(Image::FORMAT_RGB8);
+	CHECK_MESSAGE(
+			is_filled_with(image_rgb, rgba, 3),
+			"Converting to RGB8 should convert every row.");
+
+	Ref<Image> image_rgbaf = image->duplicate();
+	image_rgbaf->convert(Image::FORMAT_RGBAF);
+	CHECK_MESSAGE(
+			image_rgbaf->get_pixel(599, 599).is_equal_approx(color),
+			"Converting to RGBAF should convert every row.");
+}
+
 TEST_CASE("[Image] Modifying pixels of an image") {
 	Ref<Image> image = memnew(Image(3, 3, false, Image::FORMAT_RGBA8));
 	image->set_pixel(0, 0, Color(1, 1, 1, 1));
@@ -33,6 +33,7 @@
 
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/math/math_funcs.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -40,6 +41,14 @@
 
 namespace TestPCKPacker {
 
+// Removes the packs added to the global PackedData when the test case ends, so their files
+// don't shadow the project files in later test cases. Tests run without any pack loaded.
+struct ScopedPacks {
+	~ScopedPacks() {
+		PackedData::get_singleton()->clear();
+	}
+};
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_empty.pck");
@@ -117,6 +126,161 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack a PCK file with compressed files") {
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_compressed.pck");
+	CHECK_MESSAGE(
+			pck_packer.pck_start(output_pck_path) == OK,
+			"Starting a PCK file should return an OK error code.");
+
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+	const String source_path = base_dir.path_join("../icon.svg");
+
+	CHECK_MESSAGE(
+			pck_packer.add_file_compressed("icon.svg", source_path) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.add_file("res://pck_packer_compressed/icon_raw.svg", source_path) == OK,
+			"Adding an uncompressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.add_file_compressed("res://pck_packer_compressed/icon.svg", source_path) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			pck_packer.add_file_compressed("icon_brotli.svg", source_path, FileAccess::COMPRESSION_BROTLI) == ERR_INVALID_PARAMETER,
+			"Brotli can't be used to compress files.");
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	const String uncompressed_pck_path = OS::get_singleton()->get_cache_path().path_join("output_uncompressed.pck");
+	PCKPacker uncompressed_pck_packer;
+	uncompressed_pck_packer.pck_start(uncompressed_pck_path);
+	uncompressed_pck_packer.add_file("icon.svg", source_path);
+	uncompressed_pck_packer.add_file("res://pck_packer_compressed/icon_raw.svg", source_path);
+	uncompressed_pck_packer.add_file("res://pck_packer_compressed/icon.svg", source_path);
+	uncompressed_pck_packer.flush();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ, &err);
+	CHECK_MESSAGE(
+			err == OK,
+			"The generated compressed PCK file should be opened successfully.");
+	Ref<FileAccess> f_uncompressed = FileAccess::open(uncompressed_pck_path, FileAccess::READ, &err);
+	REQUIRE(err == OK);
+	CHECK_MESSAGE(
+			f->get_length() < f_uncompressed->get_length(),
+			"The generated compressed PCK file should be smaller than the uncompressed one.");
+
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION,
+			"A PCK file with compressed files should use the current format version.");
+	f_uncompressed->seek(4);
+	CHECK_MESSAGE(
+			f_uncompressed->get_32() == PACK_FORMAT_VERSION_UNCOMPRESSED,
+			"A PCK file without compressed files should stay readable by older versions.");
+
+	ScopedPacks scoped_packs;
+	CHECK_MESSAGE(
+			PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK,
+			"The generated compressed PCK file should be loaded successfully.");
+	const Vector<uint8_t> source_data = FileAccess::get_file_as_bytes(source_path);
+	for (const String &path : { String("res://pck_packer_compressed/icon.svg"), String("res://pck_packer_compressed/icon_raw.svg") }) {
+		Ref<FileAccess> packed_file = PackedData::get_singleton()->try_open_path(path);
+		REQUIRE(packed_file.is_valid());
+		CHECK_MESSAGE(
+				packed_file->get_length() == (uint64_t)source_data.size(),
+				"The packed file should have the size of its source.");
+		Vector<uint8_t> packed_data;
+		packed_data.resize(packed_file->get_length());
+		packed_file->get_buffer(packed_data.ptrw(), packed_data.size());
+		CHECK_MESSAGE(
+				packed_data == source_data,
+				"The packed file should read back as its source.");
+	}
+}
+
+TEST_CASE("[PCKPacker] Pack a PCK file with files that don't compress") {
+	// Random data doesn't shrink when compressed, so it should be stored as is.
+	const String source_path = OS::get_singleton()->get_cache_path().path_join("pck_packer_random.bin");
+	Vector<uint8_t> source_data;
+	source_data.resize(4096);
+	for (int i = 0; i < source_data.size(); i++) {
+		source_data.write[i] = Math::rand() % 256;
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(source_data.ptr(), source_data.size());
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_incompressible.pck");
+	CHECK_MESSAGE(
+			pck_packer.pck_start(output_pck_path) == OK,
+			"Starting a PCK file should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.add_file_compressed("res://pck_packer_incompressible/random.bin", source_path) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	CHECK_MESSAGE(
+			pck_packer.flush() == OK,
+			"Flushing the PCK should return an OK error code.");
+
+	Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_UNCOMPRESSED,
+			"A PCK file whose files were all stored as is shouldn't need the current format version.");
+
+	ScopedPacks scoped_packs;
+	CHECK_MESSAGE(
+			PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK,
+			"The generated PCK file should be loaded successfully.");
+	Ref<FileAccess> packed_file = PackedData::get_singleton()->try_open_path("res://pck_packer_incompressible/random.bin");
+	REQUIRE(packed_file.is_valid());
+	CHECK_MESSAGE(
+			packed_file->get_length() == (uint64_t)source_data.size(),
+			"The packed file should have the size of its source.");
+	Vector<uint8_t> packed_data;
+	packed_data.resize(packed_file->get_length());
+	packed_file->get_buffer(packed_data.ptrw(), packed_data.size());
+	CHECK_MESSAGE(
+			packed_data == source_data,
+			"The packed file should read back as its source.");
+}
+
+TEST_CASE("[PCKPacker] Clearing the packs removes their files") {
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_cleared.pck");
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_cleared/icon.svg", base_dir.path_join("../icon.svg")) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	ScopedPacks scoped_packs;
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	CHECK(PackedData::get_singleton()->has_path("res://pck_packer_cleared/icon.svg"));
+	CHECK(PackedData::get_singleton()->has_directory("res://pck_packer_cleared"));
+
+	// Files opened before clearing keep reading from the pack.
+	Ref<FileAccess> packed_file = PackedData::get_singleton()->try_open_path("res://pck_packer_cleared/icon.svg");
+	REQUIRE(packed_file.is_valid());
+
+	PackedData::get_singleton()->clear();
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pck_packer_cleared/icon.svg"));
+	CHECK_FALSE(PackedData::get_singleton()->has_directory("res://pck_packer_cleared"));
+	CHECK(PackedData::get_singleton()->try_open_path("res://pck_packer_cleared/icon.svg").is_null());
+
+	const Vector<uint8_t> source_data = FileAccess::get_file_as_bytes(base_dir.path_join("../icon.svg"));
+	Vector<uint8_t> packed_data;
+	packed_data.resize(packed_file->get_length());
+	packed_file->get_buffer(packed_data.ptrw(), packed_data.size());
+	CHECK(packed_data == source_data);
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -109,6 +110,103 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Cache shards") {
+	const int path_count = 256;
+	LocalVector<uint32_t> shard_sizes;
+	shard_sizes.resize(ResourceCache::get_shard_count());
+	for (uint32_t &E : shard_sizes) {
+		E = 0;
+	}
+
+	const int initial_count = ResourceCache::get_cached_resource_count();
+	LocalVector<Ref<Resource>> resources;
+	for (int i = 0; i < path_count; i++) {
+		const String path = vformat("res://resource_cache_shards/resource_%d.tres", i);
+		shard_sizes[ResourceCache::get_shard_index(path)]++;
+
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_path(path);
+		resources.push_back(resource);
+	}
+	CHECK(ResourceCache::get_cached_resource_count() == initial_count + path_count);
+
+	for (uint32_t E : shard_sizes) {
+		CHECK_MESSAGE(E > 0, "Paths should be spread over every shard.");
+		CHECK_MESSAGE(E < path_count / ResourceCache::get_shard_count() * 3, "Paths should be spread evenly over the shards.");
+	}
+
+	SUBCASE("Moving resources between shards") {
+		const String old_path = "res://resource_cache_shards/resource_0.tres";
+		String new_path;
+		for (int i = 0; new_path.is_empty(); i++) {
+			const String path = vformat("res://resource_cache_shards/moved_%d.tres", i);
+			if (ResourceCache::get_shard_index(path) != ResourceCache::get_shard_index(old_path)) {
+				new_path = path;
+			}
+		}
+
+		resources[0]->set_path(new_path);
+		CHECK_FALSE(ResourceCache::has(old_path));
+		CHECK(ResourceCache::get_ref(new_path) == resources[0]);
+		CHECK(ResourceCache::get_cached_resource_count() == initial_count + path_count);
+	}
+
+	resources.clear();
+	CHECK_MESSAGE(ResourceCache::get_cached_resource_count() == initial_count, "Freed resources should be removed from the cache.");
+}
+
+struct ResourceCacheThreadData {
+	static const int iterations = 500;
+	Ref<Resource> shared;
+	SafeNumeric<uint32_t> failures;
+};
+
+static void resource_cache_thread(void *p_userdata, uint32_t p_index) {
+	ResourceCacheThreadData *data = (ResourceCacheThreadData *)p_userdata;
+	for (int i = 0; i < ResourceCacheThreadData::iterations; i++) {
+		const String path = vformat("res://resource_cache_threads/resource_%d_%d.tres", p_index, i);
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_path(path);
+
+		// One hit on the resource of this thread, one on the shared one, and one miss once freed.
+		if (ResourceCache::get_ref(path) != resource) {
+			data->failures.increment(); // Cached resource not found.
+		}
+		if (ResourceCache::get_ref(data->shared->get_path()) != data->shared) {
+			data->failures.increment(); // Shared resource not found.
+		}
+		resource.unref();
+		if (ResourceCache::get_ref(path).is_valid()) {
+			data->failures.increment(); // Freed resource still cached.
+		}
+	}
+}
+
+TEST_CASE("[Resource] Cache from several threads") {
+	ResourceCacheThreadData data;
+	data.shared.instantiate();
+	data.shared->set_path("res://resource_cache_threads/shared.tres");
+
+	const int initial_count = ResourceCache::get_cached_resource_count();
+	const uint64_t initial_hits = ResourceCache::get_hit_count();
+	const uint64_t initial_misses = ResourceCache::get_miss_count();
+	const uint64_t initial_contentions = ResourceCache::get_contention_count();
+
+	const int threads = MAX(4, OS::get_singleton()->get_processor_count());
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(resource_cache_thread, &data, threads, threads, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK_MESSAGE(data.failures.get() == 0, "Every thread should find the resources it cached and not the ones it freed.");
+
+	const uint64_t lookups = (uint64_t)threads * ResourceCacheThreadData::iterations;
+	CHECK_MESSAGE(ResourceCache::get_hit_count() - initial_hits == lookups * 2, "Every lookup of a cached resource should count as one hit.");
+	CHECK_MESSAGE(ResourceCache::get_miss_count() - initial_misses == lookups, "Every lookup of a freed resource should count as one miss.");
+	CHECK(ResourceCache::get_contention_count() >= initial_contentions);
+	CHECK_MESSAGE(ResourceCache::get_cached_resource_count() == initial_count, "Resources freed on other threads should be removed from the cache.");
+	CHECK(ResourceCache::get_ref(data.shared->get_path()) == data.shared);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
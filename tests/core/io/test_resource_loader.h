@@ -0,0 +1,226 @@
+/**************************************************************************/
+/*  test_resource_loader.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RESOURCE_LOADER_H
+#define TEST_RESOURCE_LOADER_H
+
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestResourceLoader {
+
+// Loads text files listing the paths of their dependencies, one per line. Every dependency is
+// loaded by the loader itself, like the scene and resource loaders do, and the calls are logged.
+class ResourceFormatLoaderDependencyList : public ResourceFormatLoader {
+	Mutex mutex;
+	Vector<String> log;
+	HashMap<String, int> load_counts;
+
+	static Vector<String> _read_dependencies(const String &p_path) {
+		Vector<String> dependencies;
+		for (const String &E : FileAccess::get_file_as_string(p_path).split("\n", false)) {
+			dependencies.push_back(E.strip_edges());
+		}
+		return dependencies;
+	}
+
+public:
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) override {
+		{
+			MutexLock lock(mutex);
+			log.push_back("load " + p_path.get_file());
+			load_counts[p_path.get_file()]++;
+		}
+
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_name(p_path.get_file());
+		Array dependencies;
+		for (const String &E : _read_dependencies(p_path)) {
+			Ref<Resource> dependency = ResourceLoader::load(E);
+			if (dependency.is_null()) {
+				if (r_error) {
+					*r_error = ERR_FILE_MISSING_DEPENDENCIES;
+				}
+				return Ref<Resource>();
+			}
+			dependencies.push_back(dependency);
+		}
+		resource->set_meta("dependencies", dependencies);
+
+		if (r_error) {
+			*r_error = OK;
+		}
+		return resource;
+	}
+
+	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types) override {
+		{
+			MutexLock lock(mutex);
+			log.push_back("dependencies " + p_path.get_file());
+		}
+
+		for (const String &E : _read_dependencies(p_path)) {
+			p_dependencies->push_back(p_add_types ? E + "::Resource" : E);
+		}
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("deplist");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension().to_lower() == "deplist" ? "Resource" : "";
+	}
+
+	Vector<String> get_log() {
+		MutexLock lock(mutex);
+		return log;
+	}
+
+	int get_load_count(const String &p_file) {
+		MutexLock lock(mutex);
+		const int *count = load_counts.getptr(p_file);
+		return count ? *count : 0;
+	}
+};
+
+// Writes "<p_prefix>_<name>.deplist" files for the graph: a depends on b and d, b depends on c.
+static String write_dependency_graph(const String &p_prefix) {
+	const String base_path = OS::get_singleton()->get_cache_path().path_join(p_prefix);
+	HashMap<String, Vector<String>> graph;
+	graph["a"] = { "b", "d" };
+	graph["b"] = { "c" };
+	graph["c"] = {};
+	graph["d"] = {};
+	for (const KeyValue<String, Vector<String>> &E : graph) {
+		Ref<FileAccess> f = FileAccess::open(base_path + "_" + E.key + ".deplist", FileAccess::WRITE);
+		for (const String &dependency : E.value) {
+			f->store_line(base_path + "_" + dependency + ".deplist");
+		}
+	}
+	return base_path;
+}
+
+static int find_in_log(const Vector<String> &p_log, const String &p_entry) {
+	return p_log.find(p_entry);
+}
+
+TEST_CASE("[ResourceLoader] Threaded loads prefetch their dependencies") {
+	Ref<ResourceFormatLoaderDependencyList> loader;
+	loader.instantiate();
+	ResourceLoader::add_resource_format_loader(loader);
+
+	SUBCASE("The dependency graph is walked before loading, level by level") {
+		const String base_path = write_dependency_graph("prefetch_order");
+		REQUIRE(ResourceLoader::load_threaded_request(base_path + "_a.deplist", "", true) == OK);
+		Ref<Resource> resource = ResourceLoader::load_threaded_get(base_path + "_a.deplist");
+		REQUIRE(resource.is_valid());
+		CHECK(Array(resource->get_meta("dependencies")).size() == 2);
+
+		const Vector<String> log = loader->get_log();
+		const String a = "prefetch_order_a.deplist";
+		const String b = "prefetch_order_b.deplist";
+		const String c = "prefetch_order_c.deplist";
+		const String d = "prefetch_order_d.deplist";
+		for (const String &E : { a, b, c, d }) {
+			CHECK_MESSAGE(find_in_log(log, "dependencies " + E) >= 0, "Every resource of the graph should have been prefetched.");
+			CHECK_MESSAGE(loader->get_load_count(E) == 1, "Every resource of the graph should have been loaded once.");
+		}
+
+		CHECK(find_in_log(log, "dependencies " + a) == 0);
+		CHECK_MESSAGE(find_in_log(log, "dependencies " + b) < find_in_log(log, "dependencies " + c), "Dependencies should be walked level by level.");
+		CHECK_MESSAGE(find_in_log(log, "dependencies " + d) < find_in_log(log, "dependencies " + c), "Dependencies should be walked level by level.");
+
+		int last_walk = 0;
+		int first_load = log.size();
+		for (int i = 0; i < log.size(); i++) {
+			if (log[i].begins_with("dependencies ")) {
+				last_walk = i;
+			} else {
+				first_load = MIN(first_load, i);
+			}
+		}
+		CHECK_MESSAGE(last_walk < first_load, "The whole graph should be walked before anything is loaded.");
+	}
+
+	SUBCASE("Dependencies already loading are not loaded again") {
+		const String base_path = write_dependency_graph("prefetch_dedup");
+		// The dependency is either still loading or in the cache when the prefetch reaches it.
+		REQUIRE(ResourceLoader::load_threaded_request(base_path + "_b.deplist", "", true) == OK);
+		REQUIRE(ResourceLoader::load_threaded_request(base_path + "_a.deplist", "", true) == OK);
+		Ref<Resource> resource = ResourceLoader::load_threaded_get(base_path + "_a.deplist");
+		Ref<Resource> dependency = ResourceLoader::load_threaded_get(base_path + "_b.deplist");
+		REQUIRE(resource.is_valid());
+		REQUIRE(dependency.is_valid());
+
+		CHECK_MESSAGE(Ref<Resource>(Array(resource->get_meta("dependencies"))[0]) == dependency, "The load requested first should be shared.");
+		for (const String &E : { "a", "b", "c", "d" }) {
+			CHECK_MESSAGE(loader->get_load_count("prefetch_dedup_" + String(E) + ".deplist") == 1, "Every resource of the graph should have been loaded once.");
+		}
+	}
+
+	SUBCASE("Loads ignoring the cache don't prefetch") {
+		const String base_path = write_dependency_graph("prefetch_ignore");
+		REQUIRE(ResourceLoader::load_threaded_request(base_path + "_a.deplist", "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+		Ref<Resource> resource = ResourceLoader::load_threaded_get(base_path + "_a.deplist");
+		REQUIRE(resource.is_valid());
+
+		const Vector<String> log = loader->get_log();
+		for (const String &E : log) {
+			CHECK_MESSAGE(!E.begins_with("dependencies "), "Prefetched dependencies would be cached, so they are only prefetched when the cache is reused.");
+		}
+		CHECK(loader->get_load_count("prefetch_ignore_c.deplist") == 1);
+	}
+
+	SUBCASE("Loads without sub-threads don't prefetch") {
+		const String base_path = write_dependency_graph("prefetch_single");
+		REQUIRE(ResourceLoader::load_threaded_request(base_path + "_a.deplist", "", false) == OK);
+		Ref<Resource> resource = ResourceLoader::load_threaded_get(base_path + "_a.deplist");
+		REQUIRE(resource.is_valid());
+
+		for (const String &E : loader->get_log()) {
+			CHECK(!E.begins_with("dependencies "));
+		}
+		CHECK(loader->get_load_count("prefetch_single_c.deplist") == 1);
+	}
+
+	ResourceLoader::remove_resource_format_loader(loader);
+}
+
+} // namespace TestResourceLoader
+
+#endif // TEST_RESOURCE_LOADER_H
@@ -132,6 +132,16 @@ public:
 	void func3(Transform3D t1, Transform3D t2, Transform3D t3, Transform3D t4, Transform3D t5, Transform3D t6) {
 		func1_count++;
 	}
+	void func_reentrant(Transform3D t) {
+		func1_count++;
+		command_queue.push(this, &SharedThreadState::func_ordered, 2);
+		command_queue.flush_if_pending();
+	}
+	LocalVector<int> order;
+	void func_ordered(int p_index) {
+		func1_count++;
+		order.push_back(p_index);
+	}
 	Transform3D func1r(Transform3D t) {
 		func1_count++;
 		return t;
@@ -151,7 +161,10 @@ public:
 			if (message_count_to_read < 0) {
 				command_queue.flush_all();
 			}
-			for (int i = 0; i < message_count_to_read; i++) {
+			// Each wakeup runs every command pushed until then, so wait
+			// until enough were run rather than for a wakeup per command.
+			int target_count = func1_count + message_count_to_read;
+			while (func1_count < target_count) {
 				command_queue.wait_and_flush();
 			}
 			message_count_to_read = 0;
@@ -381,6 +394,121 @@ TEST_CASE("[CommandQueue] Test Queue Lapping") {
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
 
+TEST_CASE("[CommandQueue] Test Queue Stats") {
+	SharedThreadState sts;
+	Transform3D tr;
+
+	CommandQueueMT::Stats stats = sts.command_queue.get_and_reset_stats();
+	CHECK_MESSAGE(stats.commands == 0,
+			"Control: no commands pushed yet.");
+
+	sts.command_queue.push(&sts, &SharedThreadState::func1, tr);
+	sts.command_queue.push(&sts, &SharedThreadState::func2, tr, 1.0f);
+	stats = sts.command_queue.get_and_reset_stats();
+	CHECK_MESSAGE(stats.commands == 2,
+			"Stats should count both pushed commands.");
+	CHECK_MESSAGE(stats.bytes > 2 * sizeof(Transform3D),
+			"Stats should count the bytes used by the pushed commands.");
+	CHECK_MESSAGE(stats.stalls == 0,
+			"Pushing from a single thread should never stall.");
+
+	stats = sts.command_queue.get_and_reset_stats();
+	CHECK_MESSAGE(stats.commands == 0,
+			"Stats should be reset after being read.");
+
+	sts.command_queue.flush_all();
+	CHECK_MESSAGE(sts.func1_count == 2,
+			"Flushing should run the commands pushed before reading the stats.");
+}
+
+TEST_CASE("[CommandQueue] Test Queue Reentrant Flush") {
+	SharedThreadState sts;
+	Transform3D tr;
+
+	// The first command pushes another one and flushes again while its own buffer is being read.
+	sts.command_queue.push(&sts, &SharedThreadState::func_reentrant, tr);
+	sts.command_queue.push(&sts, &SharedThreadState::func_ordered, 1);
+	sts.command_queue.flush_all();
+	CHECK_MESSAGE(sts.func1_count == 3,
+			"Every command should run exactly once.");
+	REQUIRE(sts.order.size() == 2);
+	CHECK_MESSAGE(sts.order[0] == 1,
+			"The nested flush should first run what's left of the buffer being flushed.");
+	CHECK_MESSAGE(sts.order[1] == 2,
+			"The nested flush should then run the command pushed during the flush.");
+
+	sts.command_queue.flush_if_pending();
+	CHECK_MESSAGE(sts.func1_count == 3,
+			"Nothing should be left to flush.");
+}
+
+class OrderState {
+public:
+	static const uint32_t PRODUCERS = 4;
+	static const uint32_t COMMANDS_PER_PRODUCER = 2000;
+
+	CommandQueueMT command_queue = CommandQueueMT(true);
+
+	// Held while pushing, so the tickets are handed out in the order the commands are pushed.
+	Mutex push_mutex;
+	uint32_t next_ticket = 0;
+
+	// Only touched by the consumer thread.
+	LocalVector<uint32_t> executed;
+
+	void run(uint32_t p_ticket) {
+		executed.push_back(p_ticket);
+	}
+	void run_and_flush(uint32_t p_ticket) {
+		executed.push_back(p_ticket);
+		command_queue.flush_if_pending();
+	}
+
+	static void producer_loop(void *p_userdata) {
+		OrderState *state = static_cast<OrderState *>(p_userdata);
+		for (uint32_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			MutexLock lock(state->push_mutex);
+			uint32_t ticket = state->next_ticket++;
+			// Some commands flush again while being flushed.
+			if (ticket % 7 == 0) {
+				state->command_queue.push(state, &OrderState::run_and_flush, ticket);
+			} else {
+				state->command_queue.push(state, &OrderState::run, ticket);
+			}
+		}
+	}
+
+	static void consumer_loop(void *p_userdata) {
+		OrderState *state = static_cast<OrderState *>(p_userdata);
+		while (state->executed.size() < PRODUCERS * COMMANDS_PER_PRODUCER) {
+			state->command_queue.wait_and_flush();
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Queue Order With Several Producers") {
+	OrderState state;
+
+	Thread consumer;
+	consumer.start(&OrderState::consumer_loop, &state);
+	Thread producers[OrderState::PRODUCERS];
+	for (Thread &producer : producers) {
+		producer.start(&OrderState::producer_loop, &state);
+	}
+	for (Thread &producer : producers) {
+		producer.wait_to_finish();
+	}
+	consumer.wait_to_finish();
+
+	REQUIRE(state.executed.size() == OrderState::PRODUCERS * OrderState::COMMANDS_PER_PRODUCER);
+	bool in_order = true;
+	for (uint32_t i = 0; i < state.executed.size() && in_order; i++) {
+		in_order = state.executed[i] == i;
+	}
+	CHECK_MESSAGE(in_order,
+			"Commands should run in the order they were pushed, including those run by nested flushes.");
+}
+
 TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
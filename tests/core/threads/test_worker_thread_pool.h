@@ -106,6 +106,29 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static SafeNumeric<int> nested_counter;
+
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	nested_counter.increment();
+}
+static void static_outer_group_test(void *p_arg, uint32_t p_index) {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_group_test, nullptr, (uintptr_t)p_arg, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+}
+TEST_CASE("[WorkerThreadPool] Wait for nested group tasks from pool threads") {
+	// Each pool thread ends up waiting on a group of its own. Unless waiting
+	// threads run queued tasks, no thread is left to process the nested groups.
+	const int threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	const int elements = threads * 2;
+	const int nested_elements = 16;
+
+	nested_counter.set(0);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_outer_group_test, (void *)(uintptr_t)nested_elements, elements, threads, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(nested_counter.get() == elements * nested_elements);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
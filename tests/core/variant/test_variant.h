@@ -31,6 +31,7 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/math/random_pcg.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -1187,6 +1188,114 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+TEST_CASE("[Variant] Parser reading from a memory buffer") {
+	PackedFloat32Array floats;
+	PackedInt32Array ints;
+	for (int i = 0; i < 10000; i++) {
+		floats.push_back(i * 0.25 - 1000.0);
+		ints.push_back(i % 2 ? -i * 1000 : i * 1000);
+	}
+
+	Array array;
+	array.push_back(floats);
+	array.push_back(ints);
+	array.push_back(int64_t(-9223372036854775807));
+
+	String text;
+	VariantWriter::write_to_string(array, text);
+	CharString utf8 = text.utf8();
+
+	VariantParser::StreamBuffer stream;
+	stream.set_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+
+	Variant parsed;
+	String errs;
+	int line = 1;
+	CHECK(VariantParser::parse(&stream, parsed, errs, line) == OK);
+	REQUIRE(parsed.get_type() == Variant::ARRAY);
+
+	Array parsed_array = parsed;
+	REQUIRE(parsed_array.size() == 3);
+	CHECK(PackedFloat32Array(parsed_array[0]) == floats);
+	CHECK(PackedInt32Array(parsed_array[1]) == ints);
+	CHECK(int64_t(parsed_array[2]) == -9223372036854775807);
+}
+
+static inline Variant parse_number(const String &p_text) {
+	VariantParser::StreamString stream;
+	stream.s = p_text;
+	Variant parsed;
+	String errs;
+	int line = 1;
+	CHECK_MESSAGE(VariantParser::parse(&stream, parsed, errs, line) == OK, "Should parse: ", p_text);
+	return parsed;
+}
+
+TEST_CASE("[Variant] Parser floats") {
+	SUBCASE("Exponents") {
+		CHECK(parse_number("1.5e3").get_type() == Variant::FLOAT);
+		CHECK(double(parse_number("1.5e3")) == 1500.0);
+		CHECK(double(parse_number("2.5e-3")) == 0.0025);
+		CHECK(double(parse_number("-7.25e-2")) == -0.0725);
+		CHECK(double(parse_number("1e+22")) == 1e22);
+		CHECK(double(parse_number("1e23")) == 1e23);
+		CHECK(double(parse_number("1.0e+100")) == 1.0e+100);
+		CHECK(double(parse_number("1e-300")) == 1e-300);
+		CHECK(double(parse_number("0.0000000000000000001")) == 1e-19);
+	}
+
+	SUBCASE("Infinities and NaN") {
+		double value = parse_number("inf");
+		CHECK(Math::is_inf(value));
+		CHECK(value > 0);
+		value = parse_number("inf_neg");
+		CHECK(Math::is_inf(value));
+		CHECK(value < 0);
+		CHECK(Math::is_nan(double(parse_number("nan"))));
+		value = parse_number("1e400");
+		CHECK(Math::is_inf(value));
+		CHECK(value > 0);
+		CHECK(double(parse_number("1e-400")) == 0.0);
+	}
+
+	SUBCASE("Precision") {
+		CHECK(double(parse_number("0.1")) == 0.1);
+		CHECK(double(parse_number("0.30000000000000004")) == 0.1 + 0.2);
+		CHECK(double(parse_number("0.1000000000000000055511151231257827")) == 0.1);
+		// Halfway between two doubles, rounds to even.
+		CHECK(double(parse_number("9007199254740993.0")) == 9007199254740992.0);
+		CHECK(double(parse_number("123456789012345678.0")) == 123456789012345678.0);
+		CHECK(double(parse_number("1.7976931348623157e308")) == 1.7976931348623157e308);
+		CHECK(double(parse_number("2.2250738585072014e-308")) == 2.2250738585072014e-308);
+		CHECK(double(parse_number("4.9406564584124654e-324")) == 4.9406564584124654e-324);
+		double negative_zero = parse_number("-0.0");
+		CHECK(negative_zero == 0.0);
+		CHECK(signbit(negative_zero));
+	}
+
+	SUBCASE("Round trip of 17 significant digits") {
+		RandomPCG rng(1234);
+		for (int i = 0; i < 10000; i++) {
+			uint64_t bits = (uint64_t(rng.rand()) << 32) | rng.rand();
+			double value;
+			memcpy(&value, &bits, sizeof(double));
+			if (!Math::is_finite(value)) {
+				continue;
+			}
+
+			char text[64];
+			snprintf(text, sizeof(text), "%.17g", value);
+			String str = text;
+			if (!str.contains(".") && !str.contains("e")) {
+				str += ".0";
+			}
+
+			double parsed = parse_number(str);
+			CHECK_MESSAGE(memcmp(&parsed, &value, sizeof(double)) == 0, "Should parse back exactly: ", str);
+		}
+	}
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  test_cpu_particles_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CPU_PARTICLES_3D_H
+#define TEST_CPU_PARTICLES_3D_H
+
+#include "scene/3d/cpu_particles_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCPUParticles3D {
+
+// Enough particles to be processed on several threads.
+const int particle_amount = 8192;
+
+// Adding the emitter to the tree runs its pre-process time, then returns its instance data.
+static Vector<float> simulate(CPUParticles3D::DrawOrder p_draw_order, uint32_t p_seed) {
+	CPUParticles3D *particles = memnew(CPUParticles3D);
+	particles->set_amount(particle_amount);
+	particles->set_lifetime(1.0);
+	particles->set_pre_process_time(0.75);
+	particles->set_use_local_coordinates(true);
+	particles->set_spread(45.0);
+	particles->set_param_min(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 1.0);
+	particles->set_param_max(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 5.0);
+	particles->set_param_min(CPUParticles3D::PARAM_ANGULAR_VELOCITY, -90.0);
+	particles->set_param_max(CPUParticles3D::PARAM_ANGULAR_VELOCITY, 90.0);
+	particles->set_draw_order(p_draw_order);
+
+	Math::seed(p_seed);
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
+	Vector<float> buffer = RS::get_singleton()->multimesh_get_buffer(particles->get_base());
+
+	memdelete(particles);
+	return buffer;
+}
+
+TEST_CASE("[SceneTree][CPUParticles3D] Processing is deterministic") {
+	const Vector<float> buffer = simulate(CPUParticles3D::DRAW_ORDER_INDEX, 1234);
+	REQUIRE(buffer.size() == particle_amount * 20);
+
+	bool has_data = false;
+	for (int i = 0; i < buffer.size() && !has_data; i++) {
+		has_data = buffer[i] != 0.0f;
+	}
+	CHECK_MESSAGE(has_data, "The particles should have been written to the instance data.");
+
+	SUBCASE("Same seed") {
+		CHECK_MESSAGE(simulate(CPUParticles3D::DRAW_ORDER_INDEX, 1234) == buffer,
+				"Processing the same emitter with the same seed should give the same result, however it was split across threads.");
+	}
+
+	SUBCASE("Serial buffer update") {
+		// Without a camera, view depth order leaves the particles in index order, but
+		// writes the instance data in a serial pass after processing instead of while processing.
+		CHECK_MESSAGE(simulate(CPUParticles3D::DRAW_ORDER_VIEW_DEPTH, 1234) == buffer,
+				"Writing the instance data while processing on several threads should give the same result as writing it afterwards.");
+	}
+
+	SUBCASE("Different seed") {
+		CHECK(simulate(CPUParticles3D::DRAW_ORDER_INDEX, 4321) != buffer);
+	}
+}
+
+} // namespace TestCPUParticles3D
+
+#endif // TEST_CPU_PARTICLES_3D_H
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_packed_scene.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+TEST_CASE("[SceneTree][PackedScene] Instantiate restores node properties") {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(10, 20));
+	root->set_z_index(3);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_rotation(0.5);
+	child->set_visible(false);
+	child->set_meta("tag", "child");
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(root) == OK);
+
+	// The second instantiation reuses the setters resolved by the first one.
+	for (int i = 0; i < 2; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_name() == StringName("Root"));
+		CHECK(instance->get_position() == Vector2(10, 20));
+		CHECK(instance->get_z_index() == 3);
+
+		Node2D *instance_child = Object::cast_to<Node2D>(instance->get_node_or_null(NodePath("Child")));
+		REQUIRE(instance_child != nullptr);
+		CHECK(instance_child->get_owner() == instance);
+		CHECK(Math::is_equal_approx(instance_child->get_rotation(), 0.5));
+		CHECK_FALSE(instance_child->is_visible());
+		CHECK(instance_child->get_meta("tag") == Variant("child"));
+
+		memdelete(instance);
+	}
+
+	// Changing the state must not reuse setters resolved for the old one.
+	root->set_position(Vector2(-5, 5));
+	CHECK(packed_scene->pack(root) == OK);
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_position() == Vector2(-5, 5));
+	memdelete(instance);
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Pooled instances are reset and reused") {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(1, 2));
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(root) == OK);
+	memdelete(root);
+
+	packed_scene->set_pool_capacity(1);
+	uint64_t hits = SceneState::get_pool_hit_count();
+
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+	REQUIRE(instance != nullptr);
+	ObjectID instance_id = instance->get_instance_id();
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	instance->set_position(Vector2(100, 100));
+	Object::cast_to<Node2D>(instance->get_node(NodePath("Child")))->set_visible(false);
+
+	instance->queue_free();
+	SceneTree::get_singleton()->process(0);
+
+	// The instance left the tree but was kept for reuse.
+	CHECK(ObjectDB::get_instance(instance_id) == instance);
+	CHECK_FALSE(instance->is_inside_tree());
+	CHECK(packed_scene->get_pooled_instance_count() == 1);
+
+	Node2D *reused = Object::cast_to<Node2D>(packed_scene->instantiate());
+	CHECK(reused == instance);
+	CHECK(SceneState::get_pool_hit_count() == hits + 1);
+	CHECK(packed_scene->get_pooled_instance_count() == 0);
+	CHECK_FALSE(reused->is_queued_for_deletion());
+	CHECK(reused->get_position() == Vector2(1, 2));
+	// Properties left to their default value in the scene are restored too.
+	CHECK(Object::cast_to<Node2D>(reused->get_node(NodePath("Child")))->is_visible());
+
+	// Instances whose structure changed can't be reset, so they are freed.
+	reused->add_child(memnew(Node));
+	SceneTree::get_singleton()->get_root()->add_child(reused);
+	reused->queue_free();
+	SceneTree::get_singleton()->process(0);
+
+	CHECK(ObjectDB::get_instance(instance_id) == nullptr);
+	CHECK(packed_scene->get_pooled_instance_count() == 0);
+
+	// Neither can instances given state that properties of the scene don't cover.
+	Node2D *changed = Object::cast_to<Node2D>(packed_scene->instantiate());
+	REQUIRE(changed != nullptr);
+	ObjectID changed_id = changed->get_instance_id();
+	SceneTree::get_singleton()->get_root()->add_child(changed);
+	changed->get_node(NodePath("Child"))->set_meta("runtime", true);
+	changed->queue_free();
+	SceneTree::get_singleton()->process(0);
+
+	CHECK(ObjectDB::get_instance(changed_id) == nullptr);
+	CHECK(packed_scene->get_pooled_instance_count() == 0);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Benchmark pooled instances" * doctest::skip()) {
+	// Skipped by default as it only measures. Run with `--no-skip` to compare
+	// reusing pooled instances with instantiating and freeing them.
+	Node2D *root = memnew(Node2D);
+	for (int i = 0; i < 64; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_position(Vector2(i, i));
+		child->set_rotation(i * 0.1);
+		child->set_modulate(Color(1, 0, 0));
+		root->add_child(child);
+		child->set_owner(root);
+	}
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	REQUIRE(packed_scene->pack(root) == OK);
+	memdelete(root);
+
+	const int count = 2000;
+	for (int capacity : { 0, 1 }) {
+		packed_scene->set_pool_capacity(capacity);
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+			SceneTree::get_singleton()->get_root()->add_child(instance);
+			// Moving the instance around, as a game would, so the reset has something to do.
+			instance->set_position(Vector2(i, i));
+			Object::cast_to<Node2D>(instance->get_child(i % 64))->set_visible(false);
+			instance->queue_free();
+			SceneTree::get_singleton()->process(0);
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		const char *label = capacity ? "Pooled" : "Not pooled";
+		MESSAGE(label, ": ", int64_t(count * 1000000.0 / elapsed), " instances per second.");
+	}
+	packed_scene->clear_pool();
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+const String spatial_code = R"(
+shader_type spatial;
+render_mode unshaded;
+
+uniform vec4 tint : source_color;
+
+void fragment() {
+	ALBEDO = tint.rgb * sin(TIME);
+}
+)";
+
+struct Flags {
+	bool unshaded = false;
+	bool uses_time = false;
+	bool writes_albedo = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+
+	ShaderCompiler::IdentifierActions get_actions() {
+		ShaderCompiler::IdentifierActions actions;
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.render_mode_flags["unshaded"] = &unshaded;
+		actions.usage_flag_pointers["TIME"] = &uses_time;
+		actions.write_flag_pointers["ALBEDO"] = &writes_albedo;
+		actions.uniforms = &uniforms;
+		return actions;
+	}
+};
+
+static void initialize_compiler(ShaderCompiler &r_compiler, const String &p_albedo_name) {
+	ShaderCompiler::DefaultIdentifierActions actions;
+	actions.renames["ALBEDO"] = p_albedo_name;
+	actions.renames["TIME"] = "global_time";
+	actions.base_uniform_string = "material.";
+	actions.default_filter = ShaderLanguage::FILTER_LINEAR_MIPMAP;
+	actions.default_repeat = ShaderLanguage::REPEAT_ENABLE;
+	r_compiler.initialize(actions);
+}
+
+TEST_CASE("[ShaderCompiler] Identical code is compiled once") {
+	ShaderCompiler compiler;
+	initialize_compiler(compiler, "albedo");
+
+	Flags first;
+	ShaderCompiler::IdentifierActions first_actions = first.get_actions();
+	ShaderCompiler::GeneratedCode first_code;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_code, &first_actions, "", first_code) == OK);
+	CHECK(compiler.get_cached_shader_count() == 1);
+	CHECK(first.unshaded);
+	CHECK(first.uses_time);
+	CHECK(first.writes_albedo);
+	CHECK(first.uniforms.has("tint"));
+	CHECK(first_code.code["fragment"].contains("albedo"));
+
+	SUBCASE("Cache hits replay the flags and generated code") {
+		Flags second;
+		ShaderCompiler::IdentifierActions second_actions = second.get_actions();
+		ShaderCompiler::GeneratedCode second_code;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_code, &second_actions, "", second_code) == OK);
+		CHECK_MESSAGE(compiler.get_cached_shader_count() == 1, "The second compilation should have been a cache hit.");
+
+		CHECK_MESSAGE(second.unshaded, "Render mode flags should be replayed from the cache.");
+		CHECK_MESSAGE(second.uses_time, "Usage flags should be replayed from the cache.");
+		CHECK_MESSAGE(second.writes_albedo, "Write flags should be replayed from the cache.");
+		CHECK(second.uniforms.has("tint"));
+
+		CHECK(second_code.code["fragment"] == first_code.code["fragment"]);
+		CHECK(second_code.uniforms == first_code.uniforms);
+		CHECK(second_code.defines == first_code.defines);
+		CHECK(second_code.uniform_total_size == first_code.uniform_total_size);
+		CHECK(second_code.uses_fragment_time == first_code.uses_fragment_time);
+	}
+
+	SUBCASE("Cache hits skip flags the caller doesn't track") {
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		ShaderCompiler::IdentifierActions actions;
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.uniforms = &uniforms;
+		ShaderCompiler::GeneratedCode code;
+		CHECK(compiler.compile(RS::SHADER_SPATIAL, spatial_code, &actions, "", code) == OK);
+		CHECK(actions.usage_flag_pointers.is_empty());
+		CHECK(actions.write_flag_pointers.is_empty());
+		CHECK(code.code["fragment"] == first_code.code["fragment"]);
+	}
+
+	SUBCASE("Different code is compiled again") {
+		Flags other;
+		ShaderCompiler::IdentifierActions other_actions = other.get_actions();
+		ShaderCompiler::GeneratedCode other_code;
+		const String other_spatial_code = spatial_code.replace("sin(TIME)", "0.5");
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, other_spatial_code, &other_actions, "", other_code) == OK);
+		CHECK(compiler.get_cached_shader_count() == 2);
+		CHECK(other.unshaded);
+		CHECK_FALSE(other.uses_time);
+		CHECK(other_code.code["fragment"] != first_code.code["fragment"]);
+	}
+
+	SUBCASE("Changing global uniforms drops the cached code") {
+		ShaderCompiler::global_uniforms_changed();
+
+		Flags second;
+		ShaderCompiler::IdentifierActions second_actions = second.get_actions();
+		ShaderCompiler::GeneratedCode second_code;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_code, &second_actions, "", second_code) == OK);
+		CHECK_MESSAGE(compiler.get_cached_shader_count() == 1, "Entries parsed before the change should have been dropped, not kept next to the new one.");
+		CHECK(second.uses_time);
+		CHECK(second_code.code["fragment"] == first_code.code["fragment"]);
+	}
+
+	SUBCASE("Changing the default actions drops the cached code") {
+		initialize_compiler(compiler, "albedo_output");
+		CHECK(compiler.get_cached_shader_count() == 0);
+
+		Flags second;
+		ShaderCompiler::IdentifierActions second_actions = second.get_actions();
+		ShaderCompiler::GeneratedCode second_code;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, spatial_code, &second_actions, "", second_code) == OK);
+		CHECK_MESSAGE(second_code.code["fragment"].contains("albedo_output"), "The code should be generated with the new renames.");
+	}
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H